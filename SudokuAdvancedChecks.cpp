@@ -0,0 +1,946 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuAdvancedChecks
+ *  FILE         : SudokuAdvancedChecks.cpp
+ *  DESCRIPTION  : Implements the human-technique logical solver and grader:
+ *                 singles, locked candidates, naked/hidden pairs and triples,
+ *                 X-Wing, Swordfish, XY-Chains and Simple Colouring.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuAdvancedChecks.hpp"
+#include "SudokuBits.hpp"
+#include "SudokuTables.hpp"
+#include <cstring>
+
+/*==============================================================================
+ *  HELPERS
+ *============================================================================*/
+
+namespace
+{
+    const int MAX_CHAIN_CELLS = 8;   // Longest XY-Chain searched
+
+    /* Set of up to 81 cells */
+    struct CellSet
+    {
+        uint64_t low;    // Cells 0-63
+        uint64_t high;   // Cells 64-80
+
+        constexpr CellSet() : low(0), high(0) {}
+
+        constexpr void add(int cell)
+        {
+            if (cell < 64) { low |= 1ull << cell; } else { high |= 1ull << (cell - 64); }
+        }
+        bool has(int cell) const
+        {
+            return (cell < 64) ? ((low >> cell) & 1) : ((high >> (cell - 64)) & 1);
+        }
+        bool empty(void) const { return (low | high) == 0; }
+        CellSet operator&(const CellSet& other) const { CellSet out; out.low = low & other.low; out.high = high & other.high; return out; }
+        CellSet operator|(const CellSet& other) const { CellSet out; out.low = low | other.low; out.high = high | other.high; return out; }
+        CellSet operator~(void) const { CellSet out; out.low = ~low; out.high = ~high & ((1ull << 17) - 1); return out; }
+
+        /* Removes and returns the lowest cell, -1 if empty */
+        int pop(void)
+        {
+            if (low) { int cell = sudokuCtz64(low); low &= low - 1; return cell; }
+            if (high) { int cell = 64 + sudokuCtz64(high); high &= high - 1; return cell; }
+            return -1;
+        }
+    };
+
+    /* Peers of every cell as a CellSet */
+    struct PeerSets
+    {
+        CellSet of[81];
+
+        constexpr PeerSets() : of()
+        {
+            for (int cell = 0; cell < 81; cell++)
+            {
+                for (int index = 0; index < 20; index++)
+                {
+                    of[cell].add(SUDOKU_TABLES.peers[cell][index]);
+                }
+            }
+        }
+    };
+
+    constexpr PeerSets PEER_SETS;
+
+    /* Resets a step to "no placement, no eliminations" */
+    void beginStep(SudokuLogicStep& step, SudokuTechnique technique)
+    {
+        step.technique = technique;
+        step.cell = SudokuLogicStep::NO_CELL;
+        step.digit = 0;
+        step.patternCount = 0;
+        step.eliminationCount = 0;
+    }
+
+    /* Advances 'index' to the next 'size'-combination of [0, count), false when done */
+    bool nextCombination(int* index, int size, int count)
+    {
+        int position = size - 1;
+        while (position >= 0 && index[position] == count - size + position)
+        {
+            position--;
+        }
+        if (position < 0)
+        {
+            return false;
+        }
+        index[position]++;
+        for (int next = position + 1; next < size; next++)
+        {
+            index[next] = index[next - 1] + 1;
+        }
+        return true;
+    }
+}
+
+/*==============================================================================
+ *  CONSTRUCTOR
+ *============================================================================*/
+
+/* Starts with an empty grid where every digit is possible everywhere */
+SudokuAdvancedChecks::SudokuAdvancedChecks() : emptyCount(81)
+{
+    std::memset(cells, 0, sizeof(cells));
+    for (int cell = 0; cell < 81; cell++)
+    {
+        candidates[cell] = SUDOKU_ALL_DIGITS;
+    }
+}
+
+/*==============================================================================
+ *  PUBLIC FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Places every given, clearing it from the peers as it goes */
+bool SudokuAdvancedChecks::load(SudokuConstGridView grid)
+{
+    std::memset(cells, 0, sizeof(cells));
+    for (int cell = 0; cell < 81; cell++)
+    {
+        candidates[cell] = SUDOKU_ALL_DIGITS;
+    }
+    emptyCount = 81;
+
+    for (int cell = 0; cell < 81; cell++)
+    {
+        int digit = grid[cell];
+        if (digit == 0)
+        {
+            continue;
+        }
+        if (digit > 9 || !(candidates[cell] & (1u << (digit - 1))))
+        {
+            return false;
+        }
+        place(cell, digit);
+    }
+    return true;
+}
+
+/* Tries the techniques from easiest to hardest */
+bool SudokuAdvancedChecks::findStep(SudokuLogicStep& step) const
+{
+    if (emptyCount == 0 || hasContradiction())
+    {
+        return false;
+    }
+
+    return findHiddenSingle(step) ||
+           findNakedSingle(step) ||
+           findPointing(step) ||
+           findClaiming(step) ||
+           findNakedSubset(step, 2) ||
+           findFish(step, 2) ||
+           findHiddenSubset(step, 2) ||
+           findNakedSubset(step, 3) ||
+           findFish(step, 3) ||
+           findHiddenSubset(step, 3) ||
+           findXYChain(step) ||
+           findSimpleColouring(step);
+}
+
+/* Applies the placement (if any) and the eliminations of a step */
+void SudokuAdvancedChecks::applyStep(const SudokuLogicStep& step)
+{
+    if (step.cell != SudokuLogicStep::NO_CELL && cells[step.cell] == 0)
+    {
+        place(step.cell, step.digit);
+    }
+    for (int index = 0; index < step.eliminationCount; index++)
+    {
+        eliminate(step.eliminations[index].cell, step.eliminations[index].digits);
+    }
+}
+
+/* Incremental placement: only the 20 peers are touched */
+void SudokuAdvancedChecks::place(int cell, int digit)
+{
+    uint16_t bit = static_cast<uint16_t>(1u << (digit - 1));
+
+    cells[cell] = static_cast<uint8_t>(digit);
+    candidates[cell] = 0;
+    emptyCount--;
+
+    for (int index = 0; index < 20; index++)
+    {
+        candidates[SUDOKU_TABLES.peers[cell][index]] &= static_cast<uint16_t>(~bit);
+    }
+}
+
+/* Removes digits from a single cell */
+void SudokuAdvancedChecks::eliminate(int cell, unsigned int digits)
+{
+    candidates[cell] &= static_cast<uint16_t>(~digits);
+}
+
+/* An empty cell without candidates means the grid cannot be completed */
+bool SudokuAdvancedChecks::hasContradiction(void) const
+{
+    for (int cell = 0; cell < 81; cell++)
+    {
+        if (cells[cell] == 0 && candidates[cell] == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* True once every cell is filled */
+bool SudokuAdvancedChecks::isSolved(void) const
+{
+    return emptyCount == 0;
+}
+
+/* Candidate mask of a cell */
+uint16_t SudokuAdvancedChecks::getCandidates(int cell) const
+{
+    return candidates[cell];
+}
+
+/* Digit in a cell */
+uint8_t SudokuAdvancedChecks::getCell(int cell) const
+{
+    return cells[cell];
+}
+
+/* Logic-only solve: the hardest technique needed decides the grade */
+SudokuGrade SudokuAdvancedChecks::grade(SudokuConstGridView grid, std::vector<SudokuLogicStep>* steps)
+{
+    SudokuGrade result = { false, 0.0, SudokuTechnique::HiddenSingle, 0, "Invalid" };
+    SudokuLogicStep step;
+
+    if (!load(grid))
+    {
+        return result;
+    }
+
+    while (findStep(step))
+    {
+        applyStep(step);
+        result.stepCount++;
+        if (sudokuTechniqueRating(step.technique) > result.rating)
+        {
+            result.rating = sudokuTechniqueRating(step.technique);
+            result.hardest = step.technique;
+        }
+        if (steps != nullptr)
+        {
+            steps->push_back(step);
+        }
+    }
+
+    result.solved = isSolved();
+    if (!result.solved)
+    {
+        result.label = "Beyond logic";
+    }
+    else if (result.rating <= 2.3)
+    {
+        result.label = "Easy";
+    }
+    else if (result.rating <= 3.0)
+    {
+        result.label = "Medium";
+    }
+    else if (result.rating <= 4.0)
+    {
+        result.label = "Hard";
+    }
+    else
+    {
+        result.label = "Expert";
+    }
+    return result;
+}
+
+/*==============================================================================
+ *  PRIVATE FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Bit i is set if the i-th cell of the unit has the digit as a candidate */
+unsigned int SudokuAdvancedChecks::positionsInUnit(int unit, int digit) const
+{
+    unsigned int bit = 1u << (digit - 1);
+    unsigned int positions = 0;
+
+    for (int index = 0; index < 9; index++)
+    {
+        if (candidates[SUDOKU_TABLES.units[unit][index]] & bit)
+        {
+            positions |= 1u << index;
+        }
+    }
+    return positions;
+}
+
+/* Records an elimination only if it removes something */
+bool SudokuAdvancedChecks::addElimination(SudokuLogicStep& step, int cell, unsigned int digits) const
+{
+    unsigned int removed = candidates[cell] & digits;
+
+    if (removed == 0)
+    {
+        return false;
+    }
+    step.eliminations[step.eliminationCount].cell = static_cast<uint8_t>(cell);
+    step.eliminations[step.eliminationCount].digits = static_cast<uint16_t>(removed);
+    step.eliminationCount++;
+    return true;
+}
+
+/* A digit with a single possible cell in a unit (boxes first) */
+bool SudokuAdvancedChecks::findHiddenSingle(SudokuLogicStep& step) const
+{
+    for (int order = 0; order < 27; order++)
+    {
+        int unit = (order + 18) % 27;
+        unsigned int once = 0;
+        unsigned int twice = 0;
+
+        for (int index = 0; index < 9; index++)
+        {
+            unsigned int cand = candidates[SUDOKU_TABLES.units[unit][index]];
+            twice |= once & cand;
+            once |= cand;
+        }
+
+        unsigned int hidden = once & ~twice;
+        if (hidden == 0)
+        {
+            continue;
+        }
+
+        int digit = sudokuCtz(hidden) + 1;
+        beginStep(step, SudokuTechnique::HiddenSingle);
+        step.digit = static_cast<uint8_t>(digit);
+        for (int index = 0; index < 9; index++)
+        {
+            int cell = SUDOKU_TABLES.units[unit][index];
+            step.pattern[step.patternCount++] = static_cast<uint8_t>(cell);
+            if (candidates[cell] & hidden & (0u - hidden))
+            {
+                step.cell = static_cast<uint8_t>(cell);
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+/* A cell with a single candidate */
+bool SudokuAdvancedChecks::findNakedSingle(SudokuLogicStep& step) const
+{
+    for (int cell = 0; cell < 81; cell++)
+    {
+        if (sudokuIsSingleBit(candidates[cell]))
+        {
+            beginStep(step, SudokuTechnique::NakedSingle);
+            step.cell = static_cast<uint8_t>(cell);
+            step.digit = static_cast<uint8_t>(sudokuCtz(candidates[cell]) + 1);
+            step.pattern[step.patternCount++] = static_cast<uint8_t>(cell);
+            return true;
+        }
+    }
+    return false;
+}
+
+/* A digit confined to one row or column inside a box leaves the rest of that line */
+bool SudokuAdvancedChecks::findPointing(SudokuLogicStep& step) const
+{
+    static const unsigned int BOX_ROWS[3] = { 0x007, 0x038, 0x1C0 };
+    static const unsigned int BOX_COLS[3] = { 0x049, 0x092, 0x124 };
+
+    for (int box = 0; box < 9; box++)
+    {
+        int unit = 18 + box;
+        for (int digit = 1; digit <= 9; digit++)
+        {
+            unsigned int positions = positionsInUnit(unit, digit);
+            if (sudokuPopcount(positions) < 2)
+            {
+                continue;
+            }
+
+            for (int line = 0; line < 3; line++)
+            {
+                int lineUnit = -1;
+                if ((positions & ~BOX_ROWS[line]) == 0)
+                {
+                    lineUnit = (box / 3) * 3 + line;
+                }
+                else if ((positions & ~BOX_COLS[line]) == 0)
+                {
+                    lineUnit = 9 + (box % 3) * 3 + line;
+                }
+                if (lineUnit < 0)
+                {
+                    continue;
+                }
+
+                beginStep(step, SudokuTechnique::Pointing);
+                step.digit = static_cast<uint8_t>(digit);
+                for (int index = 0; index < 9; index++)
+                {
+                    int cell = SUDOKU_TABLES.units[lineUnit][index];
+                    if (SUDOKU_TABLES.boxOf[cell] != box)
+                    {
+                        addElimination(step, cell, 1u << (digit - 1));
+                    }
+                }
+                if (step.eliminationCount > 0)
+                {
+                    for (int index = 0; index < 9; index++)
+                    {
+                        if (positions & (1u << index))
+                        {
+                            step.pattern[step.patternCount++] = SUDOKU_TABLES.units[unit][index];
+                        }
+                    }
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/* A digit confined to one box inside a row or column leaves the rest of that box */
+bool SudokuAdvancedChecks::findClaiming(SudokuLogicStep& step) const
+{
+    static const unsigned int SEGMENTS[3] = { 0x007, 0x038, 0x1C0 };
+
+    for (int unit = 0; unit < 18; unit++)
+    {
+        for (int digit = 1; digit <= 9; digit++)
+        {
+            unsigned int positions = positionsInUnit(unit, digit);
+            if (sudokuPopcount(positions) < 2)
+            {
+                continue;
+            }
+
+            for (int segment = 0; segment < 3; segment++)
+            {
+                if ((positions & ~SEGMENTS[segment]) != 0)
+                {
+                    continue;
+                }
+
+                int box = SUDOKU_TABLES.boxOf[SUDOKU_TABLES.units[unit][segment * 3]];
+                beginStep(step, SudokuTechnique::Claiming);
+                step.digit = static_cast<uint8_t>(digit);
+                for (int index = 0; index < 9; index++)
+                {
+                    int cell = SUDOKU_TABLES.units[18 + box][index];
+                    bool onLine = (unit < 9) ? SUDOKU_TABLES.rowOf[cell] == unit
+                                             : SUDOKU_TABLES.colOf[cell] == unit - 9;
+                    if (!onLine)
+                    {
+                        addElimination(step, cell, 1u << (digit - 1));
+                    }
+                }
+                if (step.eliminationCount > 0)
+                {
+                    for (int index = 0; index < 9; index++)
+                    {
+                        if (positions & (1u << index))
+                        {
+                            step.pattern[step.patternCount++] = SUDOKU_TABLES.units[unit][index];
+                        }
+                    }
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/* 'size' cells of a unit holding only 'size' digits between them */
+bool SudokuAdvancedChecks::findNakedSubset(SudokuLogicStep& step, int size) const
+{
+    SudokuTechnique technique = (size == 2) ? SudokuTechnique::NakedPair : SudokuTechnique::NakedTriple;
+
+    for (int unit = 0; unit < 27; unit++)
+    {
+        int members[9];
+        int count = 0;
+        for (int index = 0; index < 9; index++)
+        {
+            int cell = SUDOKU_TABLES.units[unit][index];
+            int width = sudokuPopcount(candidates[cell]);
+            if (width >= 2 && width <= size)
+            {
+                members[count++] = cell;
+            }
+        }
+        if (count < size)
+        {
+            continue;
+        }
+
+        int choice[4] = { 0, 1, 2, 3 };
+        do
+        {
+            unsigned int digits = 0;
+            for (int index = 0; index < size; index++)
+            {
+                digits |= candidates[members[choice[index]]];
+            }
+            if (sudokuPopcount(digits) != size)
+            {
+                continue;
+            }
+
+            beginStep(step, technique);
+            for (int index = 0; index < 9; index++)
+            {
+                int cell = SUDOKU_TABLES.units[unit][index];
+                bool inSubset = false;
+                for (int member = 0; member < size; member++)
+                {
+                    inSubset = inSubset || members[choice[member]] == cell;
+                }
+                if (!inSubset)
+                {
+                    addElimination(step, cell, digits);
+                }
+            }
+            if (step.eliminationCount > 0)
+            {
+                for (int index = 0; index < size; index++)
+                {
+                    step.pattern[step.patternCount++] = static_cast<uint8_t>(members[choice[index]]);
+                }
+                return true;
+            }
+        } while (nextCombination(choice, size, count));
+    }
+    return false;
+}
+
+/* 'size' digits of a unit confined to the same 'size' cells */
+bool SudokuAdvancedChecks::findHiddenSubset(SudokuLogicStep& step, int size) const
+{
+    SudokuTechnique technique = (size == 2) ? SudokuTechnique::HiddenPair : SudokuTechnique::HiddenTriple;
+
+    for (int unit = 0; unit < 27; unit++)
+    {
+        int digits[9];
+        unsigned int positions[9];
+        int count = 0;
+        for (int digit = 1; digit <= 9; digit++)
+        {
+            unsigned int where = positionsInUnit(unit, digit);
+            int width = sudokuPopcount(where);
+            if (width >= 2 && width <= size)
+            {
+                digits[count] = digit;
+                positions[count] = where;
+                count++;
+            }
+        }
+        if (count < size)
+        {
+            continue;
+        }
+
+        int choice[4] = { 0, 1, 2, 3 };
+        do
+        {
+            unsigned int cover = 0;
+            unsigned int keep = 0;
+            for (int index = 0; index < size; index++)
+            {
+                cover |= positions[choice[index]];
+                keep |= 1u << (digits[choice[index]] - 1);
+            }
+            if (sudokuPopcount(cover) != size)
+            {
+                continue;
+            }
+
+            beginStep(step, technique);
+            for (int index = 0; index < 9; index++)
+            {
+                if (cover & (1u << index))
+                {
+                    int cell = SUDOKU_TABLES.units[unit][index];
+                    addElimination(step, cell, SUDOKU_ALL_DIGITS & ~keep);
+                    step.pattern[step.patternCount++] = static_cast<uint8_t>(cell);
+                }
+            }
+            if (step.eliminationCount > 0)
+            {
+                return true;
+            }
+        } while (nextCombination(choice, size, count));
+    }
+    return false;
+}
+
+/* X-Wing (size 2) and Swordfish (size 3): a digit confined to 'size' columns
+ * across 'size' rows (or the transpose) leaves those columns elsewhere */
+bool SudokuAdvancedChecks::findFish(SudokuLogicStep& step, int size) const
+{
+    SudokuTechnique technique = (size == 2) ? SudokuTechnique::XWing : SudokuTechnique::Swordfish;
+
+    for (int digit = 1; digit <= 9; digit++)
+    {
+        for (int orientation = 0; orientation < 2; orientation++)
+        {
+            int baseUnit = (orientation == 0) ? 0 : 9;
+            int coverUnit = (orientation == 0) ? 9 : 0;
+            int lines[9];
+            unsigned int positions[9];
+            int count = 0;
+
+            for (int line = 0; line < 9; line++)
+            {
+                unsigned int where = positionsInUnit(baseUnit + line, digit);
+                int width = sudokuPopcount(where);
+                if (width >= 2 && width <= size)
+                {
+                    lines[count] = line;
+                    positions[count] = where;
+                    count++;
+                }
+            }
+            if (count < size)
+            {
+                continue;
+            }
+
+            int choice[4] = { 0, 1, 2, 3 };
+            do
+            {
+                unsigned int cover = 0;
+                unsigned int base = 0;
+                for (int index = 0; index < size; index++)
+                {
+                    cover |= positions[choice[index]];
+                    base |= 1u << lines[choice[index]];
+                }
+                if (sudokuPopcount(cover) != size)
+                {
+                    continue;
+                }
+
+                beginStep(step, technique);
+                step.digit = static_cast<uint8_t>(digit);
+                for (int coverLine = 0; coverLine < 9; coverLine++)
+                {
+                    if (!(cover & (1u << coverLine)))
+                    {
+                        continue;
+                    }
+                    for (int index = 0; index < 9; index++)
+                    {
+                        int cell = SUDOKU_TABLES.units[coverUnit + coverLine][index];
+                        if (base & (1u << index))
+                        {
+                            if (candidates[cell] & (1u << (digit - 1)))
+                            {
+                                step.pattern[step.patternCount++] = static_cast<uint8_t>(cell);
+                            }
+                        }
+                        else
+                        {
+                            addElimination(step, cell, 1u << (digit - 1));
+                        }
+                    }
+                }
+                if (step.eliminationCount > 0)
+                {
+                    return true;
+                }
+            } while (nextCombination(choice, size, count));
+        }
+    }
+    return false;
+}
+
+/* XY-Chain: bivalue cells linked through shared digits. If the chain starts
+ * with {x,y} and ends on a cell whose remaining digit is x, one of the two
+ * ends is x, so x goes from every cell that sees both ends. */
+bool SudokuAdvancedChecks::findXYChain(SudokuLogicStep& step) const
+{
+    CellSet bivalue;
+    for (int cell = 0; cell < 81; cell++)
+    {
+        if (sudokuPopcount(candidates[cell]) == 2)
+        {
+            bivalue.add(cell);
+        }
+    }
+
+    int chain[MAX_CHAIN_CELLS];
+    unsigned int linkDigit[MAX_CHAIN_CELLS];   // Digit the cell is forced to along the chain
+    int nextPeer[MAX_CHAIN_CELLS];
+
+    for (int start = 0; start < 81; start++)
+    {
+        if (!bivalue.has(start))
+        {
+            continue;
+        }
+
+        for (unsigned int endBits = candidates[start]; endBits; endBits &= endBits - 1)
+        {
+            unsigned int target = endBits & (0u - endBits);   // Digit x
+            int depth = 0;
+            chain[0] = start;
+            linkDigit[0] = candidates[start] & ~target;       // start = y if start != x
+            nextPeer[0] = 0;
+
+            while (depth >= 0)
+            {
+                if (nextPeer[depth] == 20)
+                {
+                    depth--;
+                    continue;
+                }
+
+                int peer = SUDOKU_TABLES.peers[chain[depth]][nextPeer[depth]++];
+                if (!bivalue.has(peer) || !(candidates[peer] & linkDigit[depth]))
+                {
+                    continue;
+                }
+                bool visited = false;
+                for (int index = 0; index <= depth; index++)
+                {
+                    visited = visited || chain[index] == peer;
+                }
+                if (visited)
+                {
+                    continue;
+                }
+
+                unsigned int forced = candidates[peer] & ~linkDigit[depth];
+                if (forced == target && depth >= 1)
+                {
+                    CellSet seeBoth = PEER_SETS.of[start] & PEER_SETS.of[peer];
+                    beginStep(step, SudokuTechnique::XYChain);
+                    step.digit = static_cast<uint8_t>(sudokuCtz(target) + 1);
+                    for (int cell = seeBoth.pop(); cell >= 0; cell = seeBoth.pop())
+                    {
+                        addElimination(step, cell, target);
+                    }
+                    if (step.eliminationCount > 0)
+                    {
+                        for (int index = 0; index <= depth; index++)
+                        {
+                            step.pattern[step.patternCount++] = static_cast<uint8_t>(chain[index]);
+                        }
+                        step.pattern[step.patternCount++] = static_cast<uint8_t>(peer);
+                        return true;
+                    }
+                }
+
+                if (depth + 1 < MAX_CHAIN_CELLS)
+                {
+                    depth++;
+                    chain[depth] = peer;
+                    linkDigit[depth] = forced;
+                    nextPeer[depth] = 0;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/* Simple Colouring: conjugate pairs of one digit are coloured alternately.
+ * Two cells of one colour in the same unit make that colour false (wrap);
+ * a cell seeing both colours cannot hold the digit (trap). */
+bool SudokuAdvancedChecks::findSimpleColouring(SudokuLogicStep& step) const
+{
+    for (int digit = 1; digit <= 9; digit++)
+    {
+        unsigned int bit = 1u << (digit - 1);
+        int linkA[27];
+        int linkB[27];
+        int linkCount = 0;
+        CellSet holders;
+
+        for (int cell = 0; cell < 81; cell++)
+        {
+            if (candidates[cell] & bit)
+            {
+                holders.add(cell);
+            }
+        }
+        for (int unit = 0; unit < 27; unit++)
+        {
+            unsigned int positions = positionsInUnit(unit, digit);
+            if (sudokuPopcount(positions) == 2)
+            {
+                linkA[linkCount] = SUDOKU_TABLES.units[unit][sudokuCtz(positions)];
+                linkB[linkCount] = SUDOKU_TABLES.units[unit][sudokuCtz(positions & (positions - 1))];
+                linkCount++;
+            }
+        }
+
+        int8_t colour[81];
+        std::memset(colour, -1, sizeof(colour));
+
+        for (int seed = 0; seed < linkCount; seed++)
+        {
+            if (colour[linkA[seed]] >= 0)
+            {
+                continue;
+            }
+
+            // Colour the component reachable from this link
+            CellSet sides[2];
+            int queue[81];
+            int head = 0;
+            int tail = 0;
+            colour[linkA[seed]] = 0;
+            sides[0].add(linkA[seed]);
+            queue[tail++] = linkA[seed];
+
+            while (head < tail)
+            {
+                int cell = queue[head++];
+                for (int link = 0; link < linkCount; link++)
+                {
+                    int other = (linkA[link] == cell) ? linkB[link] : (linkB[link] == cell) ? linkA[link] : -1;
+                    if (other >= 0 && colour[other] < 0)
+                    {
+                        colour[other] = static_cast<int8_t>(1 - colour[cell]);
+                        sides[colour[other]].add(other);
+                        queue[tail++] = other;
+                    }
+                }
+            }
+            if (tail < 3)
+            {
+                continue;   // A lone conjugate pair proves nothing
+            }
+
+            CellSet seen[2];
+            for (int side = 0; side < 2; side++)
+            {
+                CellSet members = sides[side];
+                for (int cell = members.pop(); cell >= 0; cell = members.pop())
+                {
+                    seen[side] = seen[side] | PEER_SETS.of[cell];
+                }
+            }
+
+            beginStep(step, SudokuTechnique::SimpleColouring);
+            step.digit = static_cast<uint8_t>(digit);
+            for (int side = 0; side < 2 && step.eliminationCount == 0; side++)
+            {
+                if (!(sides[side] & seen[side]).empty())
+                {
+                    CellSet wrong = sides[side];
+                    for (int cell = wrong.pop(); cell >= 0; cell = wrong.pop())
+                    {
+                        addElimination(step, cell, bit);
+                    }
+                }
+            }
+            if (step.eliminationCount == 0)
+            {
+                CellSet trapped = holders & ~(sides[0] | sides[1]) & seen[0] & seen[1];
+                for (int cell = trapped.pop(); cell >= 0; cell = trapped.pop())
+                {
+                    addElimination(step, cell, bit);
+                }
+            }
+            if (step.eliminationCount > 0)
+            {
+                for (int index = 0; index < tail; index++)
+                {
+                    step.pattern[step.patternCount++] = static_cast<uint8_t>(queue[index]);
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*==============================================================================
+ *  FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Display name of a technique */
+const char* sudokuTechniqueName(SudokuTechnique technique)
+{
+    switch (technique)
+    {
+        case SudokuTechnique::HiddenSingle:    return "Hidden Single";
+        case SudokuTechnique::NakedSingle:     return "Naked Single";
+        case SudokuTechnique::Pointing:        return "Pointing";
+        case SudokuTechnique::Claiming:        return "Claiming";
+        case SudokuTechnique::NakedPair:       return "Naked Pair";
+        case SudokuTechnique::XWing:           return "X-Wing";
+        case SudokuTechnique::HiddenPair:      return "Hidden Pair";
+        case SudokuTechnique::NakedTriple:     return "Naked Triple";
+        case SudokuTechnique::Swordfish:       return "Swordfish";
+        case SudokuTechnique::HiddenTriple:    return "Hidden Triple";
+        case SudokuTechnique::XYChain:         return "XY-Chain";
+        case SudokuTechnique::SimpleColouring: return "Simple Colouring";
+    }
+    return "Unknown";
+}
+
+/* Difficulty rating of a technique */
+double sudokuTechniqueRating(SudokuTechnique technique)
+{
+    switch (technique)
+    {
+        case SudokuTechnique::HiddenSingle:    return 1.5;
+        case SudokuTechnique::NakedSingle:     return 2.3;
+        case SudokuTechnique::Pointing:        return 2.6;
+        case SudokuTechnique::Claiming:        return 2.8;
+        case SudokuTechnique::NakedPair:       return 3.0;
+        case SudokuTechnique::XWing:           return 3.2;
+        case SudokuTechnique::HiddenPair:      return 3.4;
+        case SudokuTechnique::NakedTriple:     return 3.6;
+        case SudokuTechnique::Swordfish:       return 3.8;
+        case SudokuTechnique::HiddenTriple:    return 4.0;
+        case SudokuTechnique::XYChain:         return 4.4;
+        case SudokuTechnique::SimpleColouring: return 4.6;
+    }
+    return 0.0;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
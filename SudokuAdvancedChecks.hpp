@@ -0,0 +1,161 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuAdvancedChecks
+ *  FILE         : SudokuAdvancedChecks.hpp
+ *  DESCRIPTION  : Header file for the SudokuAdvancedChecks class, a logical
+ *                 solver that applies human solving techniques in order of
+ *                 difficulty and grades puzzles by the hardest technique
+ *                 they need.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include "SudokuBoard.hpp"
+ #include <cstdint>
+ #include <vector>
+
+ /*==============================================================================
+  *  TYPE DEFINITIONS
+  *============================================================================*/
+
+ /*
+  * Techniques in the order they are tried (easiest first)
+  */
+ enum class SudokuTechnique : uint8_t
+ {
+     HiddenSingle,
+     NakedSingle,
+     Pointing,          // Box candidates confined to one line
+     Claiming,          // Line candidates confined to one box
+     NakedPair,
+     XWing,
+     HiddenPair,
+     NakedTriple,
+     Swordfish,
+     HiddenTriple,
+     XYChain,           // Chain of bivalue cells (XY-Wing is the 3-cell case)
+     SimpleColouring    // Single-digit chain of conjugate pairs
+ };
+
+ /* Candidate digits removed from one cell by a step */
+ struct SudokuElimination
+ {
+     uint8_t  cell;     // Cell index (row * 9 + col)
+     uint16_t digits;   // Bit (d-1) set for every removed digit d
+ };
+
+ /*
+  * One deduction. Singles fill 'cell' with 'digit'; every other technique
+  * only removes candidates. 'pattern' lists the cells that justify the step.
+  */
+ struct SudokuLogicStep
+ {
+     SudokuTechnique   technique;
+     uint8_t           cell;               // Placed cell, NO_CELL if none
+     uint8_t           digit;              // Placed digit / fish or colouring digit, 0 if none
+     uint8_t           patternCount;
+     uint8_t           eliminationCount;
+     uint8_t           pattern[81];
+     SudokuElimination eliminations[81];
+
+     static const uint8_t NO_CELL = 0xFF;
+ };
+
+ /* Result of grading a puzzle */
+ struct SudokuGrade
+ {
+     bool            solved;       // True if logic alone solved the puzzle
+     double          rating;       // Rating of the hardest technique used
+     SudokuTechnique hardest;      // Hardest technique used
+     int             stepCount;    // Number of steps applied
+     const char*     label;        // "Easy" ... "Expert", or "Beyond logic"
+ };
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuAdvancedChecks
+  *  DESCRIPTION: Keeps a candidate mask per cell and updates it incrementally:
+  *               a placement clears the digit from the 20 peers, an
+  *               elimination touches only its cell. Techniques read the
+  *               masks, nothing is recomputed from the grid between steps.
+  *----------------------------------------------------------------------------*/
+ class SudokuAdvancedChecks
+ {
+ private:
+     uint8_t  cells[81];        // Placed digits, 0 for empty
+     uint16_t candidates[81];   // Candidate mask per cell, 0 once placed
+     int      emptyCount;       // Cells still empty
+
+     /* Cells of the unit that still have 'digit' as a candidate (bit = index in unit) */
+     unsigned int positionsInUnit(int unit, int digit) const;
+
+     /* Adds an elimination to the step if the cell still has any of the digits */
+     bool addElimination(SudokuLogicStep& step, int cell, unsigned int digits) const;
+
+     /* Technique finders: fill 'step' and return true if the technique applies */
+     bool findHiddenSingle(SudokuLogicStep& step) const;
+     bool findNakedSingle(SudokuLogicStep& step) const;
+     bool findPointing(SudokuLogicStep& step) const;
+     bool findClaiming(SudokuLogicStep& step) const;
+     bool findNakedSubset(SudokuLogicStep& step, int size) const;
+     bool findHiddenSubset(SudokuLogicStep& step, int size) const;
+     bool findFish(SudokuLogicStep& step, int size) const;
+     bool findXYChain(SudokuLogicStep& step) const;
+     bool findSimpleColouring(SudokuLogicStep& step) const;
+
+ public:
+     /* Constructor: starts with an empty grid */
+     SudokuAdvancedChecks();
+
+     /* Loads a grid and builds the candidate masks, false if the givens clash */
+     bool load(SudokuConstGridView grid);
+
+     /* Finds the easiest applicable step without changing the state */
+     bool findStep(SudokuLogicStep& step) const;
+
+     /* Applies a step found by findStep */
+     void applyStep(const SudokuLogicStep& step);
+
+     /* Places a digit and removes it from the candidates of the cell's peers */
+     void place(int cell, int digit);
+
+     /* Removes candidate digits from one cell */
+     void eliminate(int cell, unsigned int digits);
+
+     /* True if an empty cell has no candidates left */
+     bool hasContradiction(void) const;
+
+     /* True once every cell is filled */
+     bool isSolved(void) const;
+
+     /* Candidate mask of a cell (0 if filled) */
+     uint16_t getCandidates(int cell) const;
+
+     /* Digit in a cell (0 if empty) */
+     uint8_t getCell(int cell) const;
+
+     /* Applies steps until the puzzle is solved or no technique applies.
+      * The steps are appended to 'steps' when it is not null. */
+     SudokuGrade grade(SudokuConstGridView grid, std::vector<SudokuLogicStep>* steps = nullptr);
+ };
+
+ /*==============================================================================
+  *  FUNCTION DECLARATIONS
+  *============================================================================*/
+
+ /* Display name of a technique */
+ const char* sudokuTechniqueName(SudokuTechnique technique);
+
+ /* Difficulty rating of a technique (roughly the Sudoku Explainer scale) */
+ double sudokuTechniqueRating(SudokuTechnique technique);
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
@@ -0,0 +1,489 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuArchive
+ *  FILE         : SudokuArchive.cpp
+ *  DESCRIPTION  : Implements the binary puzzle archive writer and reader and
+ *                 the text converters.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuArchive.hpp"
+#include "SudokuBits.hpp"
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SUDOKU_HAVE_MMAP 1
+#endif
+
+/*==============================================================================
+ *  CONSTANTS
+ *============================================================================*/
+
+namespace
+{
+    const char   ARCHIVE_MAGIC[8]  = { 'S', 'U', 'D', 'O', 'K', 'U', 'A', '1' };
+    const size_t WRITE_CHUNK_SIZE  = 1 << 20;   // Bytes buffered before a write
+
+    /* Header field offsets */
+    const size_t HEADER_VERSION        = 8;
+    const size_t HEADER_STRIDE         = 12;
+    const size_t HEADER_COUNT          = 16;
+    const size_t HEADER_BLOCKS_OFFSET  = 24;
+    const size_t HEADER_BLOCK_BYTES    = 32;
+    const size_t HEADER_INDEX_OFFSET   = 40;
+
+    /* Little-endian stores and loads, independent of the host byte order */
+    void storeLe32(uint8_t* dest, uint32_t value)
+    {
+        for (int byte = 0; byte < 4; byte++)
+        {
+            dest[byte] = static_cast<uint8_t>(value >> (8 * byte));
+        }
+    }
+
+    void storeLe64(uint8_t* dest, uint64_t value)
+    {
+        for (int byte = 0; byte < 8; byte++)
+        {
+            dest[byte] = static_cast<uint8_t>(value >> (8 * byte));
+        }
+    }
+
+    uint32_t loadLe32(const uint8_t* src)
+    {
+        return static_cast<uint32_t>(src[0]) | static_cast<uint32_t>(src[1]) << 8 |
+               static_cast<uint32_t>(src[2]) << 16 | static_cast<uint32_t>(src[3]) << 24;
+    }
+
+    uint64_t loadLe64(const uint8_t* src)
+    {
+        return static_cast<uint64_t>(loadLe32(src)) | static_cast<uint64_t>(loadLe32(src + 4)) << 32;
+    }
+
+    /* Bits 64-80 of a clue bitmap */
+    uint64_t highBits(const uint8_t* bitmap)
+    {
+        return bitmap[8] | (bitmap[9] << 8) | ((bitmap[10] & 0x1) << 16);
+    }
+
+    /* Number of clues marked in a bitmap */
+    size_t clueCount(const uint8_t* bitmap)
+    {
+        return static_cast<size_t>(sudokuPopcount64(loadLe64(bitmap)) + sudokuPopcount64(highBits(bitmap)));
+    }
+}
+
+/*==============================================================================
+ *  EXCEPTION DEFINITIONS
+ *============================================================================*/
+
+/* Returns generic archive error message */
+const char* SudokuArchiveException::what() const noexcept
+{
+    return "Archive Error.";
+}
+
+/* Returns error message for an archive that cannot be opened */
+const char* SudokuArchiveOpenException::what() const noexcept
+{
+    return "Archive Error (Cannot Open Archive).";
+}
+
+/* Returns error message for a malformed archive */
+const char* SudokuArchiveFormatException::what() const noexcept
+{
+    return "Archive Error (Bad Format).";
+}
+
+/* Returns error message for a failed write */
+const char* SudokuArchiveWriteException::what() const noexcept
+{
+    return "Archive Error (Cannot Write Archive).";
+}
+
+/*==============================================================================
+ *  SudokuArchiveWriter
+ *============================================================================*/
+
+/* Opens the file and reserves room for the header */
+SudokuArchiveWriter::SudokuArchiveWriter(const char* path)
+    : out(nullptr), clues(0), count(0), blockBytes(0), finished(false)
+{
+    out = std::fopen(path, "wb");
+    if (out == nullptr)
+    {
+        throw SudokuArchiveOpenException();
+    }
+
+    uint8_t header[SUDOKU_ARCHIVE_HEADER_SIZE] = {};
+    if (std::fwrite(header, 1, sizeof(header), out) != sizeof(header))
+    {
+        std::fclose(out);
+        throw SudokuArchiveOpenException();
+    }
+    buffer.reserve(WRITE_CHUNK_SIZE);
+    bitmaps.reserve(SUDOKU_ARCHIVE_STRIDE * SUDOKU_ARCHIVE_BITMAP_SIZE);
+    digits.reserve(SUDOKU_ARCHIVE_STRIDE * 41);
+}
+
+/* Completes the file, errors are ignored at this point */
+SudokuArchiveWriter::~SudokuArchiveWriter()
+{
+    try
+    {
+        finish();
+    }
+    catch (const SudokuArchiveException&)
+    {
+    }
+    if (out != nullptr)
+    {
+        std::fclose(out);
+    }
+}
+
+/* Adds the puzzle's bitmap and digits to the block being filled */
+void SudokuArchiveWriter::append(SudokuConstGridView grid)
+{
+    uint8_t bitmap[SUDOKU_ARCHIVE_BITMAP_SIZE] = {};
+
+    for (int cell = 0; cell < 81; cell++)
+    {
+        uint8_t value = grid[cell];
+        if (value >= 1 && value <= 9)
+        {
+            bitmap[cell / 8] |= static_cast<uint8_t>(1u << (cell % 8));
+            if (clues % 2 == 0)
+            {
+                digits.push_back(value);
+            }
+            else
+            {
+                digits.back() |= static_cast<uint8_t>(value << 4);
+            }
+            clues++;
+        }
+    }
+    bitmaps.insert(bitmaps.end(), bitmap, bitmap + SUDOKU_ARCHIVE_BITMAP_SIZE);
+    count++;
+
+    if (count % SUDOKU_ARCHIVE_STRIDE == 0)
+    {
+        closeBlock();
+    }
+}
+
+/* Bitmaps first, then the digits; the block's offset goes to the index */
+void SudokuArchiveWriter::closeBlock(void)
+{
+    index.push_back(blockBytes);
+    buffer.insert(buffer.end(), bitmaps.begin(), bitmaps.end());
+    buffer.insert(buffer.end(), digits.begin(), digits.end());
+    blockBytes += bitmaps.size() + digits.size();
+
+    bitmaps.clear();
+    digits.clear();
+    clues = 0;
+
+    if (buffer.size() >= WRITE_CHUNK_SIZE)
+    {
+        flushBuffer();
+    }
+}
+
+/* Writes the pending bytes */
+void SudokuArchiveWriter::flushBuffer(void)
+{
+    if (!buffer.empty() && std::fwrite(buffer.data(), 1, buffer.size(), out) != buffer.size())
+    {
+        buffer.clear();
+        throw SudokuArchiveWriteException();
+    }
+    buffer.clear();
+}
+
+/* Closes the last block, appends the index, then goes back for the header */
+void SudokuArchiveWriter::finish(void)
+{
+    if (finished)
+    {
+        return;
+    }
+    finished = true;
+    if (!bitmaps.empty())
+    {
+        closeBlock();
+    }
+    flushBuffer();
+
+    for (size_t entry = 0; entry < index.size(); entry++)
+    {
+        uint8_t bytes[8];
+        storeLe64(bytes, index[entry]);
+        buffer.insert(buffer.end(), bytes, bytes + 8);
+        if (buffer.size() >= WRITE_CHUNK_SIZE)
+        {
+            flushBuffer();
+        }
+    }
+    flushBuffer();
+
+    uint8_t header[SUDOKU_ARCHIVE_HEADER_SIZE] = {};
+    std::memcpy(header, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+    storeLe32(header + HEADER_VERSION, SUDOKU_ARCHIVE_VERSION);
+    storeLe32(header + HEADER_STRIDE, SUDOKU_ARCHIVE_STRIDE);
+    storeLe64(header + HEADER_COUNT, count);
+    storeLe64(header + HEADER_BLOCKS_OFFSET, SUDOKU_ARCHIVE_HEADER_SIZE);
+    storeLe64(header + HEADER_BLOCK_BYTES, blockBytes);
+    storeLe64(header + HEADER_INDEX_OFFSET, SUDOKU_ARCHIVE_HEADER_SIZE + blockBytes);
+
+    bool written = std::fseek(out, 0, SEEK_SET) == 0 &&
+                   std::fwrite(header, 1, sizeof(header), out) == sizeof(header);
+    written = (std::fclose(out) == 0) && written;
+    out = nullptr;
+    if (!written)
+    {
+        throw SudokuArchiveWriteException();
+    }
+}
+
+/* Puzzles appended so far */
+uint64_t SudokuArchiveWriter::size(void) const
+{
+    return count;
+}
+
+/*==============================================================================
+ *  SudokuArchiveReader
+ *============================================================================*/
+
+/* Maps the file (or reads it whole) and validates its layout */
+SudokuArchiveReader::SudokuArchiveReader(const char* path)
+    : fileData(nullptr), fileLength(0), mapped(false),
+      blocks(nullptr), blockBytes(0), index(nullptr), blockCount(0), count(0), stride(SUDOKU_ARCHIVE_STRIDE)
+{
+#ifdef SUDOKU_HAVE_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        throw SudokuArchiveOpenException();
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+    {
+        void* map = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED)
+        {
+            madvise(map, static_cast<size_t>(info.st_size), MADV_RANDOM);
+            fileData = static_cast<const uint8_t*>(map);
+            fileLength = static_cast<size_t>(info.st_size);
+            mapped = true;
+        }
+    }
+    close(fd);
+#endif
+
+    if (!mapped)
+    {
+        FILE* in = std::fopen(path, "rb");
+        if (in == nullptr)
+        {
+            throw SudokuArchiveOpenException();
+        }
+
+        uint8_t chunk[1 << 16];
+        size_t read;
+        while ((read = std::fread(chunk, 1, sizeof(chunk), in)) > 0)
+        {
+            loaded.insert(loaded.end(), chunk, chunk + read);
+        }
+        std::fclose(in);
+        fileData = loaded.data();
+        fileLength = loaded.size();
+    }
+
+    try
+    {
+        checkLayout();
+    }
+    catch (const SudokuArchiveException&)
+    {
+#ifdef SUDOKU_HAVE_MMAP
+        if (mapped)
+        {
+            munmap(const_cast<uint8_t*>(fileData), fileLength);
+        }
+#endif
+        throw;
+    }
+}
+
+/* Releases the mapping */
+SudokuArchiveReader::~SudokuArchiveReader()
+{
+#ifdef SUDOKU_HAVE_MMAP
+    if (mapped)
+    {
+        munmap(const_cast<uint8_t*>(fileData), fileLength);
+    }
+#endif
+}
+
+/* Checks the header fields against the file size and the index entries
+ * against the block area, so lookups only need to bound-check one block */
+void SudokuArchiveReader::checkLayout(void)
+{
+    if (fileLength < SUDOKU_ARCHIVE_HEADER_SIZE ||
+        std::memcmp(fileData, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0 ||
+        loadLe32(fileData + HEADER_VERSION) != SUDOKU_ARCHIVE_VERSION)
+    {
+        throw SudokuArchiveFormatException();
+    }
+
+    stride = loadLe32(fileData + HEADER_STRIDE);
+    count = loadLe64(fileData + HEADER_COUNT);
+    uint64_t blocksOffset = loadLe64(fileData + HEADER_BLOCKS_OFFSET);
+    blockBytes = loadLe64(fileData + HEADER_BLOCK_BYTES);
+    uint64_t indexOffset = loadLe64(fileData + HEADER_INDEX_OFFSET);
+
+    if (stride == 0 || blocksOffset != SUDOKU_ARCHIVE_HEADER_SIZE ||
+        blockBytes > fileLength || indexOffset != blocksOffset + blockBytes || indexOffset > fileLength ||
+        count > blockBytes / SUDOKU_ARCHIVE_BITMAP_SIZE)
+    {
+        throw SudokuArchiveFormatException();
+    }
+
+    blockCount = (count + stride - 1) / stride;
+    if ((fileLength - indexOffset) % 8 != 0 || (fileLength - indexOffset) / 8 != blockCount)
+    {
+        throw SudokuArchiveFormatException();
+    }
+
+    blocks = fileData + blocksOffset;
+    index = fileData + indexOffset;
+
+    uint64_t previous = 0;
+    for (uint64_t entry = 0; entry < blockCount; entry++)
+    {
+        uint64_t offset = loadLe64(index + entry * 8);
+        if (offset < previous || offset > blockBytes || (entry == 0 && offset != 0))
+        {
+            throw SudokuArchiveFormatException();
+        }
+        previous = offset;
+    }
+}
+
+/* Puzzles in the archive */
+uint64_t SudokuArchiveReader::size(void) const
+{
+    return count;
+}
+
+/* Reads the puzzle's bitmap from its block, counts the clues before it to
+ * find its first digit and decodes the digits into their cells */
+bool SudokuArchiveReader::get(uint64_t id, SudokuGridView grid) const
+{
+    if (id >= count)
+    {
+        return false;
+    }
+
+    uint64_t block = id / stride;
+    uint64_t slot = id % stride;
+    uint64_t start = loadLe64(index + block * 8);
+    uint64_t end = (block + 1 < blockCount) ? loadLe64(index + (block + 1) * 8) : blockBytes;
+    uint64_t puzzles = (block + 1 < blockCount) ? stride : count - block * stride;
+    if (end - start < puzzles * SUDOKU_ARCHIVE_BITMAP_SIZE)
+    {
+        throw SudokuArchiveFormatException();
+    }
+
+    const uint8_t* bitmaps = blocks + start;
+    const uint8_t* bitmap = bitmaps + slot * SUDOKU_ARCHIVE_BITMAP_SIZE;
+    size_t clue = 0;
+    for (uint64_t before = 0; before < slot; before++)
+    {
+        clue += clueCount(bitmaps + before * SUDOKU_ARCHIVE_BITMAP_SIZE);
+    }
+
+    const uint8_t* digits = bitmaps + puzzles * SUDOKU_ARCHIVE_BITMAP_SIZE;
+    uint64_t digitBytes = end - start - puzzles * SUDOKU_ARCHIVE_BITMAP_SIZE;
+    if ((clue + clueCount(bitmap) + 1) / 2 > digitBytes)
+    {
+        throw SudokuArchiveFormatException();
+    }
+
+    std::memset(grid.data(), 0, 81);
+    for (int word = 0; word < 2; word++)
+    {
+        uint64_t bits = (word == 0) ? loadLe64(bitmap) : highBits(bitmap);
+        while (bits)
+        {
+            int cell = 64 * word + sudokuCtz64(bits);
+            uint8_t value = (digits[clue / 2] >> (4 * (clue % 2))) & 0xF;
+            if (value < 1 || value > 9)
+            {
+                throw SudokuArchiveFormatException();
+            }
+            grid[cell] = value;
+            clue++;
+            bits &= bits - 1;
+        }
+    }
+    return true;
+}
+
+/*==============================================================================
+ *  FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Text to archive: one puzzle per line that parses */
+uint64_t packPuzzleText(SudokuPuzzleReader& reader, SudokuArchiveWriter& archive, uint64_t& skipped)
+{
+    uint8_t cells[81];
+    SudokuGridView grid(cells);
+    const char* line;
+    size_t length;
+
+    skipped = 0;
+    while (reader.nextLine(line, length))
+    {
+        if (parsePuzzleLine(line, length, grid))
+        {
+            archive.append(grid);
+        }
+        else
+        {
+            skipped++;
+        }
+    }
+    archive.finish();
+    return archive.size();
+}
+
+/* Archive to text, in ID order */
+void unpackPuzzleArchive(const SudokuArchiveReader& archive, SudokuSolutionWriter& writer)
+{
+    uint8_t cells[81];
+    SudokuGridView grid(cells);
+
+    for (uint64_t id = 0; id < archive.size(); id++)
+    {
+        archive.get(id, grid);
+        writer.writeGrid(grid);
+    }
+    writer.flush();
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
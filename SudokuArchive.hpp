@@ -0,0 +1,204 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuArchive
+ *  FILE         : SudokuArchive.hpp
+ *  DESCRIPTION  : Compact binary storage for large 9x9 puzzle collections.
+ *                 Each puzzle is an 81-bit clue bitmap plus its clue digits
+ *                 packed 4 bits each; an offset index at the end of the file
+ *                 lets a memory-mapped archive return any puzzle by ID
+ *                 without parsing the ones before it.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include "SudokuBoard.hpp"
+ #include "SudokuBatch.hpp"
+ #include <cstddef>
+ #include <cstdint>
+ #include <cstdio>
+ #include <vector>
+
+ /*==============================================================================
+  *  CONSTANTS
+  *============================================================================*/
+
+ /*
+  * File layout (all integers little-endian):
+  *
+  *   header   64 bytes: magic "SUDOKUA1", version, block size, puzzle count,
+  *            offset and size of the block area, offset of the index
+  *   blocks   SUDOKU_ARCHIVE_STRIDE puzzles each (fewer in the last one):
+  *            first the 11-byte clue bitmap of every puzzle (bit i of byte
+  *            i/8 set if cell i is a clue), then the clue digits of all of
+  *            them in cell order, 4 bits each, low nibble first
+  *   index    64-bit offset of every block within the block area
+  *
+  * Bitmaps have a fixed size, so a lookup jumps to its block, reads the
+  * puzzle's bitmap directly and finds its first digit by counting the clues
+  * in the bitmaps before it.
+  */
+ const uint32_t SUDOKU_ARCHIVE_VERSION     = 1;
+ const uint32_t SUDOKU_ARCHIVE_STRIDE      = 32;   // Puzzles per block
+ const size_t   SUDOKU_ARCHIVE_HEADER_SIZE = 64;
+ const size_t   SUDOKU_ARCHIVE_BITMAP_SIZE = 11;   // ceil(81 / 8)
+
+ /*==============================================================================
+  *  EXCEPTION CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuArchiveException
+  *  DESCRIPTION: Base exception class for archive errors.
+  *----------------------------------------------------------------------------*/
+ class SudokuArchiveException : public SudokuBoardException
+ {
+ public:
+     /* Returns a descriptive error message */
+     const char* what() const noexcept override;
+ };
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuArchiveOpenException
+  *  DESCRIPTION: Thrown when an archive file cannot be opened or created.
+  *----------------------------------------------------------------------------*/
+ class SudokuArchiveOpenException : public SudokuArchiveException
+ {
+ public:
+     /* Returns a message for the open failure */
+     const char* what() const noexcept override;
+ };
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuArchiveFormatException
+  *  DESCRIPTION: Thrown when a file is not an archive or is truncated.
+  *----------------------------------------------------------------------------*/
+ class SudokuArchiveFormatException : public SudokuArchiveException
+ {
+ public:
+     /* Returns a message for the malformed archive */
+     const char* what() const noexcept override;
+ };
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuArchiveWriteException
+  *  DESCRIPTION: Thrown when archive output cannot be written.
+  *----------------------------------------------------------------------------*/
+ class SudokuArchiveWriteException : public SudokuArchiveException
+ {
+ public:
+     /* Returns a message for the write failure */
+     const char* what() const noexcept override;
+ };
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuArchiveWriter
+  *  DESCRIPTION: Appends puzzles to a new archive file. Blocks are buffered
+  *               and written sequentially; finish() adds the index and then
+  *               fills in the header, so the output must be a seekable file.
+  *----------------------------------------------------------------------------*/
+ class SudokuArchiveWriter
+ {
+ private:
+     FILE*                 out;          // Archive file
+     std::vector<uint8_t>  buffer;       // Encoded blocks not yet written
+     std::vector<uint8_t>  bitmaps;      // Bitmaps of the block being filled
+     std::vector<uint8_t>  digits;       // Packed digits of the block being filled
+     size_t                clues;        // Digits in the block being filled
+     std::vector<uint64_t> index;        // Offset of every block
+     uint64_t              count;        // Puzzles appended so far
+     uint64_t              blockBytes;   // Size of the block area so far
+     bool                  finished;     // True once the index has been written
+
+     /* Moves the block being filled to the output buffer */
+     void closeBlock(void);
+
+     /* Writes the output buffer. Throws SudokuArchiveWriteException */
+     void flushBuffer(void);
+
+ public:
+     /* Creates (or truncates) the file. Throws SudokuArchiveOpenException */
+     explicit SudokuArchiveWriter(const char* path);
+
+     /* Finishes the archive if finish() was not called, errors are ignored */
+     ~SudokuArchiveWriter();
+
+     SudokuArchiveWriter(const SudokuArchiveWriter&) = delete;
+     SudokuArchiveWriter& operator=(const SudokuArchiveWriter&) = delete;
+
+     /* Appends one puzzle (values 0-9, 0 for blanks); its ID is the number of
+      * puzzles appended before it */
+     void append(SudokuConstGridView grid);
+
+     /* Writes the index and the header. Throws SudokuArchiveWriteException */
+     void finish(void);
+
+     /* Number of puzzles appended so far */
+     uint64_t size(void) const;
+ };
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuArchiveReader
+  *  DESCRIPTION: Read-only view of an archive. The file is memory-mapped
+  *               where available (read into memory otherwise) and checked
+  *               once on open; lookups do not allocate and are safe to call
+  *               from several threads.
+  *----------------------------------------------------------------------------*/
+ class SudokuArchiveReader
+ {
+ private:
+     const uint8_t*       fileData;     // Start of the mapped or loaded file
+     size_t               fileLength;   // Size of the file in bytes
+     bool                 mapped;       // True if fileData is a mapping
+     std::vector<uint8_t> loaded;       // File contents when mmap is unavailable
+     const uint8_t*       blocks;       // Start of the block area
+     uint64_t             blockBytes;   // Size of the block area
+     const uint8_t*       index;        // Start of the block offsets
+     uint64_t             blockCount;   // Entries in the index
+     uint64_t             count;        // Puzzles in the archive
+     uint32_t             stride;       // Puzzles per block
+
+     /* Validates the header and index. Throws SudokuArchiveFormatException */
+     void checkLayout(void);
+
+ public:
+     /* Opens and validates the archive. Throws SudokuArchiveOpenException or
+      * SudokuArchiveFormatException */
+     explicit SudokuArchiveReader(const char* path);
+
+     /* Releases the mapping */
+     ~SudokuArchiveReader();
+
+     SudokuArchiveReader(const SudokuArchiveReader&) = delete;
+     SudokuArchiveReader& operator=(const SudokuArchiveReader&) = delete;
+
+     /* Number of puzzles in the archive */
+     uint64_t size(void) const;
+
+     /* Decodes puzzle 'id' into the grid, false if the ID is out of range.
+      * Throws SudokuArchiveFormatException if its block is truncated. */
+     bool get(uint64_t id, SudokuGridView grid) const;
+ };
+
+ /*==============================================================================
+  *  FUNCTION DECLARATIONS
+  *============================================================================*/
+
+ /* Appends every well-formed 81-character line of the reader to the archive
+  * and returns the number of puzzles packed; lines that do not parse are
+  * counted in 'skipped' and get no ID */
+ uint64_t packPuzzleText(SudokuPuzzleReader& reader, SudokuArchiveWriter& archive, uint64_t& skipped);
+
+ /* Writes every puzzle of the archive as an 81-character line, in ID order */
+ void unpackPuzzleArchive(const SudokuArchiveReader& archive, SudokuSolutionWriter& writer);
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
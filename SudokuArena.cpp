@@ -0,0 +1,52 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuArena
+ *  FILE         : SudokuArena.cpp
+ *  DESCRIPTION  : Implements the fixed-size bump allocator.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuArena.hpp"
+#include <cstdint>
+#include <new>
+
+/*==============================================================================
+ *  CONSTANTS
+ *============================================================================*/
+
+namespace
+{
+    const size_t BLOCK_ALIGN = 64;   // Cache line; the largest alignment handed out
+}
+
+/*==============================================================================
+ *  PUBLIC FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Over-allocates by a cache line so the usable block can start on one */
+SudokuArena::SudokuArena(size_t capacity)
+    : storage(new unsigned char[capacity + BLOCK_ALIGN]), capacity(capacity), used(0)
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(storage.get());
+    base = storage.get() + ((BLOCK_ALIGN - address % BLOCK_ALIGN) % BLOCK_ALIGN);
+}
+
+/* Rounds the offset up to the alignment and bumps it past the request */
+void* SudokuArena::allocate(size_t bytes, size_t align)
+{
+    size_t offset = (used + align - 1) & ~(align - 1);
+
+    if (align > BLOCK_ALIGN || offset > capacity || bytes > capacity - offset)
+    {
+        throw std::bad_alloc();
+    }
+    used = offset + bytes;
+    return base + offset;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,69 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuArena
+ *  FILE         : SudokuArena.hpp
+ *  DESCRIPTION  : Fixed-size bump allocator for scratch memory that is reused
+ *                 between searches instead of being freed.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include <cstddef>
+ #include <memory>
+ #include <type_traits>
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuArena
+  *  DESCRIPTION: One block allocated up front and handed out front to back.
+  *               Nothing is freed on its own; reset() makes the whole block
+  *               available again. Objects are not constructed or destroyed,
+  *               so only trivial types belong in an arena.
+  *----------------------------------------------------------------------------*/
+ class SudokuArena
+ {
+ private:
+     std::unique_ptr<unsigned char[]> storage;    // Block as allocated
+     unsigned char*                   base;       // Block aligned to a cache line
+     size_t                           capacity;   // Usable bytes from 'base'
+     size_t                           used;       // Bytes handed out since the last reset
+
+ public:
+     /* Allocates a block of 'capacity' usable bytes */
+     explicit SudokuArena(size_t capacity);
+
+     SudokuArena(const SudokuArena&) = delete;
+     SudokuArena& operator=(const SudokuArena&) = delete;
+
+     /* Returns 'bytes' bytes aligned to 'align' (a power of two, at most 64).
+      * Throws std::bad_alloc when the block is exhausted. */
+     void* allocate(size_t bytes, size_t align);
+
+     /* Returns room for 'count' objects of a trivial type */
+     template <class T>
+     T* allocateArray(size_t count)
+     {
+         static_assert(std::is_trivially_copyable<T>::value, "arena memory is never constructed or destroyed");
+         return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+     }
+
+     /* Makes the whole block available again */
+     void reset(void) noexcept { used = 0; }
+
+     /* Bytes handed out since the last reset */
+     size_t bytesUsed(void) const noexcept { return used; }
+
+     /* Usable size of the block */
+     size_t bytesCapacity(void) const noexcept { return capacity; }
+ };
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
@@ -0,0 +1,889 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuBatch
+ *  FILE         : SudokuBatch.cpp
+ *  DESCRIPTION  : Implements streaming puzzle input, buffered solution output
+ *                 and the single-threaded and work-stealing batch solve
+ *                 loops.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuBatch.hpp"
+#include "SudokuSolver.hpp"
+#include "SudokuSolverEngine.hpp"
+#include "SudokuSimd.hpp"
+#include "SudokuThreadPool.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SUDOKU_HAVE_MMAP 1
+#endif
+
+/*==============================================================================
+ *  CONSTANTS
+ *============================================================================*/
+
+namespace
+{
+    const size_t READ_CHUNK_SIZE  = 1 << 20;   // Stream mode read size
+    const size_t WRITE_CHUNK_SIZE = 1 << 20;   // Output buffer size
+
+    const size_t BLOCK_PUZZLES    = 256;       // Puzzles per parallel work item
+    const size_t BLOCKS_PER_WORKER = 4;        // In-flight blocks per worker
+
+    const char UNSOLVABLE_LINE[] = "unsolvable";
+    const char MULTIPLE_LINE[]   = "multiple";
+    const char INVALID_LINE[]    = "invalid";
+    const char VALID_LINE[]      = "valid";
+
+    const size_t STATS_LINE_SIZE  = 512;       // Longest JSON statistics line
+
+#ifdef _WIN32
+    const char NULL_DEVICE[] = "NUL";
+#else
+    const char NULL_DEVICE[] = "/dev/null";
+#endif
+
+    /* Outcome of one input line */
+    enum LineStatus : uint8_t
+    {
+        LINE_PENDING,
+        LINE_SOLVED,
+        LINE_UNSOLVABLE,
+        LINE_MULTIPLE,
+        LINE_INVALID
+    };
+
+    /* Output character for a cell value: digits, then letters from 'A' for 10 */
+    inline char symbolOf(int value)
+    {
+        if (value == 0)
+        {
+            return '.';
+        }
+        return static_cast<char>(value <= 9 ? '0' + value : 'A' + value - 10);
+    }
+
+    /* Cell value of an input character ('.' and '0' are blank), -1 if none */
+    inline int valueOf(char symbol)
+    {
+        if (symbol >= '1' && symbol <= '9')
+        {
+            return symbol - '0';
+        }
+        if (symbol >= 'A' && symbol <= 'Z')
+        {
+            return symbol - 'A' + 10;
+        }
+        if (symbol >= 'a' && symbol <= 'z')
+        {
+            return symbol - 'a' + 10;
+        }
+        return (symbol == '.' || symbol == '0') ? 0 : -1;
+    }
+
+    /* A run of consecutive input lines solved as one pool task */
+    template <int Box>
+    struct PuzzleBlock
+    {
+        uint8_t          grids[BLOCK_PUZZLES * SudokuDimensions<Box>::CELLS];
+        uint8_t          status[BLOCK_PUZZLES];
+        SudokuSolveStats stats[BLOCK_PUZZLES];   // Filled only when collecting statistics
+        size_t           count;
+        bool             done;                   // Guarded by the driver's completion lock
+    };
+
+    /* Per-worker solver, padded so neighbours do not share a cache line */
+    template <int Box>
+    struct alignas(64) WorkerSolver
+    {
+        std::unique_ptr<BasicSudokuSolverEngine<Box>> solver;
+    };
+
+    /* Solver for one board size; only 9x9 has a choice of engines */
+    template <int Box>
+    std::unique_ptr<BasicSudokuSolverEngine<Box>> makeEngine(SudokuEngineKind, bool collectStats)
+    {
+        if (collectStats)
+        {
+            return std::unique_ptr<BasicSudokuSolverEngine<Box>>(new BasicSudokuSolver<Box, SudokuCountingStats>());
+        }
+        return std::unique_ptr<BasicSudokuSolverEngine<Box>>(new BasicSudokuSolver<Box>());
+    }
+
+    template <>
+    std::unique_ptr<SudokuSolverEngine> makeEngine<3>(SudokuEngineKind engine, bool collectStats)
+    {
+        return makeSudokuSolverEngine(engine, collectStats);
+    }
+
+    /* Solves a parsed puzzle in place; with requireUnique the search continues
+     * to a second solution and rejects puzzles that have one */
+    template <int Box>
+    LineStatus solveLine(BasicSudokuSolverEngine<Box>& solver, BasicSudokuGridView<Box> grid, bool requireUnique)
+    {
+        if (!requireUnique)
+        {
+            return solver.solve(grid) ? LINE_SOLVED : LINE_UNSOLVABLE;
+        }
+
+        int count = solver.countSolutions(grid, 2);
+        if (count == 1)
+        {
+            solver.copySolution(grid);
+            return LINE_SOLVED;
+        }
+        return (count == 0) ? LINE_UNSOLVABLE : LINE_MULTIPLE;
+    }
+
+    /* Solves the parsed lines of a block. With statistics every line is
+     * solved on its own so its stats can be read back; otherwise the whole
+     * block goes to the engine's solveMany, which lets the lockstep engine
+     * keep all of its lanes busy. */
+    template <int Box>
+    void solveBlock(BasicSudokuSolverEngine<Box>& solver, PuzzleBlock<Box>& block,
+                    bool requireUnique, bool collectStats)
+    {
+        const size_t CELLS = SudokuDimensions<Box>::CELLS;
+
+        if (collectStats)
+        {
+            for (size_t index = 0; index < block.count; index++)
+            {
+                if (block.status[index] == LINE_PENDING)
+                {
+                    BasicSudokuGridView<Box> grid(block.grids + index * CELLS);
+                    block.status[index] = solveLine<Box>(solver, grid, requireUnique);
+                    solver.getSolveStats(block.stats[index]);
+                }
+            }
+            return;
+        }
+
+        uint8_t* grids[BLOCK_PUZZLES] = {};
+        size_t lines[BLOCK_PUZZLES];
+        int found[BLOCK_PUZZLES];
+        size_t pending = 0;
+
+        for (size_t index = 0; index < block.count; index++)
+        {
+            if (block.status[index] == LINE_PENDING)
+            {
+                grids[pending] = block.grids + index * CELLS;
+                lines[pending++] = index;
+            }
+        }
+        solver.solveMany(grids, pending, requireUnique ? 2 : 1, found);
+        for (size_t index = 0; index < pending; index++)
+        {
+            block.status[lines[index]] = (found[index] == 0) ? LINE_UNSOLVABLE :
+                                         (found[index] == 1) ? LINE_SOLVED : LINE_MULTIPLE;
+        }
+    }
+
+    /* Reads up to BLOCK_PUZZLES lines into the block, parsing each one;
+     * false once the input is exhausted */
+    template <int Box>
+    bool readBlock(SudokuPuzzleReader& reader, PuzzleBlock<Box>& block)
+    {
+        const size_t CELLS = SudokuDimensions<Box>::CELLS;
+        const char* line;
+        size_t length;
+
+        block.count = 0;
+        block.done = false;
+        while (block.count < BLOCK_PUZZLES)
+        {
+            if (!reader.nextLine(line, length))
+            {
+                return false;
+            }
+            BasicSudokuGridView<Box> grid(block.grids + block.count * CELLS);
+            block.status[block.count] = parsePuzzleLine(line, length, grid) ? LINE_PENDING : LINE_INVALID;
+            block.count++;
+        }
+        return true;
+    }
+
+    /* Writes the output line for one puzzle and updates the counters */
+    template <int Box>
+    void writeResult(SudokuSolutionWriter& writer, SudokuBatchStats& stats,
+                     LineStatus status, BasicSudokuConstGridView<Box> grid)
+    {
+        switch (status)
+        {
+            case LINE_SOLVED:
+            stats.solved++;
+            writer.writeGrid(grid);
+            break;
+
+            case LINE_UNSOLVABLE:
+            stats.unsolvable++;
+            writer.writeLine(UNSOLVABLE_LINE, sizeof(UNSOLVABLE_LINE) - 1);
+            break;
+
+            case LINE_MULTIPLE:
+            stats.multiple++;
+            writer.writeLine(MULTIPLE_LINE, sizeof(MULTIPLE_LINE) - 1);
+            break;
+
+            default:
+            stats.invalid++;
+            writer.writeLine(INVALID_LINE, sizeof(INVALID_LINE) - 1);
+            break;
+        }
+    }
+
+    /* Output word of a line status, as used in the statistics lines */
+    const char* statusName(LineStatus status)
+    {
+        switch (status)
+        {
+            case LINE_SOLVED:     return "solved";
+            case LINE_UNSOLVABLE: return UNSOLVABLE_LINE;
+            case LINE_MULTIPLE:   return MULTIPLE_LINE;
+            default:              return INVALID_LINE;
+        }
+    }
+
+    /* Writes the statistics line of one input line and adds the solve to the
+     * run totals; lines that did not parse have no solve to report */
+    void writeStats(SudokuSolutionWriter& statsWriter, SudokuBatchStats& stats, uint64_t lineNumber,
+                    LineStatus status, const SudokuSolveStats& solve)
+    {
+        char text[STATS_LINE_SIZE];
+        int written = std::snprintf(text, sizeof(text), "{\"line\":%llu,\"status\":\"%s\"",
+                                    static_cast<unsigned long long>(lineNumber), statusName(status));
+        size_t length = static_cast<size_t>(written);
+
+        if (status != LINE_INVALID)
+        {
+            std::memcpy(text + length, ",\"stats\":", 9);
+            length += 9;
+            length += formatSudokuSolveStats(solve, text + length, sizeof(text) - length - 1);
+
+            accumulateSudokuSolveStats(stats.search, solve);
+            if (solve.nodes > stats.hardestNodes)
+            {
+                stats.hardestNodes = solve.nodes;
+                stats.hardestLine = lineNumber;
+            }
+        }
+        text[length++] = '}';
+        statsWriter.writeLine(text, length);
+    }
+
+    /* Writes the closing summary object of a run and flushes the stats output */
+    void writeStatsSummary(SudokuSolutionWriter& statsWriter, const SudokuBatchStats& stats)
+    {
+        char text[STATS_LINE_SIZE];
+        char search[STATS_LINE_SIZE / 2];
+
+        formatSudokuSolveStats(stats.search, search, sizeof(search));
+        int written = std::snprintf(text, sizeof(text),
+                                    "{\"summary\":{\"puzzles\":%llu,\"solved\":%llu,\"unsolvable\":%llu,"
+                                    "\"multiple\":%llu,\"invalid\":%llu,\"seconds\":%.6f},"
+                                    "\"stats\":%s,\"hardest\":{\"line\":%llu,\"nodes\":%llu}}",
+                                    static_cast<unsigned long long>(stats.puzzles),
+                                    static_cast<unsigned long long>(stats.solved),
+                                    static_cast<unsigned long long>(stats.unsolvable),
+                                    static_cast<unsigned long long>(stats.multiple),
+                                    static_cast<unsigned long long>(stats.invalid),
+                                    stats.seconds, search,
+                                    static_cast<unsigned long long>(stats.hardestLine),
+                                    static_cast<unsigned long long>(stats.hardestNodes));
+        statsWriter.writeLine(text, static_cast<size_t>(written));
+        statsWriter.flush();
+    }
+}
+
+/*==============================================================================
+ *  EXCEPTION DEFINITIONS
+ *============================================================================*/
+
+/* Returns generic batch error message */
+const char* SudokuBatchException::what() const noexcept
+{
+    return "Batch Error.";
+}
+
+/* Returns error message for an input that cannot be opened */
+const char* SudokuBatchOpenException::what() const noexcept
+{
+    return "Batch Error (Cannot Open Input).";
+}
+
+/* Returns error message for a failed write */
+const char* SudokuBatchWriteException::what() const noexcept
+{
+    return "Batch Error (Cannot Write Output).";
+}
+
+/*==============================================================================
+ *  SudokuPuzzleReader
+ *============================================================================*/
+
+/* Maps regular files, falls back to chunked reads for stdin and pipes */
+SudokuPuzzleReader::SudokuPuzzleReader(const char* path)
+    : mapBegin(nullptr), mapLength(0), mapCursor(nullptr),
+      stream(nullptr), ownsStream(false),
+      bufferStart(0), bufferEnd(0), streamEof(false)
+{
+    bool isStdin = std::strcmp(path, "-") == 0;
+
+#ifdef SUDOKU_HAVE_MMAP
+    if (!isStdin)
+    {
+        int fd = open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            throw SudokuBatchOpenException();
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+        {
+            void* map = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED)
+            {
+                madvise(map, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+                mapBegin = static_cast<const char*>(map);
+                mapLength = static_cast<size_t>(info.st_size);
+                mapCursor = mapBegin;
+                close(fd);
+                return;
+            }
+        }
+        close(fd);
+    }
+#endif
+
+    if (isStdin)
+    {
+        stream = stdin;
+    }
+    else
+    {
+        stream = std::fopen(path, "rb");
+        if (stream == nullptr)
+        {
+            throw SudokuBatchOpenException();
+        }
+        ownsStream = true;
+    }
+    buffer.resize(READ_CHUNK_SIZE);
+}
+
+/* Releases the mapping or closes the stream */
+SudokuPuzzleReader::~SudokuPuzzleReader()
+{
+#ifdef SUDOKU_HAVE_MMAP
+    if (mapBegin != nullptr)
+    {
+        munmap(const_cast<char*>(mapBegin), mapLength);
+    }
+#endif
+    if (ownsStream)
+    {
+        std::fclose(stream);
+    }
+}
+
+/* Moves the unread tail to the front of the buffer and reads the next chunk */
+bool SudokuPuzzleReader::refill(void)
+{
+    if (streamEof)
+    {
+        return false;
+    }
+
+    size_t pending = bufferEnd - bufferStart;
+    if (bufferStart > 0)
+    {
+        std::memmove(buffer.data(), buffer.data() + bufferStart, pending);
+        bufferStart = 0;
+        bufferEnd = pending;
+    }
+    if (bufferEnd == buffer.size())
+    {
+        buffer.resize(buffer.size() * 2);   // Line longer than one chunk
+    }
+
+    size_t count = std::fread(buffer.data() + bufferEnd, 1, buffer.size() - bufferEnd, stream);
+    bufferEnd += count;
+    if (count == 0)
+    {
+        streamEof = true;
+    }
+    return count > 0;
+}
+
+/* Returns the next line with its '\n' (and any '\r') stripped */
+bool SudokuPuzzleReader::nextLine(const char*& line, size_t& length)
+{
+    if (mapBegin != nullptr)
+    {
+        const char* mapEnd = mapBegin + mapLength;
+        if (mapCursor >= mapEnd)
+        {
+            return false;
+        }
+
+        const char* newline = static_cast<const char*>(std::memchr(mapCursor, '\n', mapEnd - mapCursor));
+        const char* lineEnd = newline ? newline : mapEnd;
+
+        line = mapCursor;
+        length = lineEnd - mapCursor;
+        mapCursor = newline ? newline + 1 : mapEnd;
+    }
+    else
+    {
+        const char* newline = nullptr;
+        size_t searched = 0;
+
+        while (true)
+        {
+            newline = static_cast<const char*>(std::memchr(buffer.data() + bufferStart + searched, '\n',
+                                                           bufferEnd - bufferStart - searched));
+            if (newline != nullptr)
+            {
+                break;
+            }
+            searched = bufferEnd - bufferStart;
+            if (!refill())
+            {
+                break;
+            }
+        }
+
+        if (newline == nullptr && bufferStart == bufferEnd)
+        {
+            return false;
+        }
+
+        line = buffer.data() + bufferStart;
+        if (newline != nullptr)
+        {
+            length = newline - line;
+            bufferStart += length + 1;
+        }
+        else
+        {
+            length = bufferEnd - bufferStart;   // Last line without a newline
+            bufferStart = bufferEnd;
+        }
+    }
+
+    if (length > 0 && line[length - 1] == '\r')
+    {
+        length--;
+    }
+    return true;
+}
+
+/*==============================================================================
+ *  SudokuSolutionWriter
+ *============================================================================*/
+
+/* Allocates the output buffer once */
+SudokuSolutionWriter::SudokuSolutionWriter(FILE* out)
+    : out(out), buffer(WRITE_CHUNK_SIZE), used(0)
+{
+}
+
+/* Flushes pending output, errors are ignored at this point */
+SudokuSolutionWriter::~SudokuSolutionWriter()
+{
+    try
+    {
+        flush();
+    }
+    catch (const SudokuBatchException&)
+    {
+    }
+}
+
+/* Writes the grid as one character per cell followed by a newline */
+template <int Box>
+void SudokuSolutionWriter::writeGrid(BasicSudokuConstGridView<Box> grid)
+{
+    const size_t cells = SudokuDimensions<Box>::CELLS;
+
+    if (buffer.size() - used < cells + 1)
+    {
+        flush();
+    }
+
+    char* dest = buffer.data() + used;
+    for (size_t cell = 0; cell < cells; cell++)
+    {
+        dest[cell] = symbolOf(grid[cell]);
+    }
+    dest[cells] = '\n';
+    used += cells + 1;
+}
+
+template void SudokuSolutionWriter::writeGrid<2>(BasicSudokuConstGridView<2>);
+template void SudokuSolutionWriter::writeGrid<3>(BasicSudokuConstGridView<3>);
+template void SudokuSolutionWriter::writeGrid<4>(BasicSudokuConstGridView<4>);
+template void SudokuSolutionWriter::writeGrid<5>(BasicSudokuConstGridView<5>);
+
+/* Writes the text followed by a newline */
+void SudokuSolutionWriter::writeLine(const char* text, size_t length)
+{
+    if (buffer.size() - used < length + 1)
+    {
+        flush();
+        if (buffer.size() < length + 1)
+        {
+            buffer.resize(length + 1);
+        }
+    }
+
+    std::memcpy(buffer.data() + used, text, length);
+    buffer[used + length] = '\n';
+    used += length + 1;
+}
+
+/* Hands the buffered bytes to the stream */
+void SudokuSolutionWriter::flush(void)
+{
+    if (used > 0 && std::fwrite(buffer.data(), 1, used, out) != used)
+    {
+        used = 0;
+        throw SudokuBatchWriteException();
+    }
+    used = 0;
+    if (std::fflush(out) != 0)
+    {
+        throw SudokuBatchWriteException();
+    }
+}
+
+/*==============================================================================
+ *  BATCH LOOPS
+ *============================================================================*/
+
+namespace
+{
+    /* Single-threaded batch loop: read, parse and solve a block, write it */
+    template <int Box>
+    SudokuBatchStats solveBatch(SudokuPuzzleReader& reader, SudokuSolutionWriter& writer,
+                                bool requireUnique, SudokuEngineKind engine,
+                                SudokuSolutionWriter* statsWriter)
+    {
+        SudokuBatchStats stats = {};
+        std::unique_ptr<BasicSudokuSolverEngine<Box>> solver = makeEngine<Box>(engine, statsWriter != nullptr);
+        std::unique_ptr<PuzzleBlock<Box>> block(new PuzzleBlock<Box>());
+        const size_t CELLS = SudokuDimensions<Box>::CELLS;
+        bool moreInput = true;
+
+        auto start = std::chrono::steady_clock::now();
+
+        while (moreInput)
+        {
+            moreInput = readBlock(reader, *block);
+            solveBlock(*solver, *block, requireUnique, statsWriter != nullptr);
+            for (size_t index = 0; index < block->count; index++)
+            {
+                LineStatus status = static_cast<LineStatus>(block->status[index]);
+                stats.puzzles++;
+                writeResult<Box>(writer, stats, status, BasicSudokuConstGridView<Box>(block->grids + index * CELLS));
+                if (statsWriter != nullptr)
+                {
+                    writeStats(*statsWriter, stats, stats.puzzles, status, block->stats[index]);
+                }
+            }
+        }
+        writer.flush();
+
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (statsWriter != nullptr)
+        {
+            writeStatsSummary(*statsWriter, stats);
+        }
+        return stats;
+    }
+
+    /* Parallel batch loop: the calling thread reads and writes, the pool solves */
+    template <int Box>
+    SudokuBatchStats parallelSolveBatch(SudokuPuzzleReader& reader, SudokuSolutionWriter& writer,
+                                        unsigned int threadCount, bool requireUnique,
+                                        SudokuEngineKind engine, SudokuSolutionWriter* statsWriter)
+    {
+        SudokuBatchStats stats = {};
+        SudokuThreadPool pool(threadCount);
+        const bool collectStats = statsWriter != nullptr;
+        std::unique_ptr<WorkerSolver<Box>[]> solvers(new WorkerSolver<Box>[pool.size()]);
+        for (unsigned int worker = 0; worker < pool.size(); worker++)
+        {
+            solvers[worker].solver = makeEngine<Box>(engine, collectStats);
+        }
+        std::deque<std::unique_ptr<PuzzleBlock<Box>>> inFlight;
+        std::vector<std::unique_ptr<PuzzleBlock<Box>>> spare;
+        std::mutex doneLock;
+        std::condition_variable blockDone;
+        const size_t CELLS = SudokuDimensions<Box>::CELLS;
+        const size_t maxInFlight = pool.size() * BLOCKS_PER_WORKER;
+        bool moreInput = true;
+        uint64_t linesWritten = 0;
+
+        auto start = std::chrono::steady_clock::now();
+
+        // Writes the oldest block once it is done, keeping output in input order
+        auto writeOldest = [&]()
+        {
+            PuzzleBlock<Box>* block = inFlight.front().get();
+            {
+                std::unique_lock<std::mutex> guard(doneLock);
+                blockDone.wait(guard, [block] { return block->done; });
+            }
+
+            for (size_t index = 0; index < block->count; index++)
+            {
+                LineStatus status = static_cast<LineStatus>(block->status[index]);
+                writeResult<Box>(writer, stats, status, BasicSudokuConstGridView<Box>(block->grids + index * CELLS));
+                linesWritten++;
+                if (statsWriter != nullptr)
+                {
+                    writeStats(*statsWriter, stats, linesWritten, status, block->stats[index]);
+                }
+            }
+            spare.push_back(std::move(inFlight.front()));
+            inFlight.pop_front();
+        };
+
+        while (moreInput)
+        {
+            std::unique_ptr<PuzzleBlock<Box>> block;
+            if (spare.empty())
+            {
+                block.reset(new PuzzleBlock<Box>());
+            }
+            else
+            {
+                block = std::move(spare.back());
+                spare.pop_back();
+            }
+
+            moreInput = readBlock(reader, *block);
+            if (block->count == 0)
+            {
+                break;
+            }
+            stats.puzzles += block->count;
+
+            PuzzleBlock<Box>* task = block.get();
+            inFlight.push_back(std::move(block));
+            pool.submit([task, requireUnique, collectStats, &solvers, &doneLock, &blockDone](unsigned int worker)
+            {
+                solveBlock(*solvers[worker].solver, *task, requireUnique, collectStats);
+
+                std::lock_guard<std::mutex> guard(doneLock);
+                task->done = true;
+                blockDone.notify_all();
+            });
+
+            while (inFlight.size() >= maxInFlight)
+            {
+                writeOldest();
+            }
+        }
+
+        while (!inFlight.empty())
+        {
+            writeOldest();
+        }
+        writer.flush();
+
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (statsWriter != nullptr)
+        {
+            writeStatsSummary(*statsWriter, stats);
+        }
+        return stats;
+    }
+}
+
+/*==============================================================================
+ *  FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Parses the first CELLS characters of the line into the grid */
+template <int Box>
+bool parsePuzzleLine(const char* line, size_t length, BasicSudokuGridView<Box> grid)
+{
+    const size_t cells = SudokuDimensions<Box>::CELLS;
+
+    if (length < cells)
+    {
+        return false;
+    }
+    if (length > cells && line[cells] != ' ' && line[cells] != '\t' && line[cells] != ',' && line[cells] != ';')
+    {
+        return false;
+    }
+
+    for (size_t cell = 0; cell < cells; cell++)
+    {
+        int value = valueOf(line[cell]);
+        if (value < 0 || value > SudokuDimensions<Box>::SIZE)
+        {
+            return false;
+        }
+        grid[cell] = static_cast<uint8_t>(value);
+    }
+    return true;
+}
+
+template bool parsePuzzleLine<2>(const char*, size_t, BasicSudokuGridView<2>);
+template bool parsePuzzleLine<3>(const char*, size_t, BasicSudokuGridView<3>);
+template bool parsePuzzleLine<4>(const char*, size_t, BasicSudokuGridView<4>);
+template bool parsePuzzleLine<5>(const char*, size_t, BasicSudokuGridView<5>);
+
+/* Single-threaded batch loop for the given box size */
+SudokuBatchStats runSolveBatch(SudokuPuzzleReader& reader, SudokuSolutionWriter& writer,
+                               bool requireUnique, SudokuEngineKind engine, int box,
+                               SudokuSolutionWriter* statsWriter)
+{
+    switch (box)
+    {
+        case 2:  return solveBatch<2>(reader, writer, requireUnique, engine, statsWriter);
+        case 4:  return solveBatch<4>(reader, writer, requireUnique, engine, statsWriter);
+        case 5:  return solveBatch<5>(reader, writer, requireUnique, engine, statsWriter);
+        default: return solveBatch<3>(reader, writer, requireUnique, engine, statsWriter);
+    }
+}
+
+/* Parallel batch loop for the given box size */
+SudokuBatchStats runParallelSolveBatch(SudokuPuzzleReader& reader, SudokuSolutionWriter& writer,
+                                       unsigned int threadCount, bool requireUnique,
+                                       SudokuEngineKind engine, int box,
+                                       SudokuSolutionWriter* statsWriter)
+{
+    switch (box)
+    {
+        case 2:  return parallelSolveBatch<2>(reader, writer, threadCount, requireUnique, engine, statsWriter);
+        case 4:  return parallelSolveBatch<4>(reader, writer, threadCount, requireUnique, engine, statsWriter);
+        case 5:  return parallelSolveBatch<5>(reader, writer, threadCount, requireUnique, engine, statsWriter);
+        default: return parallelSolveBatch<3>(reader, writer, threadCount, requireUnique, engine, statsWriter);
+    }
+}
+
+/* Verify loop: parses a block of grids, then validates the whole block */
+SudokuBatchStats runVerifyBatch(SudokuPuzzleReader& reader, SudokuSolutionWriter& writer)
+{
+    SudokuBatchStats stats = {};
+    std::unique_ptr<PuzzleBlock<3>> block(new PuzzleBlock<3>());
+    bool valid[BLOCK_PUZZLES];
+    const char* line;
+    size_t length;
+    bool moreInput = true;
+
+    auto start = std::chrono::steady_clock::now();
+
+    while (moreInput)
+    {
+        block->count = 0;
+        while (block->count < BLOCK_PUZZLES)
+        {
+            if (!reader.nextLine(line, length))
+            {
+                moreInput = false;
+                break;
+            }
+            uint8_t* grid = block->grids + block->count * 81;
+            if (!parsePuzzleLine(line, length, SudokuGridView(grid)))
+            {
+                std::memset(grid, 0, 81);   // Blank grids never validate
+            }
+            block->count++;
+        }
+        stats.puzzles += block->count;
+
+        validateSudokuSolutions(block->grids, block->count, valid);
+        for (size_t index = 0; index < block->count; index++)
+        {
+            if (valid[index])
+            {
+                stats.valid++;
+                writer.writeLine(VALID_LINE, sizeof(VALID_LINE) - 1);
+            }
+            else
+            {
+                stats.invalid++;
+                writer.writeLine(INVALID_LINE, sizeof(INVALID_LINE) - 1);
+            }
+        }
+    }
+    writer.flush();
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+/* Re-runs the batch with a doubling worker count and reports the throughput */
+void reportBatchScaling(const char* path, unsigned int maxThreads, FILE* report,
+                        SudokuEngineKind engine, int box)
+{
+    if (maxThreads == 0)
+    {
+        maxThreads = std::thread::hardware_concurrency();
+        if (maxThreads == 0)
+        {
+            maxThreads = 1;
+        }
+    }
+
+    FILE* sink = std::fopen(NULL_DEVICE, "wb");
+    if (sink == nullptr)
+    {
+        throw SudokuBatchWriteException();
+    }
+
+    double baseline = 0.0;
+    std::fprintf(report, "threads  seconds  puzzles/s  speedup  efficiency\n");
+
+    for (unsigned int threads = 1; ; threads = (threads * 2 > maxThreads) ? maxThreads : threads * 2)
+    {
+        SudokuPuzzleReader reader(path);
+        SudokuBatchStats stats;
+        {
+            SudokuSolutionWriter writer(sink);
+            stats = runParallelSolveBatch(reader, writer, threads, false, engine, box);
+        }
+
+        double rate = stats.seconds > 0 ? stats.puzzles / stats.seconds : 0.0;
+        if (threads == 1)
+        {
+            baseline = rate;
+        }
+        double speedup = baseline > 0 ? rate / baseline : 0.0;
+        std::fprintf(report, "%7u  %7.3f  %9.0f  %6.2fx  %9.0f%%\n",
+                     threads, stats.seconds, rate, speedup, 100.0 * speedup / threads);
+
+        if (threads == maxThreads)
+        {
+            break;
+        }
+    }
+    std::fclose(sink);
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
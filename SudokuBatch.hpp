@@ -0,0 +1,201 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuBatch
+ *  FILE         : SudokuBatch.hpp
+ *  DESCRIPTION  : Non-interactive batch mode. Streams puzzles in the
+ *                 one-line-per-puzzle format (81 characters for 9x9) from a
+ *                 file or stdin, solves them (on one thread or on a
+ *                 work-stealing pool) and writes one line per input line
+ *                 through a buffered writer.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include "SudokuBoard.hpp"
+ #include "SudokuSolverEngine.hpp"
+ #include <cstddef>
+ #include <cstdint>
+ #include <cstdio>
+ #include <vector>
+
+ /*==============================================================================
+  *  EXCEPTION CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuBatchException
+  *  DESCRIPTION: Base exception class for batch input/output errors.
+  *----------------------------------------------------------------------------*/
+ class SudokuBatchException : public SudokuBoardException
+ {
+ public:
+     /* Returns a descriptive error message */
+     const char* what() const noexcept override;
+ };
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuBatchOpenException
+  *  DESCRIPTION: Thrown when the batch input file cannot be opened.
+  *----------------------------------------------------------------------------*/
+ class SudokuBatchOpenException : public SudokuBatchException
+ {
+ public:
+     /* Returns a message for the open failure */
+     const char* what() const noexcept override;
+ };
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuBatchWriteException
+  *  DESCRIPTION: Thrown when batch output cannot be written.
+  *----------------------------------------------------------------------------*/
+ class SudokuBatchWriteException : public SudokuBatchException
+ {
+ public:
+     /* Returns a message for the write failure */
+     const char* what() const noexcept override;
+ };
+
+ /*==============================================================================
+  *  TYPE DEFINITIONS
+  *============================================================================*/
+
+ /* Counters reported at the end of a batch run */
+ struct SudokuBatchStats
+ {
+     uint64_t         puzzles;        // Input lines processed
+     uint64_t         solved;         // Puzzles with a solution written
+     uint64_t         unsolvable;     // Well-formed puzzles without a solution
+     uint64_t         multiple;       // Puzzles rejected for having several solutions
+     uint64_t         invalid;        // Lines that are not a puzzle (or not a solution when verifying)
+     uint64_t         valid;          // Complete, correct grids when verifying
+     double           seconds;        // Wall-clock time of the run
+     SudokuSolveStats search;         // Solver statistics summed over the run (with a stats writer)
+     uint64_t         hardestLine;    // Input line (from 1) whose solve entered the most nodes
+     uint64_t         hardestNodes;   // Nodes entered by that solve
+ };
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuPuzzleReader
+  *  DESCRIPTION: Hands out input lines one at a time without loading the whole
+  *               input. Regular files are memory-mapped and read sequentially;
+  *               stdin and pipes are read through a fixed-size chunk buffer.
+  *----------------------------------------------------------------------------*/
+ class SudokuPuzzleReader
+ {
+ private:
+     const char*       mapBegin;     // Mapped file (null in stream mode)
+     size_t            mapLength;    // Size of the mapping in bytes
+     const char*       mapCursor;    // Start of the next line in the mapping
+     FILE*             stream;       // Input stream (null in map mode)
+     bool              ownsStream;   // True if the stream must be closed
+     std::vector<char> buffer;       // Chunk buffer for stream mode
+     size_t            bufferStart;  // Start of unread data in the buffer
+     size_t            bufferEnd;    // End of valid data in the buffer
+     bool              streamEof;    // True once the stream is exhausted
+
+     /* Reads more data into the chunk buffer, false if nothing was added */
+     bool refill(void);
+
+ public:
+     /* Opens the given path, "-" reads from stdin. Throws SudokuBatchOpenException */
+     explicit SudokuPuzzleReader(const char* path);
+
+     /* Releases the mapping or closes the stream */
+     ~SudokuPuzzleReader();
+
+     SudokuPuzzleReader(const SudokuPuzzleReader&) = delete;
+     SudokuPuzzleReader& operator=(const SudokuPuzzleReader&) = delete;
+
+     /* Returns the next line without its terminator; the pointer stays valid
+      * until the next call. Returns false at end of input. */
+     bool nextLine(const char*& line, size_t& length);
+ };
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuSolutionWriter
+  *  DESCRIPTION: Buffered line writer used for batch output.
+  *----------------------------------------------------------------------------*/
+ class SudokuSolutionWriter
+ {
+ private:
+     FILE*             out;      // Destination stream
+     std::vector<char> buffer;   // Pending output
+     size_t            used;     // Bytes pending in the buffer
+
+ public:
+     /* Wraps an already open stream (not closed by the writer) */
+     explicit SudokuSolutionWriter(FILE* out);
+
+     /* Flushes any pending output */
+     ~SudokuSolutionWriter();
+
+     SudokuSolutionWriter(const SudokuSolutionWriter&) = delete;
+     SudokuSolutionWriter& operator=(const SudokuSolutionWriter&) = delete;
+
+     /* Writes the grid as one character per cell ('.' for empty cells,
+      * 'A' onwards for 10 and up) and a newline */
+     template <int Box>
+     void writeGrid(BasicSudokuConstGridView<Box> grid);
+
+     /* 9x9 overload, also taking mutable views */
+     void writeGrid(SudokuConstGridView grid) { writeGrid<3>(grid); }
+
+     /* Writes the text followed by a newline */
+     void writeLine(const char* text, size_t length);
+
+     /* Writes everything buffered so far. Throws SudokuBatchWriteException */
+     void flush(void);
+ };
+
+ /*==============================================================================
+  *  FUNCTION DECLARATIONS
+  *============================================================================*/
+
+ /* Parses a puzzle line of CELLS characters (81 for 9x9): '1'-'9', then
+  * 'A'-'Z' (or lower case) for 10 and up, '.' or '0' for blanks. Anything
+  * after the last cell must be separated by whitespace, ',' or ';'.
+  * Instantiated for box sizes 2 to 5. */
+ template <int Box>
+ bool parsePuzzleLine(const char* line, size_t length, BasicSudokuGridView<Box> grid);
+
+ /* Solves every puzzle from the reader and writes one output line per input
+  * line: the solution, "unsolvable" or "invalid". With requireUnique, puzzles
+  * with more than one solution produce "multiple" instead of a solution.
+  * 'engine' picks the solver backend (9x9 only) and 'box' the board size,
+  * 2 to 5 for 4x4 up to 25x25. With a stats writer the bitmask solver
+  * collects SudokuSolveStats: one JSON object per input line goes to it,
+  * followed by a summary object for the whole run. */
+ SudokuBatchStats runSolveBatch(SudokuPuzzleReader& reader, SudokuSolutionWriter& writer,
+                                bool requireUnique = false,
+                                SudokuEngineKind engine = SudokuEngineKind::Bitmask,
+                                int box = 3, SudokuSolutionWriter* statsWriter = nullptr);
+
+ /* Same output as runSolveBatch, but blocks of puzzles are solved on a
+  * work-stealing pool (0 threads = one per hardware thread). Each worker owns
+  * its solver; blocks are written back in input order. */
+ SudokuBatchStats runParallelSolveBatch(SudokuPuzzleReader& reader, SudokuSolutionWriter& writer,
+                                        unsigned int threadCount, bool requireUnique = false,
+                                        SudokuEngineKind engine = SudokuEngineKind::Bitmask,
+                                        int box = 3, SudokuSolutionWriter* statsWriter = nullptr);
+
+ /* Checks every line as a finished 9x9 grid and writes "valid" or "invalid"
+  * for each. Grids are validated in blocks through validateSudokuSolutions,
+  * so the SIMD kernels see 16 grids at a time. */
+ SudokuBatchStats runVerifyBatch(SudokuPuzzleReader& reader, SudokuSolutionWriter& writer);
+
+ /* Solves the file with 1, 2, 4, ... up to maxThreads workers, discarding the
+  * solutions, and prints puzzles/sec and speedup for each run to 'report' */
+ void reportBatchScaling(const char* path, unsigned int maxThreads, FILE* report,
+                         SudokuEngineKind engine = SudokuEngineKind::Bitmask, int box = 3);
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
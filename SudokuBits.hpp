@@ -0,0 +1,88 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuBits
+ *  FILE         : SudokuBits.hpp
+ *  DESCRIPTION  : Small bit manipulation helpers shared by the solver engines.
+ *                 Candidate sets are stored as masks where bit (d-1) marks
+ *                 digit d.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #ifdef _MSC_VER
+ #include <intrin.h>
+ #endif
+
+ /*==============================================================================
+  *  FUNCTION DEFINITIONS
+  *============================================================================*/
+
+ /* Returns the number of set bits in the mask */
+ inline int sudokuPopcount(unsigned int mask)
+ {
+ #ifdef _MSC_VER
+     return static_cast<int>(__popcnt(mask));
+ #else
+     return __builtin_popcount(mask);
+ #endif
+ }
+
+ /* Returns the number of set bits in a 64-bit mask */
+ inline int sudokuPopcount64(unsigned long long mask)
+ {
+ #ifdef _MSC_VER
+     return static_cast<int>(__popcnt64(mask));
+ #else
+     return __builtin_popcountll(mask);
+ #endif
+ }
+
+ /* Returns the index of the lowest set bit (mask must not be zero) */
+ inline int sudokuCtz(unsigned int mask)
+ {
+ #ifdef _MSC_VER
+     unsigned long index;
+     _BitScanForward(&index, mask);
+     return static_cast<int>(index);
+ #else
+     return __builtin_ctz(mask);
+ #endif
+ }
+
+ /* Returns the index of the lowest set bit of a 64-bit mask (mask must not be zero) */
+ inline int sudokuCtz64(unsigned long long mask)
+ {
+ #ifdef _MSC_VER
+     unsigned long index;
+     _BitScanForward64(&index, mask);
+     return static_cast<int>(index);
+ #else
+     return __builtin_ctzll(mask);
+ #endif
+ }
+
+ /* Returns the index of the highest set bit of a 64-bit mask (mask must not be zero) */
+ inline int sudokuMsb64(unsigned long long mask)
+ {
+ #ifdef _MSC_VER
+     unsigned long index;
+     _BitScanReverse64(&index, mask);
+     return static_cast<int>(index);
+ #else
+     return 63 - __builtin_clzll(mask);
+ #endif
+ }
+
+ /* Returns true if exactly one bit is set in the mask */
+ inline bool sudokuIsSingleBit(unsigned int mask)
+ {
+     return mask && !(mask & (mask - 1));
+ }
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
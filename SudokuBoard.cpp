@@ -14,6 +14,8 @@
 #include "SudokuBoard.hpp"
 #include <iostream>
 #include <exception>
+#include <cstring>
+#include <string>
 
 /*==============================================================================
  *  EXCEPTION DEFINITIONS
@@ -25,7 +27,7 @@ const char* SudokuBoardException::what() const noexcept
     return "Invalid Board Exception.";
 }
 
-/* Thrown when cell position is outside 1-9 range */
+/* Thrown when cell position is outside the 1-SIZE range */
 const char* SudokuBoardOutOfBoundsException::what() const noexcept 
 {
     return "Invalid Move (Out of Bounds Exception).";
@@ -54,67 +56,96 @@ const char* SudokuBoardNotEmptyBlockException::what() const noexcept
  *============================================================================*/
 
 /*
- * Constructor: Initializes the Sudoku board with a preset puzzle
+ * Constructor: Initializes an empty board
  */
-SudokuBoard::SudokuBoard()
+template <int Box>
+BasicSudokuBoard<Box>::BasicSudokuBoard()
 {
-    board = {
-        {5,3,0, 0,7,0, 0,0,0},
-        {6,0,0, 1,9,5, 0,0,0},
-        {0,9,8, 0,0,0, 0,6,0},
-        
-        {8,0,0, 0,6,0, 0,0,3},
-        {4,0,0, 8,0,3, 0,0,1},
-        {7,0,0, 0,2,0, 0,0,6},
-        
-        {0,6,0, 0,0,0, 2,8,0},
-        {0,0,0, 4,1,9, 0,0,5},
-        {0,0,0, 0,8,0, 0,7,9}
+    std::memset(board, 0, sizeof(board));
+    BasicSudokuBoard::recountMasks();
+}
+
+/*
+ * Constructor: Initializes the 9x9 board with a preset puzzle
+ */
+template <>
+BasicSudokuBoard<3>::BasicSudokuBoard()
+{
+    static const uint8_t PRESET[81] = {
+        5,3,0, 0,7,0, 0,0,0,
+        6,0,0, 1,9,5, 0,0,0,
+        0,9,8, 0,0,0, 0,6,0,
+
+        8,0,0, 0,6,0, 0,0,3,
+        4,0,0, 8,0,3, 0,0,1,
+        7,0,0, 0,2,0, 0,0,6,
+
+        0,6,0, 0,0,0, 2,8,0,
+        0,0,0, 4,1,9, 0,0,5,
+        0,0,0, 0,8,0, 0,7,9
     };
+    std::memcpy(board, PRESET, sizeof(board));
+    BasicSudokuBoard::recountMasks();
 }
 
 /*
  * Prints the Sudoku board to the console
  */
-void SudokuBoard::printBoard(void) const
+template <int Box>
+void BasicSudokuBoard<Box>::printBoard(void) const
 {
-    for(int outerLoopIndex = 0; outerLoopIndex < board.size(); outerLoopIndex++)
+    BasicSudokuBoard::printBoard(std::cout);
+}
+
+/*
+ * Prints the Sudoku board to a stream
+ */
+template <int Box>
+void BasicSudokuBoard<Box>::printBoard(std::ostream& out) const
+{
+    for(int outerLoopIndex = 0; outerLoopIndex < SIZE; outerLoopIndex++)
     {
-        if(outerLoopIndex % 3 == 0)
+        if(outerLoopIndex % Box == 0)
         {
-            std::cout << std::endl << "-------------------------------------" << std::endl;
+            out << std::endl << std::string(SIZE * 4 + 1, '-') << std::endl;
         }
         else
         {
-            std::cout << std::endl;
+            out << std::endl;
         }
 
-        for(int innerLoopIndex = 0; innerLoopIndex < board[outerLoopIndex].size(); innerLoopIndex++)
+        for(int innerLoopIndex = 0; innerLoopIndex < SIZE; innerLoopIndex++)
         {
-            if(board[outerLoopIndex][innerLoopIndex])
+            int value = board[outerLoopIndex * SIZE + innerLoopIndex];
+            if(value > 9)
+            {
+                out << static_cast<char>('A' + value - 10) << " ";
+            }
+            else if(value)
             {
-                std::cout << board[outerLoopIndex][innerLoopIndex] << " ";
+                out << value << " ";
             }
             else
             {
-                std::cout << "." << " ";
+                out << "." << " ";
             }
-            if((innerLoopIndex + 1) % 3 == 0)
+            if((innerLoopIndex + 1) % Box == 0)
             {
-                std:: cout << " |";
+                out << " |";
             }
         } 
     }
-    std::cout << std::endl;
+    out << std::endl;
 }
 
 /*
- * Validates if row and column are within [1-9] bounds
+ * Validates if row and column are within [1-SIZE] bounds
  */
-bool SudokuBoard::isInBound(int row, int col) const
+template <int Box>
+bool BasicSudokuBoard<Box>::isInBound(int row, int col) const
 {
-    if( row > 9 || row < 1 || 
-        col > 9 || col < 1)
+    if( row > SIZE || row < 1 || 
+        col > SIZE || col < 1)
    {
        throw SudokuBoardOutOfBoundsException();
    }
@@ -124,11 +155,12 @@ bool SudokuBoard::isInBound(int row, int col) const
 /*
  * Validates if value and cell coordinates are within bounds and cell is empty
  */
-bool SudokuBoard::isValueInBound(int row, int col, int value) const
+template <int Box>
+bool BasicSudokuBoard<Box>::isValueInBound(int row, int col, int value) const
 {
-    if(value > 9 || value < 1 || 
-       !(SudokuBoard::isInBound(row, col)) ||
-       !(SudokuBoard::isCellEmpty(row, col)))
+    if(value > SIZE || value < 1 || 
+       !(BasicSudokuBoard::isInBound(row, col)) ||
+       !(BasicSudokuBoard::isCellEmpty(row, col)))
     {
         throw SudokuBoardValueOutOfBoundsException();
     }
@@ -138,22 +170,25 @@ bool SudokuBoard::isValueInBound(int row, int col, int value) const
 /*
  * Attempts to place a value in the specified cell after validations
  */
-void SudokuBoard::setCell(int row, int col, int value)
+template <int Box>
+void BasicSudokuBoard<Box>::setCell(int row, int col, int value)
 {
-    if(SudokuBoard::isValueInBound(row, col, value) && SudokuBoard::isGameRuleValid(row, col, value))
+    SudokuPlacementStatus status = BasicSudokuBoard::tryPlace(row, col, value);
+    if(status != SudokuPlacementStatus::Ok)
     {
-        board[row-1][col-1] = value;
+        throwPlacementError(status);
     }
 }
 
 /*
  * Retrieves the value at a specific board cell
  */
-int SudokuBoard::getCell(int row, int col) const
+template <int Box>
+int BasicSudokuBoard<Box>::getCell(int row, int col) const
 {
-    if(SudokuBoard::isInBound(row, col))
+    if(BasicSudokuBoard::isInBound(row, col))
     {
-        return board[row-1][col-1];
+        return board[(row-1) * SIZE + (col-1)];
     }
     return -1;
 }
@@ -161,9 +196,10 @@ int SudokuBoard::getCell(int row, int col) const
 /*
  * Checks whether a cell is empty (contains 0)
  */
-bool SudokuBoard::isCellEmpty(int row, int col) const
+template <int Box>
+bool BasicSudokuBoard<Box>::isCellEmpty(int row, int col) const
 {
-    if(board[row-1][col-1])
+    if(board[(row-1) * SIZE + (col-1)])
     {
         throw SudokuBoardNotEmptyBlockException();
     }
@@ -173,60 +209,392 @@ bool SudokuBoard::isCellEmpty(int row, int col) const
 /*
  * Ensures that placing a value does not violate Sudoku rules
  */
-bool SudokuBoard::isGameRuleValid(int row, int col, int value) const
+template <int Box>
+bool BasicSudokuBoard<Box>::isGameRuleValid(int row, int col, int value) const
+{
+    SudokuPlacementStatus status = BasicSudokuBoard::checkPlacement(row, col, value);
+    if(status != SudokuPlacementStatus::Ok)
+    {
+        throwPlacementError(status);
+    }
+    return true;
+}
+
+/*
+ * Non-throwing placement check: one lookup in the row, column and box masks
+ */
+template <int Box>
+SudokuPlacementStatus BasicSudokuBoard<Box>::checkPlacement(int row, int col, int value) const noexcept
 {
-    SudokuBoard::isValueInBound(row, col, value);
+    if(value > SIZE || value < 1)
+    {
+        return SudokuPlacementStatus::ValueOutOfBounds;
+    }
+    if(row > SIZE || row < 1 || col > SIZE || col < 1)
+    {
+        return SudokuPlacementStatus::OutOfBounds;
+    }
 
-    int startRow = row - row % 3;
-    int startCol = col - col % 3;
+    int rowIndex = row - 1;
+    int colIndex = col - 1;
+    int boxIndex = (rowIndex / Box) * Box + colIndex / Box;
 
-    // Check 3x3 subgrid
-    for (int outerLoopIndex = 0; outerLoopIndex < 3; outerLoopIndex++)
+    if(board[rowIndex * SIZE + colIndex])
     {
-        for (int innerLoopIndex = 0; innerLoopIndex < 3; innerLoopIndex++)
+        return SudokuPlacementStatus::CellNotEmpty;
+    }
+    if((rowMask[rowIndex] | colMask[colIndex] | boxMask[boxIndex]) & (1u << (value - 1)))
+    {
+        return SudokuPlacementStatus::GameRuleViolation;
+    }
+    return SudokuPlacementStatus::Ok;
+}
+
+/*
+ * Places the value when the check passes
+ */
+template <int Box>
+SudokuPlacementStatus BasicSudokuBoard<Box>::tryPlace(int row, int col, int value) noexcept
+{
+    SudokuPlacementStatus status = BasicSudokuBoard::checkPlacement(row, col, value);
+    if(status == SudokuPlacementStatus::Ok)
+    {
+        Mask bit = static_cast<Mask>(1u << (value - 1));
+        int rowIndex = row - 1;
+        int colIndex = col - 1;
+
+        board[rowIndex * SIZE + colIndex] = static_cast<uint8_t>(value);
+        rowMask[rowIndex] |= bit;
+        colMask[colIndex] |= bit;
+        boxMask[(rowIndex / Box) * Box + colIndex / Box] |= bit;
+        filledCount++;
+        history.record(rowIndex * SIZE + colIndex, 0, value);
+    }
+    return status;
+}
+
+/*
+ * Empties a cell, throwing on out-of-bounds coordinates
+ */
+template <int Box>
+void BasicSudokuBoard<Box>::clearCell(int row, int col)
+{
+    SudokuPlacementStatus status = BasicSudokuBoard::tryClear(row, col);
+    if(status != SudokuPlacementStatus::Ok)
+    {
+        throwPlacementError(status);
+    }
+}
+
+/*
+ * Empties a cell and drops its digit from the masks
+ */
+template <int Box>
+SudokuPlacementStatus BasicSudokuBoard<Box>::tryClear(int row, int col) noexcept
+{
+    if(row > SIZE || row < 1 || col > SIZE || col < 1)
+    {
+        return SudokuPlacementStatus::OutOfBounds;
+    }
+
+    int rowIndex = row - 1;
+    int colIndex = col - 1;
+    int value = board[rowIndex * SIZE + colIndex];
+
+    if(value == 0)
+    {
+        return SudokuPlacementStatus::Ok;
+    }
+
+    board[rowIndex * SIZE + colIndex] = 0;
+    history.record(rowIndex * SIZE + colIndex, value, 0);
+    if(!consistent)
+    {
+        // A repeated digit shares its mask bit, so recount from the cells
+        BasicSudokuBoard::recountMasks();
+        return SudokuPlacementStatus::Ok;
+    }
+
+    Mask bit = static_cast<Mask>(~(1u << (value - 1)));
+    rowMask[rowIndex] &= bit;
+    colMask[colIndex] &= bit;
+    boxMask[(rowIndex / Box) * Box + colIndex / Box] &= bit;
+    filledCount--;
+    return SudokuPlacementStatus::Ok;
+}
+
+/*
+ * Full and conflict-free
+ */
+template <int Box>
+bool BasicSudokuBoard<Box>::isSolved(void) const noexcept
+{
+    return filledCount == CELLS && consistent;
+}
+
+/*
+ * Tracked by every write and recount
+ */
+template <int Box>
+bool BasicSudokuBoard<Box>::isConsistent(void) const noexcept
+{
+    return consistent;
+}
+
+/*
+ * Digits not yet used in the cell's row, column or box
+ */
+template <int Box>
+typename BasicSudokuBoard<Box>::Mask BasicSudokuBoard<Box>::candidates(int row, int col) const noexcept
+{
+    if(row > SIZE || row < 1 || col > SIZE || col < 1)
+    {
+        return 0;
+    }
+
+    int rowIndex = row - 1;
+    int colIndex = col - 1;
+
+    if(board[rowIndex * SIZE + colIndex])
+    {
+        return 0;
+    }
+    return static_cast<Mask>(~(rowMask[rowIndex] | colMask[colIndex] |
+                               boxMask[(rowIndex / Box) * Box + colIndex / Box]) & Dimensions::ALL_DIGITS);
+}
+
+/*
+ * Reverts the newest recorded move
+ */
+template <int Box>
+int BasicSudokuBoard<Box>::undoMove(void) noexcept
+{
+    if(!history.canUndo())
+    {
+        return -1;
+    }
+    const SudokuTrailEntry& entry = history.undo();
+    BasicSudokuBoard::writeCell(entry.cell, entry.before);
+    return entry.cell;
+}
+
+/*
+ * Reapplies the oldest undone move
+ */
+template <int Box>
+int BasicSudokuBoard<Box>::redoMove(void) noexcept
+{
+    if(!history.canRedo())
+    {
+        return -1;
+    }
+    const SudokuTrailEntry& entry = history.redo();
+    BasicSudokuBoard::writeCell(entry.cell, entry.after);
+    return entry.cell;
+}
+
+/*
+ * True while there is a move to take back
+ */
+template <int Box>
+bool BasicSudokuBoard<Box>::canUndo(void) const noexcept
+{
+    return history.canUndo();
+}
+
+/*
+ * True while there is an undone move to replay
+ */
+template <int Box>
+bool BasicSudokuBoard<Box>::canRedo(void) const noexcept
+{
+    return history.canRedo();
+}
+
+/*
+ * Recounts the masks after a bulk write; the old moves no longer apply
+ */
+template <int Box>
+void BasicSudokuBoard<Box>::rebuildMasks(void) noexcept
+{
+    BasicSudokuBoard::recountMasks();
+    history.clear();
+}
+
+/*
+ * Fills the empty cells one by one through writeCell, like moves that are not
+ * recorded
+ */
+template <int Box>
+void BasicSudokuBoard<Box>::fillEmptyCells(BasicSudokuConstGridView<Box> solution) noexcept
+{
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        if(board[cell] == 0)
         {
-            if (board[startRow + outerLoopIndex][startCol + innerLoopIndex] == value)
-            {
-                throw SudokuBoardGameRuleException();
-            }
+            BasicSudokuBoard::writeCell(cell, solution.data()[cell]);
         }
     }
+    history.dropRedo();
+}
+
+/*
+ * Swaps one cell's value in and out of its row, column and box masks. Moves
+ * are undone newest first, so a restored digit never clashes on a consistent
+ * board; an inconsistent one is recounted instead.
+ */
+template <int Box>
+void BasicSudokuBoard<Box>::writeCell(int cell, int value) noexcept
+{
+    int old = board[cell];
+
+    board[cell] = static_cast<uint8_t>(value);
+    if(!consistent)
+    {
+        BasicSudokuBoard::recountMasks();
+        return;
+    }
+
+    int rowIndex = cell / SIZE;
+    int colIndex = cell % SIZE;
+    int boxIndex = (rowIndex / Box) * Box + colIndex / Box;
 
-    // Check column
-    for (int rowLoopIndex = 0; rowLoopIndex < board.size(); rowLoopIndex++)
+    if(old)
+    {
+        Mask bit = static_cast<Mask>(~(1u << (old - 1)));
+        rowMask[rowIndex] &= bit;
+        colMask[colIndex] &= bit;
+        boxMask[boxIndex] &= bit;
+        filledCount--;
+    }
+    if(value)
     {
-        if (board[rowLoopIndex][col-1] == value)
+        Mask bit = static_cast<Mask>(1u << (value - 1));
+        if((rowMask[rowIndex] | colMask[colIndex] | boxMask[boxIndex]) & bit)
         {
-            throw SudokuBoardGameRuleException();
+            consistent = false;
         }
+        rowMask[rowIndex] |= bit;
+        colMask[colIndex] |= bit;
+        boxMask[boxIndex] |= bit;
+        filledCount++;
     }
+}
 
-    // Check row
-    for (int colLoopIndex = 0; colLoopIndex < board.size(); colLoopIndex++)
+/*
+ * Recomputes masks, filled count and the consistency flag from the cells
+ */
+template <int Box>
+void BasicSudokuBoard<Box>::recountMasks(void) noexcept
+{
+    std::memset(rowMask, 0, sizeof(rowMask));
+    std::memset(colMask, 0, sizeof(colMask));
+    std::memset(boxMask, 0, sizeof(boxMask));
+    filledCount = 0;
+    consistent = true;
+
+    for (int cell = 0; cell < CELLS; cell++)
     {
-        if (board[row-1][colLoopIndex] == value)
+        int value = board[cell];
+        if (value == 0)
         {
-            throw SudokuBoardGameRuleException();
+            continue;
         }
+        filledCount++;
+        if (value > SIZE)
+        {
+            consistent = false;
+            continue;
+        }
+
+        int rowIndex = cell / SIZE;
+        int colIndex = cell % SIZE;
+        int boxIndex = (rowIndex / Box) * Box + colIndex / Box;
+        Mask bit = static_cast<Mask>(1u << (value - 1));
+
+        if ((rowMask[rowIndex] | colMask[colIndex] | boxMask[boxIndex]) & bit)
+        {
+            consistent = false;
+        }
+        rowMask[rowIndex] |= bit;
+        colMask[colIndex] |= bit;
+        boxMask[boxIndex] |= bit;
     }
+}
 
-    return true;
+/*
+ * Maps a failed placement status to the matching board exception
+ */
+template <int Box>
+void BasicSudokuBoard<Box>::throwPlacementError(SudokuPlacementStatus status)
+{
+    switch(status)
+    {
+        case SudokuPlacementStatus::OutOfBounds:
+            throw SudokuBoardOutOfBoundsException();
+        case SudokuPlacementStatus::ValueOutOfBounds:
+            throw SudokuBoardValueOutOfBoundsException();
+        case SudokuPlacementStatus::CellNotEmpty:
+            throw SudokuBoardNotEmptyBlockException();
+        case SudokuPlacementStatus::GameRuleViolation:
+            throw SudokuBoardGameRuleException();
+        case SudokuPlacementStatus::GivenCell:
+            throw SudokuBoardException();
+        case SudokuPlacementStatus::Ok:
+            break;
+    }
+}
+
+/*
+ * Returns a mutable view of the board cells
+ */
+template <int Box>
+BasicSudokuGridView<Box> BasicSudokuBoard<Box>::view(void)
+{
+    return BasicSudokuGridView<Box>(board);
+}
+
+/*
+ * Returns a read-only view of the board cells
+ */
+template <int Box>
+BasicSudokuConstGridView<Box> BasicSudokuBoard<Box>::view(void) const
+{
+    return BasicSudokuConstGridView<Box>(board);
 }
 
 /*
- * Returns the full board matrix
+ * Returns the full board matrix (compatibility shim, allocates)
  */
-std::vector<std::vector<int>> SudokuBoard::getMatrix() const {
-    return board;
+template <int Box>
+std::vector<std::vector<int>> BasicSudokuBoard<Box>::getMatrix() const {
+    std::vector<std::vector<int>> mat(SIZE, std::vector<int>(SIZE));
+    for (int cell = 0; cell < CELLS; cell++) {
+        mat[cell / SIZE][cell % SIZE] = board[cell];
+    }
+    return mat;
 }
 
 /*
- * Sets the full board matrix (used by solver)
+ * Sets the full board matrix (compatibility shim)
  */
-void SudokuBoard::setMatrix(const std::vector<std::vector<int>>& mat) {
-    board = mat;
+template <int Box>
+void BasicSudokuBoard<Box>::setMatrix(const std::vector<std::vector<int>>& mat) {
+    for (int cell = 0; cell < CELLS; cell++) {
+        board[cell] = static_cast<uint8_t>(mat[cell / SIZE][cell % SIZE]);
+    }
+    BasicSudokuBoard::rebuildMasks();
 }
 
+/*==============================================================================
+ *  EXPLICIT INSTANTIATIONS
+ *============================================================================*/
+
+template class BasicSudokuBoard<2>;
+template class BasicSudokuBoard<3>;
+template class BasicSudokuBoard<4>;
+template class BasicSudokuBoard<5>;
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
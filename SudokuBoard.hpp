@@ -1,14 +1,19 @@
 /******************************************************************************
  *  MODULE NAME  : Sudoku Board
  *  FILE         : SudokuBoard.hpp
- *  DESCRIPTION  : This file defines the SudokuBoard class, which represents
- *                 the 9x9 Sudoku board, along with custom exceptions for board
+ *  DESCRIPTION  : This file defines the BasicSudokuBoard class template, which
+ *                 represents a Sudoku board of any box size (SudokuBoard is
+ *                 the 9x9 board), along with custom exceptions for board
  *                 validation and manipulation.
  *  AUTHOR       : Hassan Darwish
  *  DATE CREATED : April 2025
  ******************************************************************************/
 
  #pragma once
+ #include "SudokuTrail.hpp"
+ #include <cstdint>
+ #include <iosfwd>
+ #include <type_traits>
  #include <vector>
  
  /*==============================================================================
@@ -52,7 +57,7 @@
  };
  
  /*
-  * Exception thrown when an invalid value (not between 1 and 9) is attempted to be inserted
+  * Exception thrown when an invalid value (not between 1 and the board size) is attempted to be inserted
   */
  class SudokuBoardValueOutOfBoundsException : public SudokuBoardException
  {
@@ -76,36 +81,168 @@
  };
  
  /*==============================================================================
-  *  MAIN CLASS: SudokuBoard
+  *  PLACEMENT STATUS
+  *============================================================================*/
+
+ /*
+  * Result of a non-throwing placement check. Every value the board returns
+  * other than Ok maps to the exception setCell throws for the same input.
+  */
+ enum class SudokuPlacementStatus : uint8_t
+ {
+     Ok,
+     OutOfBounds,         // SudokuBoardOutOfBoundsException
+     ValueOutOfBounds,    // SudokuBoardValueOutOfBoundsException
+     CellNotEmpty,        // SudokuBoardNotEmptyBlockException
+     GameRuleViolation,   // SudokuBoardGameRuleException
+     GivenCell            // Clearing a puzzle given; from SudokuSession, never the board
+ };
+
+ /*==============================================================================
+  *  DIMENSIONS
+  *============================================================================*/
+
+ /*
+  * Compile-time dimensions of a board made of Box x Box boxes: Box = 2 is 4x4,
+  * 3 is the classic 9x9, 4 is 16x16 (hexadoku) and 5 is 25x25. Digit masks
+  * use one bit per digit and stay 16 bits wide up to 16x16.
+  */
+ template <int Box>
+ struct SudokuDimensions
+ {
+     static constexpr int SIZE  = Box * Box;     // Digits, rows, columns and boxes
+     static constexpr int CELLS = SIZE * SIZE;   // Cells on the board
+     static constexpr int UNITS = 3 * SIZE;      // Rows, columns and boxes
+
+     typedef typename std::conditional<(SIZE > 16), uint32_t, uint16_t>::type Mask;
+
+     static constexpr Mask ALL_DIGITS = static_cast<Mask>((1ull << SIZE) - 1);
+ };
+
+ /*==============================================================================
+  *  GRID VIEWS
+  *============================================================================*/
+
+ /*
+  * Non-owning, mutable view of the cells stored row-major (index = row * SIZE
+  * + col, zero-based). Values are 0 for empty cells and 1-SIZE otherwise. The
+  * view does no validation; it is the zero-copy surface used by the solver.
+  */
+ template <int Box>
+ class BasicSudokuGridView
+ {
+ private:
+     uint8_t* cells;   // First of CELLS contiguous cells
+
+ public:
+     static constexpr int SIZE = SudokuDimensions<Box>::SIZE;
+
+     explicit BasicSudokuGridView(uint8_t* cells) : cells(cells) {}
+
+     uint8_t& operator[](int index) const { return cells[index]; }
+     uint8_t& at(int row, int col) const { return cells[row * SIZE + col]; }
+     uint8_t* data(void) const { return cells; }
+ };
+
+ /*
+  * Read-only counterpart of BasicSudokuGridView
+  */
+ template <int Box>
+ class BasicSudokuConstGridView
+ {
+ private:
+     const uint8_t* cells;   // First of CELLS contiguous cells
+
+ public:
+     static constexpr int SIZE = SudokuDimensions<Box>::SIZE;
+
+     explicit BasicSudokuConstGridView(const uint8_t* cells) : cells(cells) {}
+     BasicSudokuConstGridView(BasicSudokuGridView<Box> grid) : cells(grid.data()) {}
+
+     uint8_t operator[](int index) const { return cells[index]; }
+     uint8_t at(int row, int col) const { return cells[row * SIZE + col]; }
+     const uint8_t* data(void) const { return cells; }
+ };
+
+ /* The classic 9x9 views */
+ typedef BasicSudokuGridView<3>      SudokuGridView;
+ typedef BasicSudokuConstGridView<3> SudokuConstGridView;
+
+ /*==============================================================================
+  *  MAIN CLASS: BasicSudokuBoard
   *============================================================================*/
  
  /*
-  * SudokuBoard class represents a 9x9 Sudoku board and provides methods for
-  * board manipulation, validation, and game rule checking.
+  * BasicSudokuBoard represents a SIZE x SIZE Sudoku board and provides methods
+  * for board manipulation, validation, and game rule checking. Rows, columns
+  * and values are 1-based in the public API. Defined in SudokuBoard.cpp and
+  * instantiated there for box sizes 2 to 5; SudokuBoard is the 9x9 board.
   */
- class SudokuBoard
+ template <int Box>
+ class BasicSudokuBoard
  {
+ public:
+     typedef SudokuDimensions<Box>          Dimensions;
+     typedef typename Dimensions::Mask      Mask;
+
+     static constexpr int SIZE  = Dimensions::SIZE;
+     static constexpr int CELLS = Dimensions::CELLS;
+
+     /* Moves kept for undo; older ones are forgotten (4 bytes per move) */
+     static constexpr int HISTORY_MOVES = 64;
+
  private:
-     std::vector<std::vector<int>> board;  // 9x9 Sudoku board matrix
+     alignas(64) uint8_t board[CELLS];  // Board cells, row-major
+     Mask     rowMask[SIZE];            // Digits present in each row (bit d-1 for digit d)
+     Mask     colMask[SIZE];            // Digits present in each column
+     Mask     boxMask[SIZE];            // Digits present in each box
+     int      filledCount;              // Non-empty cells
+     bool     consistent;               // False if the cells repeat a digit in a unit
+     SudokuTrail<HISTORY_MOVES> history;   // Moves made through the checked setters
+
+     /*
+      *  Description: Writes a value (0 to empty) into a cell and updates the
+      *               masks for the old and new value
+      */
+     void writeCell(int cell, int value) noexcept;
+
+     /*
+      *  Description: Recomputes the masks, filled count and consistency flag
+      *               from the cells, keeping the move history
+      */
+     void recountMasks(void) noexcept;
  
  public:
      /*
-      *  Constructor: Initializes the Sudoku board with a preset puzzle
+      *  Constructor: Initializes the board. The 9x9 board starts with a preset
+      *               puzzle, the other sizes start empty.
       */
-     SudokuBoard();
+     BasicSudokuBoard();
+
+     /*
+      *  Description: Throws the exception matching a failed placement status
+      *               (does nothing for Ok)
+      */
+     static void throwPlacementError(SudokuPlacementStatus status);
  
      /*
-      *  Description: Prints the current 9x9 Sudoku board to the console
+      *  Description: Prints the current board to the console (digits above 9
+      *               are shown as letters, A = 10)
       */
      void printBoard(void) const;
+
+     /*
+      *  Description: Prints the current board to the given stream
+      */
+     void printBoard(std::ostream& out) const;
  
      /*
-      *  Description: Validates if the given row and column are within the 1-9 bounds
+      *  Description: Validates if the given row and column are within the 1-SIZE bounds
       */
      bool isInBound(int row, int col) const;
  
      /*
-      *  Description: Validates if the given value is within 1-9 bounds and
+      *  Description: Validates if the given value is within 1-SIZE bounds and
       *               ensures the cell is empty
       */
      bool isValueInBound(int row, int col, int value) const;
@@ -129,19 +266,121 @@
       *  Description: Validates if placing the value at (row, col) is allowed by Sudoku rules
       */
      bool isGameRuleValid(int row, int col, int value) const;
+
+     /*
+      *  Description: Checks a placement at (row, col) in one pass without
+      *               throwing. Checks run in the same order as setCell: value,
+      *               bounds, empty cell, then row/column/box rules.
+      */
+     SudokuPlacementStatus checkPlacement(int row, int col, int value) const noexcept;
+
+     /*
+      *  Description: Places the value if checkPlacement accepts it and returns
+      *               the status either way
+      */
+     SudokuPlacementStatus tryPlace(int row, int col, int value) noexcept;
+
+     /*
+      *  Description: Empties the cell at (row, col); throws on out-of-bounds
+      */
+     void clearCell(int row, int col);
+
+     /*
+      *  Description: Empties the cell at (row, col) without throwing. Returns
+      *               OutOfBounds or Ok (also when the cell was already empty).
+      */
+     SudokuPlacementStatus tryClear(int row, int col) noexcept;
+
+     /*
+      *  Description: Returns true if every cell is filled and no unit repeats a digit
+      */
+     bool isSolved(void) const noexcept;
+
+     /*
+      *  Description: Returns true if no unit repeats a digit and every value
+      *               is in range
+      */
+     bool isConsistent(void) const noexcept;
+
+     /*
+      *  Description: Returns the digits that can go in (row, col) as a mask
+      *               (bit d-1 for digit d), 0 if the cell is filled or out of bounds
+      */
+     Mask candidates(int row, int col) const noexcept;
+
+     /*
+      *  Description: Takes back the last move made through setCell, tryPlace,
+      *               clearCell or tryClear in O(1), masks included. Returns the
+      *               cell index (row-major, zero-based), or -1 if there is
+      *               nothing to undo.
+      */
+     int undoMove(void) noexcept;
+
+     /*
+      *  Description: Makes the last undone move again. Returns its cell index,
+      *               or -1 if there is nothing to redo; any new move discards
+      *               the moves that could have been redone.
+      */
+     int redoMove(void) noexcept;
+
+     /*
+      *  Description: Returns true if undoMove() / redoMove() would change the board
+      */
+     bool canUndo(void) const noexcept;
+     bool canRedo(void) const noexcept;
+
+     /*
+      *  Description: Recomputes the occupancy masks and the filled count from
+      *               the cells. Call after writing cells through view(); this
+      *               also forgets the move history.
+      */
+     void rebuildMasks(void) noexcept;
+
+     /*
+      *  Description: Writes the solution into the empty cells, masks
+      *               included. Filled cells are left alone, so the moves that
+      *               can be undone stay undoable; moves that could have been
+      *               redone are dropped.
+      */
+     void fillEmptyCells(BasicSudokuConstGridView<Box> solution) noexcept;
  
      /*
-      *  Description: Returns the current 9x9 board as a matrix (vector of vectors)
+      *  Description: Returns a mutable view of the cells (no copy, no
+      *               validation). Call rebuildMasks() after writing through it.
+      */
+     BasicSudokuGridView<Box> view(void);
+
+     /*
+      *  Description: Returns a read-only view of the cells
+      */
+     BasicSudokuConstGridView<Box> view(void) const;
+
+     /*
+      *  Description: Returns the current board as a matrix (vector of vectors).
+      *               Compatibility shim; prefer view().
       */
      std::vector<std::vector<int>> getMatrix() const;
  
      /*
-      *  Description: Sets the board to the provided matrix
+      *  Description: Sets the board to the provided matrix. Compatibility shim;
+      *               prefer view().
       */
      void setMatrix(const std::vector<std::vector<int>>& mat);
  };
+
+ /* 9x9 boards start from the preset puzzle */
+ template <>
+ BasicSudokuBoard<3>::BasicSudokuBoard();
+
+ extern template class BasicSudokuBoard<2>;
+ extern template class BasicSudokuBoard<3>;
+ extern template class BasicSudokuBoard<4>;
+ extern template class BasicSudokuBoard<5>;
+
+ /* The classic 9x9 board */
+ typedef BasicSudokuBoard<3> SudokuBoard;
  
  /******************************************************************************
   *  END OF FILE
   ******************************************************************************/
- 
\ No newline at end of file
+ 
\ No newline at end of file
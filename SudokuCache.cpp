@@ -0,0 +1,380 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuCache
+ *  FILE         : SudokuCache.cpp
+ *  DESCRIPTION  : Implements the set-associative CLOCK solution cache, its
+ *                 file format and the cached solve path.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuCache.hpp"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/*==============================================================================
+ *  CONSTANTS
+ *============================================================================*/
+
+namespace
+{
+    const uint8_t ENTRY_VALID      = 0x01;   // Way holds a puzzle
+    const uint8_t ENTRY_SOLVABLE   = 0x02;   // Solution is meaningful
+    const uint8_t ENTRY_REFERENCED = 0x04;   // Read since the CLOCK hand last passed
+
+    /*
+     * File layout: the magic, the entry count as a little-endian 64-bit
+     * integer, then per entry the 81 puzzle cells, the 81 solution cells and
+     * one byte that is 1 if the puzzle is solvable.
+     */
+    const char   FILE_MAGIC[8]     = { 'S', 'U', 'D', 'O', 'K', 'U', 'C', '1' };
+    const size_t FILE_HEADER_SIZE  = 16;
+    const size_t FILE_RECORD_SIZE  = 81 + 81 + 1;
+    const size_t FILE_BATCH        = 4096;   // Records per read or write
+
+    /* Smallest power of two not below 'value' */
+    size_t roundUpPow2(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+}
+
+/*==============================================================================
+ *  EXCEPTION DEFINITIONS
+ *============================================================================*/
+
+/* Returns generic cache error message */
+const char* SudokuCacheException::what() const noexcept
+{
+    return "Cache Error.";
+}
+
+/* Returns error message for a file that is not a cache */
+const char* SudokuCacheFormatException::what() const noexcept
+{
+    return "Cache Error (Bad File Format).";
+}
+
+/* Returns error message for a failed save */
+const char* SudokuCacheWriteException::what() const noexcept
+{
+    return "Cache Error (Cannot Write File).";
+}
+
+/*==============================================================================
+ *  SudokuSolutionCache
+ *============================================================================*/
+
+/* Allocates zeroed sets and the shard locks */
+SudokuSolutionCache::SudokuSolutionCache(size_t capacity)
+{
+    size_t setCount = roundUpPow2((capacity + SUDOKU_CACHE_WAYS - 1) / SUDOKU_CACHE_WAYS);
+
+    sets.reset(new Set[setCount]());
+    setMask = setCount - 1;
+    shards.reset(new Shard[SUDOKU_CACHE_SHARDS]());
+}
+
+/* Probes the puzzle's set under its shard lock */
+bool SudokuSolutionCache::lookup(SudokuConstGridView puzzle, SudokuGridView solution, bool& solvable)
+{
+    uint64_t hash = hashSudokuGrid(puzzle);
+    size_t setIndex = static_cast<size_t>(hash) & setMask;
+    Set& set = sets[setIndex];
+    Shard& shard = shards[setIndex % SUDOKU_CACHE_SHARDS];
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    for (Entry& entry : set.ways)
+    {
+        if ((entry.state & ENTRY_VALID) && entry.hash == hash &&
+            std::memcmp(entry.puzzle, puzzle.data(), 81) == 0)
+        {
+            entry.state |= ENTRY_REFERENCED;
+            solvable = (entry.state & ENTRY_SOLVABLE) != 0;
+            if (solvable)
+            {
+                std::memcpy(solution.data(), entry.solution, 81);
+            }
+            shard.hits++;
+            return true;
+        }
+    }
+    shard.misses++;
+    return false;
+}
+
+/* Locks the puzzle's shard and stores the entry */
+void SudokuSolutionCache::insert(SudokuConstGridView puzzle, SudokuConstGridView solution, bool solvable)
+{
+    uint64_t hash = hashSudokuGrid(puzzle);
+    size_t setIndex = static_cast<size_t>(hash) & setMask;
+    Shard& shard = shards[setIndex % SUDOKU_CACHE_SHARDS];
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    store(sets[setIndex], shard, hash, puzzle.data(), solution.data(), solvable);
+}
+
+/* Replaces the puzzle's own entry, else fills a free way, else runs the
+ * CLOCK hand: referenced ways lose their bit, the first unreferenced one
+ * is evicted */
+void SudokuSolutionCache::store(Set& set, Shard& shard, uint64_t hash, const uint8_t* puzzle,
+                                const uint8_t* solution, bool solvable)
+{
+    Entry* target = nullptr;
+
+    for (Entry& entry : set.ways)
+    {
+        if ((entry.state & ENTRY_VALID) && entry.hash == hash && std::memcmp(entry.puzzle, puzzle, 81) == 0)
+        {
+            target = &entry;
+            break;
+        }
+        if (target == nullptr && !(entry.state & ENTRY_VALID))
+        {
+            target = &entry;
+        }
+    }
+
+    if (target == nullptr)
+    {
+        while (set.ways[set.hand].state & ENTRY_REFERENCED)
+        {
+            set.ways[set.hand].state &= static_cast<uint8_t>(~ENTRY_REFERENCED);
+            set.hand = static_cast<uint8_t>((set.hand + 1) % SUDOKU_CACHE_WAYS);
+        }
+        target = &set.ways[set.hand];
+        set.hand = static_cast<uint8_t>((set.hand + 1) % SUDOKU_CACHE_WAYS);
+        shard.evictions++;
+    }
+
+    if (!(target->state & ENTRY_VALID))
+    {
+        shard.entries++;
+    }
+    target->hash = hash;
+    std::memcpy(target->puzzle, puzzle, 81);
+    if (solvable)
+    {
+        std::memcpy(target->solution, solution, 81);
+    }
+    target->state = static_cast<uint8_t>(ENTRY_VALID | (solvable ? ENTRY_SOLVABLE : 0));
+    shard.insertions++;
+}
+
+/* Empties the sets shard by shard, each under its own lock */
+void SudokuSolutionCache::clear(void)
+{
+    for (size_t index = 0; index < SUDOKU_CACHE_SHARDS; index++)
+    {
+        Shard& shard = shards[index];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        for (size_t setIndex = index; setIndex <= setMask; setIndex += SUDOKU_CACHE_SHARDS)
+        {
+            for (Entry& entry : sets[setIndex].ways)
+            {
+                entry.state = 0;
+            }
+            sets[setIndex].hand = 0;
+        }
+        shard.entries = 0;
+    }
+}
+
+/* Adds up the shard counters */
+SudokuCacheStats SudokuSolutionCache::stats(void) const
+{
+    SudokuCacheStats total = {};
+
+    for (size_t index = 0; index < SUDOKU_CACHE_SHARDS; index++)
+    {
+        Shard& shard = shards[index];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        total.hits += shard.hits;
+        total.misses += shard.misses;
+        total.insertions += shard.insertions;
+        total.evictions += shard.evictions;
+        total.entries += shard.entries;
+    }
+    total.capacity = (setMask + 1) * SUDOKU_CACHE_WAYS;
+    return total;
+}
+
+/* Writes the header, then every valid entry set by set */
+void SudokuSolutionCache::save(const char* path) const
+{
+    FILE* out = std::fopen(path, "wb");
+    if (out == nullptr)
+    {
+        throw SudokuCacheWriteException();
+    }
+
+    std::vector<uint8_t> buffer;
+    buffer.reserve(FILE_BATCH * FILE_RECORD_SIZE);
+    buffer.insert(buffer.end(), FILE_MAGIC, FILE_MAGIC + sizeof(FILE_MAGIC));
+    buffer.resize(FILE_HEADER_SIZE);   // Count is filled in at the end
+    uint64_t count = 0;
+    bool failed = false;
+
+    for (size_t setIndex = 0; setIndex <= setMask && !failed; setIndex++)
+    {
+        const Set& set = sets[setIndex];
+        std::lock_guard<std::mutex> guard(shards[setIndex % SUDOKU_CACHE_SHARDS].lock);
+
+        for (const Entry& entry : set.ways)
+        {
+            if (!(entry.state & ENTRY_VALID))
+            {
+                continue;
+            }
+            buffer.insert(buffer.end(), entry.puzzle, entry.puzzle + 81);
+            buffer.insert(buffer.end(), entry.solution, entry.solution + 81);
+            buffer.push_back((entry.state & ENTRY_SOLVABLE) ? 1 : 0);
+            count++;
+        }
+        if (buffer.size() >= FILE_BATCH * FILE_RECORD_SIZE)
+        {
+            failed = std::fwrite(buffer.data(), 1, buffer.size(), out) != buffer.size();
+            buffer.clear();
+        }
+    }
+
+    uint8_t countBytes[8];
+    for (int byte = 0; byte < 8; byte++)
+    {
+        countBytes[byte] = static_cast<uint8_t>(count >> (8 * byte));
+    }
+
+    failed = failed || std::fwrite(buffer.data(), 1, buffer.size(), out) != buffer.size();
+    failed = failed || std::fseek(out, static_cast<long>(sizeof(FILE_MAGIC)), SEEK_SET) != 0;
+    failed = failed || std::fwrite(countBytes, 1, sizeof(countBytes), out) != sizeof(countBytes);
+    failed = (std::fclose(out) != 0) || failed;
+    if (failed)
+    {
+        throw SudokuCacheWriteException();
+    }
+}
+
+/* Reads the header, then inserts the entries in batches */
+bool SudokuSolutionCache::load(const char* path)
+{
+    FILE* in = std::fopen(path, "rb");
+    if (in == nullptr)
+    {
+        return false;
+    }
+
+    uint8_t header[FILE_HEADER_SIZE];
+    if (std::fread(header, 1, sizeof(header), in) != sizeof(header) ||
+        std::memcmp(header, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+    {
+        std::fclose(in);
+        throw SudokuCacheFormatException();
+    }
+
+    uint64_t count = 0;
+    for (int byte = 7; byte >= 0; byte--)
+    {
+        count = (count << 8) | header[sizeof(FILE_MAGIC) + byte];
+    }
+
+    std::vector<uint8_t> buffer(FILE_BATCH * FILE_RECORD_SIZE);
+    while (count > 0)
+    {
+        size_t records = (count < FILE_BATCH) ? static_cast<size_t>(count) : FILE_BATCH;
+        if (std::fread(buffer.data(), FILE_RECORD_SIZE, records, in) != records)
+        {
+            std::fclose(in);
+            throw SudokuCacheFormatException();
+        }
+
+        for (size_t record = 0; record < records; record++)
+        {
+            const uint8_t* data = buffer.data() + record * FILE_RECORD_SIZE;
+            for (size_t cell = 0; cell < 2 * 81; cell++)
+            {
+                if (data[cell] > 9)
+                {
+                    std::fclose(in);
+                    throw SudokuCacheFormatException();
+                }
+            }
+            insert(SudokuConstGridView(data), SudokuConstGridView(data + 81), data[2 * 81] != 0);
+        }
+        count -= records;
+    }
+
+    std::fclose(in);
+    return true;
+}
+
+/*==============================================================================
+ *  SudokuCachedSolver
+ *============================================================================*/
+
+/* Binds the solver to the shared cache */
+SudokuCachedSolver::SudokuCachedSolver(SudokuSolutionCache& cache, bool matchSymmetries)
+    : cache(cache), matchSymmetries(matchSymmetries) {}
+
+/* Exact lookup, canonical lookup, then a solve of the canonical form; without
+ * symmetry matching a miss solves the puzzle itself */
+bool SudokuCachedSolver::solve(SudokuGridView grid)
+{
+    uint8_t puzzle[81];
+    uint8_t canonical[81];
+    bool solvable = false;
+
+    std::memcpy(puzzle, grid.data(), sizeof(puzzle));
+    if (cache.lookup(SudokuConstGridView(puzzle), grid, solvable))
+    {
+        return solvable;
+    }
+
+    if (!matchSymmetries)
+    {
+        solvable = solver.solve(grid);
+        cache.insert(SudokuConstGridView(puzzle), grid, solvable);
+        return solvable;
+    }
+
+    canonicalizer.canonicalize(SudokuConstGridView(puzzle), form);
+    if (!cache.lookup(SudokuConstGridView(form.cells), SudokuGridView(canonical), solvable))
+    {
+        std::memcpy(canonical, form.cells, sizeof(canonical));
+        solvable = solver.solve(SudokuGridView(canonical));
+        cache.insert(SudokuConstGridView(form.cells), SudokuConstGridView(canonical), solvable);
+    }
+
+    if (solvable)
+    {
+        invertSudokuTransform(form.transform, SudokuConstGridView(canonical), grid);
+    }
+    cache.insert(SudokuConstGridView(puzzle), grid, solvable);
+    return solvable;
+}
+
+/* Solves a copy of the board's grid and fills the board in only on success,
+ * keeping its undo history */
+bool SudokuCachedSolver::solve(SudokuBoard& board)
+{
+    uint8_t cells[81];
+
+    std::memcpy(cells, board.view().data(), sizeof(cells));
+    if (!solve(SudokuGridView(cells)))
+    {
+        return false;
+    }
+    board.fillEmptyCells(SudokuConstGridView(cells));
+    return true;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
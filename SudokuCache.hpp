@@ -0,0 +1,199 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuCache
+ *  FILE         : SudokuCache.hpp
+ *  DESCRIPTION  : Bounded, thread-safe cache of 9x9 solutions keyed by puzzle
+ *                 hash, with CLOCK eviction, hit/miss counters and optional
+ *                 persistence to a file. SudokuCachedSolver puts it in front
+ *                 of SudokuSolver and shares entries between puzzles that are
+ *                 equivalent under the Sudoku symmetries.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include "SudokuBoard.hpp"
+ #include "SudokuCanonical.hpp"
+ #include "SudokuSolver.hpp"
+ #include <cstddef>
+ #include <cstdint>
+ #include <memory>
+ #include <mutex>
+
+ /*==============================================================================
+  *  CONSTANTS
+  *============================================================================*/
+
+ const size_t SUDOKU_CACHE_WAYS   = 8;    // Entries per set; a puzzle can only live in its set
+ const size_t SUDOKU_CACHE_SHARDS = 64;   // Locks; sets are spread over them round-robin
+
+ /*==============================================================================
+  *  EXCEPTION CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuCacheException
+  *  DESCRIPTION: Base exception class for cache file errors.
+  *----------------------------------------------------------------------------*/
+ class SudokuCacheException : public SudokuBoardException
+ {
+ public:
+     /* Returns a descriptive error message */
+     const char* what() const noexcept override;
+ };
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuCacheFormatException
+  *  DESCRIPTION: Thrown when a cache file is not a cache or is truncated.
+  *----------------------------------------------------------------------------*/
+ class SudokuCacheFormatException : public SudokuCacheException
+ {
+ public:
+     /* Returns a message for the malformed file */
+     const char* what() const noexcept override;
+ };
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuCacheWriteException
+  *  DESCRIPTION: Thrown when the cache cannot be saved.
+  *----------------------------------------------------------------------------*/
+ class SudokuCacheWriteException : public SudokuCacheException
+ {
+ public:
+     /* Returns a message for the write failure */
+     const char* what() const noexcept override;
+ };
+
+ /*==============================================================================
+  *  TYPE DEFINITIONS
+  *============================================================================*/
+
+ /* Counters since the cache was created */
+ struct SudokuCacheStats
+ {
+     uint64_t hits;         // Lookups that found their puzzle
+     uint64_t misses;       // Lookups that did not
+     uint64_t insertions;   // Entries stored, including replacements
+     uint64_t evictions;    // Entries dropped to make room
+     size_t   entries;      // Entries held now
+     size_t   capacity;     // Entries the cache can hold
+ };
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuSolutionCache
+  *  DESCRIPTION: Maps a puzzle to its solution, or to "no solution". The
+  *               puzzle's hash picks a set of SUDOKU_CACHE_WAYS entries and
+  *               the CLOCK hand of that set picks the victim: entries read
+  *               since the hand last passed get a second chance. Entries keep
+  *               the whole puzzle, so a hash collision is a miss rather than
+  *               a wrong answer. All methods are thread-safe.
+  *----------------------------------------------------------------------------*/
+ class SudokuSolutionCache
+ {
+ private:
+     /* One cached puzzle */
+     struct Entry
+     {
+         uint64_t hash;           // hashSudokuGrid of the puzzle
+         uint8_t  puzzle[81];     // Puzzle as looked up
+         uint8_t  solution[81];   // Its solution (unused if it has none)
+         uint8_t  state;          // ENTRY_* flags
+     };
+
+     /* The entries one puzzle can occupy and the CLOCK hand over them */
+     struct Set
+     {
+         Entry   ways[SUDOKU_CACHE_WAYS];
+         uint8_t hand;            // Next way the CLOCK hand looks at
+     };
+
+     /* Lock and counters of a group of sets, on its own cache line */
+     struct alignas(64) Shard
+     {
+         std::mutex lock;
+         uint64_t   hits;
+         uint64_t   misses;
+         uint64_t   insertions;
+         uint64_t   evictions;
+         size_t     entries;
+     };
+
+     std::unique_ptr<Set[]>   sets;       // Entry storage
+     size_t                   setMask;    // Set count minus one (a power of two)
+     std::unique_ptr<Shard[]> shards;     // SUDOKU_CACHE_SHARDS locks
+
+     /* Stores the entry in its set; the shard lock must be held */
+     void store(Set& set, Shard& shard, uint64_t hash, const uint8_t* puzzle, const uint8_t* solution, bool solvable);
+
+ public:
+     /* Allocates room for at least 'capacity' entries (rounded up to a power
+      * of two) */
+     explicit SudokuSolutionCache(size_t capacity = 1 << 16);
+
+     SudokuSolutionCache(const SudokuSolutionCache&) = delete;
+     SudokuSolutionCache& operator=(const SudokuSolutionCache&) = delete;
+
+     /* Looks up the exact puzzle. On a hit, 'solvable' tells whether it has a
+      * solution and, if so, the solution is copied into 'solution'. */
+     bool lookup(SudokuConstGridView puzzle, SudokuGridView solution, bool& solvable);
+
+     /* Stores the puzzle with its solution (ignored unless solvable),
+      * replacing any entry for the same puzzle */
+     void insert(SudokuConstGridView puzzle, SudokuConstGridView solution, bool solvable);
+
+     /* Drops every entry; the counters keep counting */
+     void clear(void);
+
+     /* Sums the counters of all shards */
+     SudokuCacheStats stats(void) const;
+
+     /* Writes every entry to the file. Throws SudokuCacheWriteException */
+     void save(const char* path) const;
+
+     /* Adds the entries of a saved cache, false if the file cannot be opened.
+      * Throws SudokuCacheFormatException if it is not a cache file. */
+     bool load(const char* path);
+ };
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuCachedSolver
+  *  DESCRIPTION: Solves through a shared cache. The exact puzzle is looked up
+  *               first; on a miss its canonical form is, so a puzzle that is
+  *               only a relabeled or permuted copy of a cached one is answered
+  *               by mapping that solution back. New solutions are stored under
+  *               both keys. Without symmetry matching only the exact puzzle
+  *               is looked up and stored, so a miss costs a plain solve.
+  *               Owns its solver and canonicalizer, so keep one per thread.
+  *----------------------------------------------------------------------------*/
+ class SudokuCachedSolver
+ {
+ private:
+     SudokuSolutionCache& cache;           // Shared cache
+     SudokuSolver         solver;          // Solves canonical forms on a miss
+     SudokuCanonicalizer  canonicalizer;   // Canonical form of each missed puzzle
+     SudokuCanonicalForm  form;            // Scratch for the canonical form
+     bool                 matchSymmetries; // Look up canonical forms on a miss
+
+ public:
+     /* Solves through the given cache, which must outlive the solver; with
+      * 'matchSymmetries' off, a miss skips the canonical form */
+     explicit SudokuCachedSolver(SudokuSolutionCache& cache, bool matchSymmetries = true);
+
+     /* Solves the grid in place, returns false if it has no solution */
+     bool solve(SudokuGridView grid);
+
+     /* Solves the board; only a successful solve changes it, and its undo
+      * history is kept */
+     bool solve(SudokuBoard& board);
+ };
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
@@ -0,0 +1,491 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuCanonical
+ *  FILE         : SudokuCanonical.cpp
+ *  DESCRIPTION  : Implements minimal-lexicographic canonicalization of 9x9
+ *                 puzzles, the canonical hash and the batch dedupe mode.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuCanonical.hpp"
+#include "SudokuBits.hpp"
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+/*==============================================================================
+ *  CONSTANTS
+ *============================================================================*/
+
+namespace
+{
+    const int COLUMN_ORDERS = 6 * 6 * 6 * 6;   // Stack order x column order in each stack
+
+    const uint8_t NO_LABEL = 0xFF;            // Larger than any cell of a built row
+
+    /* The six orders of three items */
+    const uint8_t PERMUTATIONS_OF_3[6][3] =
+    {
+        { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 }
+    };
+
+    /* Every column order that keeps stacks together: source column of each
+     * canonical column */
+    struct ColumnOrderTable
+    {
+        uint8_t colOf[COLUMN_ORDERS][9];
+
+        constexpr ColumnOrderTable() : colOf()
+        {
+            for (int index = 0; index < COLUMN_ORDERS; index++)
+            {
+                int stacks = index / 216;
+                int inside[3] = { (index / 36) % 6, (index / 6) % 6, index % 6 };
+
+                for (int stack = 0; stack < 3; stack++)
+                {
+                    int source = PERMUTATIONS_OF_3[stacks][stack];
+                    for (int col = 0; col < 3; col++)
+                    {
+                        colOf[index][stack * 3 + col] =
+                            static_cast<uint8_t>(source * 3 + PERMUTATIONS_OF_3[inside[stack]][col]);
+                    }
+                }
+            }
+        }
+    };
+
+    constexpr ColumnOrderTable COLUMN_ORDER_TABLE;
+
+    /* Source rows that may become canonical row 'row' given the rows already
+     * used: a whole unused band at a band start, otherwise the rest of the
+     * band in progress */
+    inline unsigned int rowChoices(unsigned int usedRows, int row, int previousRow)
+    {
+        if (row % 3 != 0)
+        {
+            return (0x7u << (previousRow / 3 * 3)) & ~usedRows;
+        }
+
+        unsigned int choices = 0;
+        for (int band = 0; band < 3; band++)
+        {
+            if ((usedRows & (0x7u << (band * 3))) == 0)
+            {
+                choices |= 0x7u << (band * 3);
+            }
+        }
+        return choices;
+    }
+
+    /* True if the three cells of a stack, read in the given order, have all
+     * their blanks before their digits ('filled' has one bit per cell) */
+    inline bool blanksFirst(unsigned int filled, int order)
+    {
+        bool seenDigit = false;
+        for (int col = 0; col < 3; col++)
+        {
+            bool digit = (filled >> PERMUTATIONS_OF_3[order][col]) & 1u;
+            if (seenDigit && !digit)
+            {
+                return false;
+            }
+            seenDigit = seenDigit || digit;
+        }
+        return true;
+    }
+
+    /* Final mixing step of splitmix64 */
+    inline uint64_t mix64(uint64_t value)
+    {
+        value ^= value >> 30;
+        value *= 0xBF58476D1CE4E5B9ull;
+        value ^= value >> 27;
+        value *= 0x94D049BB133111EBull;
+        value ^= value >> 31;
+        return value;
+    }
+}
+
+/*==============================================================================
+ *  SudokuCanonicalizer
+ *============================================================================*/
+
+/* With distinct digits in a row, relabeling numbers its digits 1, 2, 3...
+ * from left to right, so the row only depends on where its blanks end up.
+ * The smallest first row puts the stacks with the most blanks first and the
+ * blanks of each stack before its digits; the column orders that do so are
+ * enumerated directly instead of trying all 1296 on all 18 rows. */
+bool SudokuCanonicalizer::seedFirstRow(const uint8_t source[2][81], uint8_t best[9])
+{
+    unsigned int filled[2][9];   // Filled cells of each row, one bit per column
+    int counts[2][9][3];         // Digits in each stack of each row
+    int keys[2][9];              // Stack counts in increasing order, as base-4 digits
+    int bestKey = 0x7FFFFFFF;
+
+    for (int transposed = 0; transposed < 2; transposed++)
+    {
+        for (int row = 0; row < 9; row++)
+        {
+            unsigned int digits = 0;
+            filled[transposed][row] = 0;
+            for (int col = 0; col < 9; col++)
+            {
+                int value = source[transposed][row * 9 + col];
+                if (value == 0)
+                {
+                    continue;
+                }
+                if (digits & (1u << value))
+                {
+                    return false;   // Repeated digit: leave it to the general search
+                }
+                digits |= 1u << value;
+                filled[transposed][row] |= 1u << col;
+            }
+
+            int sorted[3];
+            for (int stack = 0; stack < 3; stack++)
+            {
+                counts[transposed][row][stack] = sudokuPopcount((filled[transposed][row] >> (stack * 3)) & 0x7u);
+                sorted[stack] = counts[transposed][row][stack];
+            }
+            for (int stack = 1; stack < 3; stack++)
+            {
+                for (int back = stack; back > 0 && sorted[back - 1] > sorted[back]; back--)
+                {
+                    int swap = sorted[back];
+                    sorted[back] = sorted[back - 1];
+                    sorted[back - 1] = swap;
+                }
+            }
+
+            keys[transposed][row] = sorted[0] * 16 + sorted[1] * 4 + sorted[2];
+            if (keys[transposed][row] < bestKey)
+            {
+                bestKey = keys[transposed][row];
+            }
+        }
+    }
+
+    int label = 1;
+    for (int stack = 0; stack < 3; stack++)
+    {
+        int count = (bestKey >> (4 - 2 * stack)) & 0x3;
+        for (int col = 0; col < 3; col++)
+        {
+            best[stack * 3 + col] = static_cast<uint8_t>(col < 3 - count ? 0 : label++);
+        }
+    }
+
+    for (int transposed = 0; transposed < 2; transposed++)
+    {
+        for (int row = 0; row < 9; row++)
+        {
+            if (keys[transposed][row] != bestKey)
+            {
+                continue;
+            }
+
+            const uint8_t* cells = source[transposed] + row * 9;
+            const int* rowCounts = counts[transposed][row];
+
+            for (int stacks = 0; stacks < 6; stacks++)
+            {
+                const uint8_t* from = PERMUTATIONS_OF_3[stacks];
+                if (rowCounts[from[0]] > rowCounts[from[1]] || rowCounts[from[1]] > rowCounts[from[2]])
+                {
+                    continue;
+                }
+
+                for (int columns = stacks * 216; columns < (stacks + 1) * 216; columns++)
+                {
+                    if (!blanksFirst((filled[transposed][row] >> (from[0] * 3)) & 0x7u, (columns / 36) % 6) ||
+                        !blanksFirst((filled[transposed][row] >> (from[1] * 3)) & 0x7u, (columns / 6) % 6) ||
+                        !blanksFirst((filled[transposed][row] >> (from[2] * 3)) & 0x7u, columns % 6))
+                    {
+                        continue;
+                    }
+
+                    Candidate seed = {};
+                    seed.columns = static_cast<uint16_t>(columns);
+                    seed.transposed = static_cast<uint8_t>(transposed);
+                    seed.rowOf[0] = static_cast<uint8_t>(row);
+                    seed.usedRows = static_cast<uint16_t>(1u << row);
+                    seed.nextLabel = 1;
+                    for (int col = 0; col < 9; col++)
+                    {
+                        int value = cells[COLUMN_ORDER_TABLE.colOf[columns][col]];
+                        if (value != 0)
+                        {
+                            seed.label[value] = seed.nextLabel++;
+                        }
+                    }
+                    current.push_back(seed);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/* Once a band is complete, candidates that differ only in the order of its
+ * rows continue identically. Only nearly empty grids produce many of them,
+ * but without this an empty grid would carry millions of candidates. */
+void SudokuCanonicalizer::dropDuplicates(void)
+{
+    auto sameFuture = [](const Candidate& a, const Candidate& b)
+    {
+        return a.transposed == b.transposed && a.columns == b.columns && a.usedRows == b.usedRows &&
+               std::memcmp(a.label, b.label, sizeof(a.label)) == 0;
+    };
+    auto before = [](const Candidate& a, const Candidate& b)
+    {
+        if (a.transposed != b.transposed)
+        {
+            return a.transposed < b.transposed;
+        }
+        if (a.columns != b.columns)
+        {
+            return a.columns < b.columns;
+        }
+        if (a.usedRows != b.usedRows)
+        {
+            return a.usedRows < b.usedRows;
+        }
+        return std::memcmp(a.label, b.label, sizeof(a.label)) < 0;
+    };
+
+    if (next.size() > 1)
+    {
+        std::sort(next.begin(), next.end(), before);
+        next.erase(std::unique(next.begin(), next.end(), sameFuture), next.end());
+    }
+}
+
+/* Builds the canonical grid row by row, keeping every partial symmetry that
+ * ties for the smallest rows so far */
+void SudokuCanonicalizer::canonicalize(SudokuConstGridView grid, SudokuCanonicalForm& form)
+{
+    uint8_t source[2][81];   // The grid as given and transposed
+
+    for (int cell = 0; cell < 81; cell++)
+    {
+        source[0][cell] = grid[cell];
+        source[1][(cell % 9) * 9 + cell / 9] = grid[cell];
+    }
+
+    current.clear();
+    int firstRow = seedFirstRow(source, form.cells) ? 1 : 0;
+    if (firstRow == 0)
+    {
+        for (int transposed = 0; transposed < 2; transposed++)
+        {
+            for (int columns = 0; columns < COLUMN_ORDERS; columns++)
+            {
+                Candidate seed = {};
+                seed.columns = static_cast<uint16_t>(columns);
+                seed.transposed = static_cast<uint8_t>(transposed);
+                seed.nextLabel = 1;
+                current.push_back(seed);
+            }
+        }
+    }
+
+    for (int row = firstRow; row < 9; row++)
+    {
+        uint8_t* best = form.cells + row * 9;
+        std::memset(best, NO_LABEL, 9);
+        next.clear();
+
+        for (const Candidate& candidate : current)
+        {
+            const uint8_t* colOf = COLUMN_ORDER_TABLE.colOf[candidate.columns];
+            unsigned int choices = rowChoices(candidate.usedRows, row, row > 0 ? candidate.rowOf[row - 1] : 0);
+
+            while (choices)
+            {
+                int sourceRow = sudokuCtz(choices);
+                choices &= choices - 1;
+
+                const uint8_t* cells = source[candidate.transposed] + sourceRow * 9;
+                uint8_t label[10];
+                uint8_t built[9];
+                int nextLabel = candidate.nextLabel;
+                int order = 0;   // <0 smaller than best, >0 larger, 0 tied so far
+
+                std::memcpy(label, candidate.label, sizeof(label));
+                for (int col = 0; col < 9; col++)
+                {
+                    int value = cells[colOf[col]];
+                    if (value != 0)
+                    {
+                        if (label[value] == 0)
+                        {
+                            label[value] = static_cast<uint8_t>(nextLabel++);
+                        }
+                        value = label[value];
+                    }
+                    if (order == 0 && value != best[col])
+                    {
+                        order = (value < best[col]) ? -1 : 1;
+                        if (order > 0)
+                        {
+                            break;
+                        }
+                    }
+                    built[col] = static_cast<uint8_t>(value);
+                }
+
+                if (order > 0)
+                {
+                    continue;
+                }
+                if (order < 0)
+                {
+                    std::memcpy(best, built, 9);
+                    next.clear();
+                }
+
+                Candidate extended = candidate;
+                extended.rowOf[row] = static_cast<uint8_t>(sourceRow);
+                extended.usedRows = static_cast<uint16_t>(candidate.usedRows | (1u << sourceRow));
+                std::memcpy(extended.label, label, sizeof(label));
+                extended.nextLabel = static_cast<uint8_t>(nextLabel);
+                next.push_back(extended);
+            }
+        }
+        if (row % 3 == 2 && row < 8)
+        {
+            dropDuplicates();
+        }
+        current.swap(next);
+    }
+
+    // Any survivor reaches the same grid; digits the grid never uses get the
+    // remaining labels in increasing order so the transform is a bijection
+    const Candidate& chosen = current.front();
+    int nextLabel = chosen.nextLabel;
+
+    form.transform.transposed = chosen.transposed;
+    std::memcpy(form.transform.rowOf, chosen.rowOf, 9);
+    std::memcpy(form.transform.colOf, COLUMN_ORDER_TABLE.colOf[chosen.columns], 9);
+    std::memcpy(form.transform.label, chosen.label, 10);
+    for (int digit = 1; digit <= 9; digit++)
+    {
+        if (form.transform.label[digit] == 0)
+        {
+            form.transform.label[digit] = static_cast<uint8_t>(nextLabel++);
+        }
+    }
+    form.hash = hashSudokuGrid(SudokuConstGridView(form.cells));
+}
+
+/*==============================================================================
+ *  FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Packs the cells 16 to a word and mixes the words */
+uint64_t hashSudokuGrid(SudokuConstGridView grid)
+{
+    uint64_t hash = 0x9E3779B97F4A7C15ull;
+
+    for (int start = 0; start < 81; start += 16)
+    {
+        uint64_t word = 0;
+        for (int cell = start; cell < start + 16 && cell < 81; cell++)
+        {
+            word = (word << 4) | (grid[cell] & 0xF);
+        }
+        hash = mix64(hash ^ word) + static_cast<uint64_t>(start);
+    }
+    return mix64(hash);
+}
+
+/* Reads the source through the transform into canonical coordinates */
+void applySudokuTransform(const SudokuTransform& transform, SudokuConstGridView source, SudokuGridView dest)
+{
+    for (int row = 0; row < 9; row++)
+    {
+        for (int col = 0; col < 9; col++)
+        {
+            int sourceRow = transform.rowOf[row];
+            int sourceCol = transform.colOf[col];
+            int cell = transform.transposed ? sourceCol * 9 + sourceRow : sourceRow * 9 + sourceCol;
+            dest[row * 9 + col] = transform.label[source[cell]];
+        }
+    }
+}
+
+/* Writes every canonical cell back to its source position with its source digit */
+void invertSudokuTransform(const SudokuTransform& transform, SudokuConstGridView canonical, SudokuGridView dest)
+{
+    uint8_t digitOf[10];
+
+    for (int digit = 0; digit <= 9; digit++)
+    {
+        digitOf[transform.label[digit]] = static_cast<uint8_t>(digit);
+    }
+
+    for (int row = 0; row < 9; row++)
+    {
+        for (int col = 0; col < 9; col++)
+        {
+            int sourceRow = transform.rowOf[row];
+            int sourceCol = transform.colOf[col];
+            int cell = transform.transposed ? sourceCol * 9 + sourceRow : sourceRow * 9 + sourceCol;
+            dest[cell] = digitOf[canonical[row * 9 + col]];
+        }
+    }
+}
+
+/* Canonicalizes every line and counts the distinct hashes */
+uint64_t runCanonicalBatch(SudokuPuzzleReader& reader, SudokuSolutionWriter& writer, uint64_t& classes)
+{
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    static const char INVALID_LINE[] = "invalid";
+
+    SudokuCanonicalizer canonicalizer;
+    SudokuCanonicalForm form;
+    std::unordered_set<uint64_t> seen;
+    uint8_t grid[81];
+    char text[81 + 1 + 16];
+    const char* line;
+    size_t length;
+    uint64_t puzzles = 0;
+
+    while (reader.nextLine(line, length))
+    {
+        if (!parsePuzzleLine(line, length, SudokuGridView(grid)))
+        {
+            writer.writeLine(INVALID_LINE, sizeof(INVALID_LINE) - 1);
+            continue;
+        }
+        puzzles++;
+
+        canonicalizer.canonicalize(SudokuConstGridView(grid), form);
+        seen.insert(form.hash);
+
+        for (int cell = 0; cell < 81; cell++)
+        {
+            text[cell] = form.cells[cell] ? static_cast<char>('0' + form.cells[cell]) : '.';
+        }
+        text[81] = ' ';
+        for (int nibble = 0; nibble < 16; nibble++)
+        {
+            text[82 + nibble] = HEX_DIGITS[(form.hash >> (60 - 4 * nibble)) & 0xF];
+        }
+        writer.writeLine(text, sizeof(text));
+    }
+    writer.flush();
+
+    classes = seen.size();
+    return puzzles;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,114 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuCanonical
+ *  FILE         : SudokuCanonical.hpp
+ *  DESCRIPTION  : Canonical form of a 9x9 puzzle under the Sudoku symmetries
+ *                 (digit relabeling, band and stack permutations, row and
+ *                 column swaps inside them, transposition) and a 64-bit hash
+ *                 of it. Two puzzles are equivalent exactly when their
+ *                 canonical forms are equal.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include "SudokuBoard.hpp"
+ #include "SudokuBatch.hpp"
+ #include <cstdint>
+ #include <vector>
+
+ /*==============================================================================
+  *  TYPE DEFINITIONS
+  *============================================================================*/
+
+ /* A symmetry mapping a source grid onto its canonical form: canonical cell
+  * (r, c) holds label[v], where v is source cell (rowOf[r], colOf[c]) of the
+  * source grid, transposed first if 'transposed' is set */
+ struct SudokuTransform
+ {
+     uint8_t transposed;   // 1 if rows and columns are swapped before permuting
+     uint8_t rowOf[9];     // Source row of each canonical row
+     uint8_t colOf[9];     // Source column of each canonical column
+     uint8_t label[10];    // Canonical digit of each source digit (label[0] = 0)
+ };
+
+ /* Result of canonicalizing one grid */
+ struct SudokuCanonicalForm
+ {
+     uint8_t         cells[81];   // Lexicographically smallest equivalent grid
+     uint64_t        hash;        // hashSudokuGrid of the cells
+     SudokuTransform transform;   // Maps the input grid onto 'cells'
+ };
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuCanonicalizer
+  *  DESCRIPTION: Finds the minimal lexicographic form (row-major, blanks as
+  *               0, digits relabeled in order of first appearance) by
+  *               building it one row at a time. Every partial symmetry that
+  *               produces the smallest rows so far is kept, the others are
+  *               dropped, so only ties are carried to the next row. The
+  *               candidate lists are reused between calls; keep one
+  *               canonicalizer per thread.
+  *----------------------------------------------------------------------------*/
+ class SudokuCanonicalizer
+ {
+ private:
+     /* A partial symmetry: rows chosen so far, a full column order and the
+      * digit labels handed out so far */
+     struct Candidate
+     {
+         uint8_t  rowOf[9];      // Source row of each canonical row chosen so far
+         uint8_t  label[10];     // Canonical digit of each source digit, 0 if none yet
+         uint16_t columns;       // Index of the column order in the order table
+         uint16_t usedRows;      // Source rows already chosen, one bit each
+         uint8_t  transposed;    // 1 if the source is read transposed
+         uint8_t  nextLabel;     // Next canonical digit to hand out
+     };
+
+     std::vector<Candidate> current;   // Candidates tied for the rows built so far
+     std::vector<Candidate> next;      // Candidates tied after the row being built
+
+     /* Seeds the candidates that tie for the smallest first row and writes
+      * that row to 'best'. Returns false, leaving the candidates empty, if a
+      * row or column repeats a digit. */
+     bool seedFirstRow(const uint8_t source[2][81], uint8_t best[9]);
+
+     /* Removes candidates of 'next' whose remaining search is the same */
+     void dropDuplicates(void);
+
+ public:
+     /* Computes the canonical form, hash and transform of the grid (values
+      * 0-9, 0 for blanks). Does not allocate once the lists have grown. */
+     void canonicalize(SudokuConstGridView grid, SudokuCanonicalForm& form);
+ };
+
+ /*==============================================================================
+  *  FUNCTION DECLARATIONS
+  *============================================================================*/
+
+ /* 64-bit hash of a grid's 81 cells */
+ uint64_t hashSudokuGrid(SudokuConstGridView grid);
+
+ /* Applies the transform to a grid equivalent to its source (for example the
+  * source's solution) */
+ void applySudokuTransform(const SudokuTransform& transform, SudokuConstGridView source, SudokuGridView dest);
+
+ /* Maps a grid in canonical coordinates (for example a canonical solution)
+  * back onto the source's rows, columns and digits */
+ void invertSudokuTransform(const SudokuTransform& transform, SudokuConstGridView canonical, SudokuGridView dest);
+
+ /* Writes "<canonical form> <hash in hex>" for every puzzle line and
+  * "invalid" for lines that do not parse. Returns the number of puzzles;
+  * 'classes' receives the number of distinct canonical forms among them. */
+ uint64_t runCanonicalBatch(SudokuPuzzleReader& reader, SudokuSolutionWriter& writer, uint64_t& classes);
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
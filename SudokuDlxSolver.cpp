@@ -0,0 +1,272 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuDlxSolver
+ *  FILE         : SudokuDlxSolver.cpp
+ *  DESCRIPTION  : Implements the Dancing Links exact-cover solver: matrix
+ *                 construction, cover/uncover and Algorithm X with the
+ *                 smallest-column heuristic.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuDlxSolver.hpp"
+#include <cstring>
+
+/*==============================================================================
+ *  CONSTRUCTOR
+ *============================================================================*/
+
+/* Builds the header list and the 729 candidate rows of four nodes each */
+SudokuDlxSolver::SudokuDlxSolver()
+    : clueCount(0), nodesVisited(0), solutionLimit(1), solutionsFound(0)
+{
+    for (int col = 0; col <= COLUMNS; col++)
+    {
+        left[col] = static_cast<uint16_t>(col == 0 ? COLUMNS : col - 1);
+        right[col] = static_cast<uint16_t>(col == COLUMNS ? 0 : col + 1);
+        up[col] = static_cast<uint16_t>(col);
+        down[col] = static_cast<uint16_t>(col);
+        column[col] = static_cast<uint16_t>(col);
+        candidate[col] = 0;
+        size[col] = 0;
+    }
+
+    int node = COLUMNS + 1;
+    for (int row = 0; row < ROWS; row++)
+    {
+        int cell = row / 9;
+        int digit = row % 9;
+        int r = cell / 9;
+        int c = cell % 9;
+        int b = (r / 3) * 3 + c / 3;
+        const int cols[4] = {
+            1 + cell,                // Cell is filled
+            1 + 81 + r * 9 + digit,  // Row holds digit
+            1 + 162 + c * 9 + digit, // Column holds digit
+            1 + 243 + b * 9 + digit  // Box holds digit
+        };
+
+        firstNode[row] = static_cast<uint16_t>(node);
+        for (int index = 0; index < 4; index++)
+        {
+            int col = cols[index];
+
+            column[node] = static_cast<uint16_t>(col);
+            candidate[node] = static_cast<uint16_t>(row);
+            up[node] = up[col];
+            down[node] = static_cast<uint16_t>(col);
+            down[up[col]] = static_cast<uint16_t>(node);
+            up[col] = static_cast<uint16_t>(node);
+            size[col]++;
+
+            left[node] = static_cast<uint16_t>(index == 0 ? node + 3 : node - 1);
+            right[node] = static_cast<uint16_t>(index == 3 ? node - 3 : node + 1);
+            node++;
+        }
+    }
+}
+
+/*==============================================================================
+ *  PUBLIC FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Solves the grid, writing the solution back through the view */
+bool SudokuDlxSolver::solve(SudokuGridView grid)
+{
+    if (runSearch(grid, 1) == 0)
+    {
+        return false;
+    }
+
+    copySolution(grid);
+    return true;
+}
+
+/* Counts the grid's solutions up to 'limit' in a single search */
+int SudokuDlxSolver::countSolutions(SudokuConstGridView grid, int limit)
+{
+    return runSearch(grid, limit);
+}
+
+/* Copies the stored first solution */
+void SudokuDlxSolver::copySolution(SudokuGridView grid) const
+{
+    std::memcpy(grid.data(), solution, sizeof(solution));
+}
+
+/* Number of search nodes entered by the last solve */
+uint64_t SudokuDlxSolver::getNodesVisited(void) const
+{
+    return nodesVisited;
+}
+
+/* Backend name */
+const char* SudokuDlxSolver::name(void) const
+{
+    return "dlx";
+}
+
+/*==============================================================================
+ *  PRIVATE FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Covers the givens, searches and always restores the matrix */
+int SudokuDlxSolver::runSearch(SudokuConstGridView grid, int limit)
+{
+    nodesVisited = 0;
+    solutionLimit = limit;
+    solutionsFound = 0;
+    clueCount = 0;
+
+    bool valid = true;
+    for (int cell = 0; cell < 81 && valid; cell++)
+    {
+        int value = grid[cell];
+        givens[cell] = static_cast<uint8_t>(value);
+        if (value != 0)
+        {
+            valid = value <= 9 && selectClue(cell * 9 + value - 1);
+        }
+    }
+
+    if (valid)
+    {
+        search(0);
+    }
+    releaseClues();
+    return solutionsFound;
+}
+
+/* Knuth's cover: the column leaves the header list, its rows leave the other columns */
+void SudokuDlxSolver::cover(int col)
+{
+    right[left[col]] = right[col];
+    left[right[col]] = left[col];
+
+    for (int row = down[col]; row != col; row = down[row])
+    {
+        for (int node = right[row]; node != row; node = right[node])
+        {
+            down[up[node]] = down[node];
+            up[down[node]] = up[node];
+            size[column[node]]--;
+        }
+    }
+}
+
+/* Knuth's uncover: the same links restored in the opposite order */
+void SudokuDlxSolver::uncover(int col)
+{
+    for (int row = up[col]; row != col; row = up[row])
+    {
+        for (int node = left[row]; node != row; node = left[node])
+        {
+            size[column[node]]++;
+            down[up[node]] = static_cast<uint16_t>(node);
+            up[down[node]] = static_cast<uint16_t>(node);
+        }
+    }
+
+    right[left[col]] = static_cast<uint16_t>(col);
+    left[right[col]] = static_cast<uint16_t>(col);
+}
+
+/* A given's row is only available while none of its columns is covered */
+bool SudokuDlxSolver::selectClue(int row)
+{
+    int first = firstNode[row];
+    int node = first;
+
+    do
+    {
+        int col = column[node];
+        if (right[left[col]] != col)
+        {
+            return false;   // Another given already satisfies this constraint
+        }
+        node = right[node];
+    } while (node != first);
+
+    node = first;
+    do
+    {
+        cover(column[node]);
+        node = right[node];
+    } while (node != first);
+
+    clues[clueCount++] = static_cast<uint16_t>(row);
+    return true;
+}
+
+/* Uncovers the givens last-in first-out */
+void SudokuDlxSolver::releaseClues(void)
+{
+    while (clueCount > 0)
+    {
+        int first = firstNode[clues[--clueCount]];
+        for (int node = left[first]; node != first; node = left[node])
+        {
+            uncover(column[node]);
+        }
+        uncover(column[first]);
+    }
+}
+
+/* Algorithm X on the column with the fewest live rows */
+bool SudokuDlxSolver::search(int depth)
+{
+    nodesVisited++;
+
+    if (right[ROOT] == ROOT)
+    {
+        if (solutionsFound == 0)
+        {
+            std::memcpy(solution, givens, sizeof(solution));
+            for (int level = 0; level < depth; level++)
+            {
+                solution[chosen[level] / 9] = static_cast<uint8_t>(chosen[level] % 9 + 1);
+            }
+        }
+        solutionsFound++;
+        return solutionsFound >= solutionLimit;
+    }
+
+    int best = right[ROOT];
+    for (int col = right[best]; col != ROOT && size[best] > 1; col = right[col])
+    {
+        if (size[col] < size[best])
+        {
+            best = col;
+        }
+    }
+    if (size[best] == 0)
+    {
+        return false;
+    }
+
+    bool done = false;
+    cover(best);
+    for (int row = down[best]; row != best && !done; row = down[row])
+    {
+        chosen[depth] = candidate[row];
+        for (int node = right[row]; node != row; node = right[node])
+        {
+            cover(column[node]);
+        }
+
+        done = search(depth + 1);
+
+        for (int node = left[row]; node != row; node = left[node])
+        {
+            uncover(column[node]);
+        }
+    }
+    uncover(best);
+    return done;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
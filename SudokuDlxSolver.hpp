@@ -0,0 +1,99 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuDlxSolver
+ *  FILE         : SudokuDlxSolver.hpp
+ *  DESCRIPTION  : Header file for the SudokuDlxSolver class, a Dancing Links
+ *                 (Knuth's Algorithm X) exact-cover solver backend.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include "SudokuSolverEngine.hpp"
+ #include <cstdint>
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuDlxSolver
+  *  DESCRIPTION: Sudoku as exact cover: 729 candidate rows (cell, digit) over
+  *               324 constraint columns (cell filled, row/column/box holds
+  *               digit). The full link matrix is built once in the
+  *               constructor and lives inside the object. A solve covers the
+  *               rows of the givens, searches, then uncovers everything in
+  *               reverse order, which restores the matrix exactly, so solves
+  *               never allocate or rebuild.
+  *----------------------------------------------------------------------------*/
+ class SudokuDlxSolver final : public SudokuSolverEngine
+ {
+ private:
+     static const int COLUMNS = 324;                  // Constraint columns
+     static const int ROWS    = 729;                  // Candidate (cell, digit) rows
+     static const int ROOT    = 0;                    // Header of the column list
+     static const int NODES   = 1 + COLUMNS + ROWS * 4;
+
+     /* Links of the toroidal matrix; indices 1..COLUMNS are column headers */
+     uint16_t left[NODES];
+     uint16_t right[NODES];
+     uint16_t up[NODES];
+     uint16_t down[NODES];
+     uint16_t column[NODES];      // Column header of each node
+     uint16_t candidate[NODES];   // Candidate row (cell * 9 + digit - 1) of each node
+     uint16_t size[COLUMNS + 1];  // Live nodes per column
+     uint16_t firstNode[ROWS];    // First node of each candidate row
+
+     uint16_t chosen[81];         // Rows picked by the search, one per level
+     uint16_t clues[81];          // Rows covered for the givens
+     int      clueCount;
+     uint8_t  solution[81];       // First solution found by the last search
+     uint8_t  givens[81];         // Givens of the current grid
+     uint64_t nodesVisited;       // Search nodes entered by the last search
+     int      solutionLimit;      // Search stops after this many solutions
+     int      solutionsFound;     // Solutions found so far by the current search
+
+     /* Unlinks a column and every row that intersects it */
+     void cover(int col);
+
+     /* Exact inverse of cover */
+     void uncover(int col);
+
+     /* Covers the columns of one candidate row, false if one is already gone */
+     bool selectClue(int row);
+
+     /* Uncovers the givens in reverse order, restoring the full matrix */
+     void releaseClues(void);
+
+     /* Algorithm X; returns true once solutionLimit solutions have been found */
+     bool search(int depth);
+
+     /* Loads the givens and counts solutions up to 'limit' */
+     int runSearch(SudokuConstGridView grid, int limit);
+
+ public:
+     /* Constructor: builds the full 729 x 324 link matrix */
+     SudokuDlxSolver();
+
+     /* Solves the grid in place (no allocation), returns false if it has no solution */
+     bool solve(SudokuGridView grid) override;
+
+     /* Counts solutions of the grid (left unchanged), stopping at 'limit' */
+     int countSolutions(SudokuConstGridView grid, int limit) override;
+
+     /* Copies the first solution found by the last solve/count into 'grid' */
+     void copySolution(SudokuGridView grid) const override;
+
+     /* Number of search nodes entered by the last solve */
+     uint64_t getNodesVisited(void) const override;
+
+     /* Returns "dlx" */
+     const char* name(void) const override;
+ };
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
@@ -11,7 +11,7 @@
  *  INCLUDES
  *============================================================================*/
 #include "SudokuGame.hpp"
-#include "SudokuSolver.hpp"
+#include "SudokuReplay.hpp"
 #include <iostream>
 #include <limits>
 
@@ -35,32 +35,81 @@ const char* SudokuGameInvalidInputException::what() const noexcept
  *  CONSTRUCTOR
  *============================================================================*/
 
-/* Initializes the SudokuGame with the running flag set to true */
-SudokuGame::SudokuGame() : isRunning(true) {}
+/* Plays on the terminal */
+SudokuGame::SudokuGame(const char* cachePath) : SudokuGame(std::cin, std::cout, std::cerr, cachePath)
+{
+}
+
+/* Initializes the SudokuGame with the running flag set to true and loads
+ * the cache file; a missing file just starts an empty cache */
+SudokuGame::SudokuGame(std::istream& input, std::ostream& output, std::ostream& errors, const char* cachePath)
+    : isRunning(true), cachePath(cachePath), cache(SUDOKU_GAME_CACHE_ENTRIES), solver(cache),
+      input(input), output(output), errors(errors), recorder(nullptr)
+{
+#ifdef SUDOKU_BUILD_ADVANCED
+    hints.reset(session.getBoard().view());
+#endif
+    if (cachePath == nullptr)
+    {
+        return;
+    }
+    try
+    {
+        cache.load(cachePath);
+    }
+    catch (const SudokuCacheException& cacheError)
+    {
+        errors << cacheError.what() << std::endl;
+    }
+}
 
 /*==============================================================================
  *  PUBLIC FUNCTION DEFINITIONS
  *============================================================================*/
 
+/* Fresh session and hint engine; the cache and its solutions stay */
+void SudokuGame::newGame(void)
+{
+    session.reset();
+    isRunning = true;
+#ifdef SUDOKU_BUILD_ADVANCED
+    hints.reset(session.getBoard().view());
+#endif
+}
+
+/* The recorder is not owned */
+void SudokuGame::setRecorder(SudokuSessionRecorder* recorder)
+{
+    this->recorder = recorder;
+}
+
 /* Main game loop: handles menu display, user choice, and dispatch */
 void SudokuGame::run(void)
 {
     while(isRunning)
     {
-        board.printBoard();
+        session.getBoard().printBoard(output);
         SudokuGame::displayMenu();
 
-        int userChoice;
+        int userChoice = 0;
         try
         {
             userChoice = SudokuGame::getUserChoice();
         }
         catch(SudokuGameException& GameError)
         {
-            std::cerr << GameError.what() << std::endl;
+            errors << GameError.what() << std::endl;
+            if (input.eof())
+            {
+                break;   // Nothing more to read
+            }
             SudokuGame::clearInput();
             SudokuGame::promptContinue();
         }
+        if (recorder != nullptr && userChoice != 1)
+        {
+            recorder->record(userChoice);   // Moves are recorded as they are read
+        }
         switch(userChoice)
         {
             case 1:
@@ -75,6 +124,20 @@ void SudokuGame::run(void)
             SudokuGame::handleExit();
             break;
 
+#ifdef SUDOKU_BUILD_ADVANCED
+            case 4:
+            SudokuGame::handleHint();
+            break;
+#endif
+
+            case 5:
+            SudokuGame::handleUndo();
+            break;
+
+            case 6:
+            SudokuGame::handleRedo();
+            break;
+
             default:
             break;
         }
@@ -83,15 +146,31 @@ void SudokuGame::run(void)
     {
         SudokuGame::handleExit();
     }
+    if (cachePath != nullptr)
+    {
+        try
+        {
+            cache.save(cachePath);
+        }
+        catch (const SudokuCacheException& cacheError)
+        {
+            errors << cacheError.what() << std::endl;
+        }
+    }
 }
 
 /* Displays the main game menu options */
 void SudokuGame::displayMenu(void) const
 {
-    std::cout 
+    output 
     << "1) Enter a move\n"
     << "2) Solve automatically\n"
     << "3) Exit\n"
+#ifdef SUDOKU_BUILD_ADVANCED
+    << "4) Get a hint\n"
+#endif
+    << "5) Undo last move\n"
+    << "6) Redo move\n"
     << std::endl;
 }
 
@@ -100,86 +179,162 @@ int SudokuGame::getUserChoice(void) const
 {
     int userChoice;
 
-    std::cin >> userChoice;
-    if (std::cin.fail()) {throw SudokuGameInvalidInputException();}
+    input >> userChoice;
+    if (input.fail()) {throw SudokuGameInvalidInputException();}
     return userChoice;
 }
 
 /* Clears the input stream of invalid entries */
 void SudokuGame::clearInput(void) const
 {
-    std::cin.clear();
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // flush leftovers
+    input.clear();
+    input.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // flush leftovers
 }
 
 /* Prompts the user to press Enter to continue */
 char SudokuGame::promptContinue(void) const
 {
     SudokuGame::clearInput();
-    std::cout << "\nPress Enter to continue... or q to quit :";
-    return std::cin.get(); // wait for Enter 
+    output << "\nPress Enter to continue... or q to quit :";
+    return static_cast<char>(input.get()); // wait for Enter 
 }
 
-/* Reads and validates a user's move, applies it to the board */
+/* Reads and validates a user's move and applies it to the board, asking
+ * again after a rejected move until one is accepted or the user quits */
 void SudokuGame::handleMove(void)
 {
     int row, col, value;
 
-    std::cout << "Enter row (1-9), column (1-9), and value (1-9): ";
+    output << "Enter row (1-9), column (1-9), and value (1-9): ";
 
     while(true)
     {
         try 
         {
-            std::cin >> row;
-            if(std::cin.fail())
+            input >> row;
+            if(input.fail())
             {
                 throw SudokuGameInvalidInputException();
             }
-            std::cin >> col;
-            if(std::cin.fail())
+            input >> col;
+            if(input.fail())
             {
                 throw SudokuGameInvalidInputException();
             }
-            std::cin >> value;
-            if(std::cin.fail())
+            input >> value;
+            if(input.fail())
             {
                 throw SudokuGameInvalidInputException();
             }
-
-                board.setCell(row,col,value);
+            if (recorder != nullptr)
+            {
+                recorder->record(1, row, col, value);
             }
+
+            SudokuBoard::throwPlacementError(session.move(row, col, value));
+#ifdef SUDOKU_BUILD_ADVANCED
+            hints.applyMove((row - 1) * 9 + (col - 1), value);
+#endif
+            break;
+        }
         catch(const SudokuBoardException& boardError)
         {
-            std::cerr << boardError.what() << std::endl;
+            errors << boardError.what() << std::endl;
 
-            if(SudokuGame::promptContinue() == 'q')
+            if(SudokuGame::promptContinue() == 'q' || !input)
             {
                 break;
             }
-            board.printBoard();
-            std::cout << "\nEnter row (1-9), column (1-9), and value (1-9): ";
+            session.getBoard().printBoard(output);
+            output << "\nEnter row (1-9), column (1-9), and value (1-9): ";
         }
     }
 }
 
-/* Attempts to automatically solve the Sudoku puzzle */
+/* Attempts to automatically solve the Sudoku puzzle through the cache */
 void SudokuGame::handleSolve(void)
 {
-    SudokuSolver solver;
     try {
-        if (solver.solve(board)) {
-            std::cout << "Puzzle solved successfully!\n";
+        if (session.solve(solver)) {
+            output << "Puzzle solved successfully!\n";
         } else {
-            std::cout << "This puzzle cannot be solved.\n";
+            output << "This puzzle cannot be solved.\n";
         }
     } catch (const SudokuBoardException& e) {
-        std::cout << "Solver Error: " << e.what() << std::endl;
+        output << "Solver Error: " << e.what() << std::endl;
     } 
-    board.printBoard();
+    session.getBoard().printBoard(output);
     SudokuGame::handleExit();
 }
 
+/* Undoes the newest move on the board and lets the hint engine catch up */
+void SudokuGame::handleUndo(void)
+{
+    int cell = session.undo();
+
+    if (cell < 0)
+    {
+        output << "Nothing to undo." << std::endl;
+        return;
+    }
+#ifdef SUDOKU_BUILD_ADVANCED
+    hints.sync(session.getBoard().view());
+#endif
+    output << "Undid the move at row " << cell / 9 + 1 << ", column " << cell % 9 + 1 << "." << std::endl;
+}
+
+/* Replays the last undone move */
+void SudokuGame::handleRedo(void)
+{
+    int cell = session.redo();
+
+    if (cell < 0)
+    {
+        output << "Nothing to redo." << std::endl;
+        return;
+    }
+#ifdef SUDOKU_BUILD_ADVANCED
+    hints.sync(session.getBoard().view());
+#endif
+    output << "Redid the move at row " << cell / 9 + 1 << ", column " << cell % 9 + 1 << "." << std::endl;
+}
+
+#ifdef SUDOKU_BUILD_ADVANCED
+/* Prints the next placement the hint engine finds, with its technique and
+ * the cells that justify it */
+void SudokuGame::handleHint(void)
+{
+    SudokuLogicStep step;
+
+    switch (hints.nextPlacement(step))
+    {
+        case SudokuHintStatus::Step:
+            output << "Hint (" << sudokuTechniqueName(step.technique) << "): row " << step.cell / 9 + 1
+                      << ", column " << step.cell % 9 + 1 << " is " << static_cast<int>(step.digit) << ".\n"
+                      << "Look at:";
+            for (int index = 0; index < step.patternCount; index++)
+            {
+                output << " r" << step.pattern[index] / 9 + 1 << "c" << step.pattern[index] % 9 + 1;
+            }
+            output << std::endl;
+            break;
+
+        case SudokuHintStatus::Solved:
+            output << "The board is already solved." << std::endl;
+            break;
+
+        case SudokuHintStatus::Contradiction:
+            output << "One of your moves is wrong: the board has no solution." << std::endl;
+            break;
+
+        case SudokuHintStatus::Stuck:
+            output << "No logical step found; only trial and error can go on from here." << std::endl;
+            break;
+    }
+    SudokuGame::promptContinue();
+}
+#endif
+
 /* Exits the game loop */
 void SudokuGame::handleExit(void)
 {
@@ -191,17 +346,7 @@ void SudokuGame::handleExit(void)
  */
 bool SudokuGame::isGameOver(void) const
 {
-    for (int outerLoopIndex = 1; outerLoopIndex <= 9; outerLoopIndex++)
-    {
-        for (int innerLoopIndex = 1; innerLoopIndex <= 9; innerLoopIndex++)
-        {
-            if(board.getCell(outerLoopIndex,innerLoopIndex) == 0)
-            {
-                return false;
-            }
-        }
-    } 
-    return true;
+    return session.isGameOver();
 }
 /******************************************************************************
  *  END OF FILE
@@ -14,6 +14,22 @@
   *  INCLUDES
   *============================================================================*/
  #include "SudokuBoard.hpp"
+ #include "SudokuCache.hpp"
+ #include "SudokuSession.hpp"
+ #include <iosfwd>
+ #ifdef SUDOKU_BUILD_ADVANCED
+ #include "SudokuHintEngine.hpp"
+ #endif
+
+ class SudokuSessionRecorder;
+
+ /*==============================================================================
+  *  CONSTANTS
+  *============================================================================*/
+
+ /* Solution cache entries per game: a game sees few distinct puzzles, so this
+  * keeps a game at about 180 KB of cache instead of the 11 MB default */
+ const size_t SUDOKU_GAME_CACHE_ENTRIES = 1024;
  
  /*==============================================================================
   *  CLASS DEFINITIONS
@@ -43,17 +59,48 @@
  
  /*------------------------------------------------------------------------------
   *  CLASS NAME: SudokuGame
-  *  DESCRIPTION: Handles the main game loop, user input, and board operations.
+  *  DESCRIPTION: Terminal front end of one SudokuSession: the game loop,
+  *               user input and printing. The rules live in the session.
+  *               Input and output go through the streams given at
+  *               construction, so a replay can drive the game without a
+  *               terminal.
   *----------------------------------------------------------------------------*/
  class SudokuGame 
  {
  private:
-     SudokuBoard board;   // Sudoku board object
-     bool isRunning;      // Game loop control flag
+     SudokuSession session;        // Board, history and rules of the game
+     bool isRunning;               // Game loop control flag
+     const char* cachePath;        // Solution cache file, nullptr if not persisted
+     SudokuSolutionCache cache;    // Solutions of puzzles solved so far
+     SudokuCachedSolver solver;    // Solves through the cache
+ #ifdef SUDOKU_BUILD_ADVANCED
+     SudokuHintEngine hints;       // Follows the moves to answer hints
+ #endif
+     std::istream& input;          // Menu choices and moves
+     std::ostream& output;         // Board, menu and prompts
+     std::ostream& errors;         // Error messages
+     SudokuSessionRecorder* recorder;   // Records choices and moves, nullptr if off
  
  public:
-     /* Constructor: Initializes the game */
-     SudokuGame();
+     /* Constructor: Initializes the game on the terminal, loading the
+      * solution cache from 'cachePath' if given */
+     explicit SudokuGame(const char* cachePath = nullptr);
+
+     /* Constructor: Initializes the game on the given streams */
+     SudokuGame(std::istream& input, std::ostream& output, std::ostream& errors,
+                const char* cachePath = nullptr);
+
+     /* Starts over on the preset puzzle, keeping the solution cache */
+     void newGame(void);
+
+     /* Forgets every cached solution, as if the game had just started */
+     void clearCache(void) { cache.clear(); }
+
+     /* False once the player has exited or the game has ended */
+     bool isActive(void) const { return isRunning; }
+
+     /* Records every menu choice and move attempt from now on; nullptr stops */
+     void setRecorder(SudokuSessionRecorder* recorder);
  
      /* Starts the game loop and handles user interaction */
      void run(void);
@@ -70,11 +117,23 @@
      /* Prompts the user to press enter to continue */
      char promptContinue(void) const;
  
-     /* Handles user's move input and updates the board */
+     /* Reads one move and applies it; after a rejected move the player can
+      * try again or press q to go back to the menu */
      void handleMove(void);
  
      /* Attempts to solve the current Sudoku board */
      void handleSolve(void); 
+
+     /* Takes back the last move */
+     void handleUndo(void);
+
+     /* Makes the last undone move again */
+     void handleRedo(void);
+
+ #ifdef SUDOKU_BUILD_ADVANCED
+     /* Shows the next logical placement and the technique behind it */
+     void handleHint(void);
+ #endif
  
      /* Exits the game loop and ends the session */
      void handleExit(void);
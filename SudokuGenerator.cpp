@@ -0,0 +1,284 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuGenerator
+ *  FILE         : SudokuGenerator.cpp
+ *  DESCRIPTION  : Implements random grid filling, clue removal with
+ *                 uniqueness checks and the parallel generation driver.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuGenerator.hpp"
+#include "SudokuBatch.hpp"
+#include "SudokuThreadPool.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*==============================================================================
+ *  CONSTANTS
+ *============================================================================*/
+
+namespace
+{
+    const uint64_t BLOCK_PUZZLES     = 64;   // Puzzles per pool task
+    const size_t   BLOCKS_PER_WORKER = 4;    // In-flight blocks per worker
+
+    /* A run of consecutive puzzle indices generated as one pool task */
+    struct GeneratedBlock
+    {
+        uint8_t  grids[BLOCK_PUZZLES * 81];
+        uint64_t first;    // Index of the first puzzle in the block
+        uint64_t count;
+        bool     done;     // Guarded by the driver's completion lock
+    };
+
+    /* Per-worker generator, padded so neighbours do not share a cache line */
+    struct alignas(64) WorkerGenerator
+    {
+        SudokuGenerator generator;
+    };
+
+    /* Fisher-Yates shuffle driven by SudokuRandom */
+    void shuffle(uint8_t* values, int count, SudokuRandom& random)
+    {
+        for (int index = count - 1; index > 0; index--)
+        {
+            int other = static_cast<int>(random.nextBelow(static_cast<uint32_t>(index + 1)));
+            uint8_t swap = values[index];
+            values[index] = values[other];
+            values[other] = swap;
+        }
+    }
+
+    /* Rotates a 64-bit value left */
+    inline uint64_t rotl(uint64_t value, int shift)
+    {
+        return (value << shift) | (value >> (64 - shift));
+    }
+}
+
+/*==============================================================================
+ *  SudokuRandom
+ *============================================================================*/
+
+/* Seeds the generator */
+SudokuRandom::SudokuRandom(uint64_t seed)
+{
+    SudokuRandom::seed(seed);
+}
+
+/* Expands the seed into the four state words with splitmix64 */
+void SudokuRandom::seed(uint64_t seed)
+{
+    for (int index = 0; index < 4; index++)
+    {
+        state[index] = mix(seed, static_cast<uint64_t>(index));
+    }
+}
+
+/* xoshiro256** step */
+uint64_t SudokuRandom::next(void)
+{
+    uint64_t result = rotl(state[1] * 5, 7) * 9;
+    uint64_t shifted = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = rotl(state[3], 45);
+
+    return result;
+}
+
+/* Uniform value in [0, bound) by rejection, no modulo bias */
+uint32_t SudokuRandom::nextBelow(uint32_t bound)
+{
+    uint32_t threshold = (0u - bound) % bound;
+
+    while (true)
+    {
+        uint32_t value = static_cast<uint32_t>(next() >> 32);
+        if (value >= threshold)
+        {
+            return value % bound;
+        }
+    }
+}
+
+/* splitmix64 finaliser over seed + index */
+uint64_t SudokuRandom::mix(uint64_t seed, uint64_t index)
+{
+    uint64_t value = seed + (index + 1) * 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+/*==============================================================================
+ *  SudokuGenerator
+ *============================================================================*/
+
+/* Constructor: seeds the random source */
+SudokuGenerator::SudokuGenerator(uint64_t seed) : random(seed) {}
+
+/* Re-seeds the random source */
+void SudokuGenerator::reseed(uint64_t seed)
+{
+    random.seed(seed);
+}
+
+/* Random complete grid */
+void SudokuGenerator::generateSolution(SudokuGridView grid)
+{
+    fillSolution(grid);
+}
+
+/* Random digits in the three diagonal boxes (they never constrain each
+ * other), then the solver completes the grid */
+void SudokuGenerator::fillSolution(SudokuGridView grid)
+{
+    uint8_t digits[9];
+
+    std::memset(grid.data(), 0, 81);
+    for (int box = 0; box < 3; box++)
+    {
+        for (int index = 0; index < 9; index++)
+        {
+            digits[index] = static_cast<uint8_t>(index + 1);
+        }
+        shuffle(digits, 9, random);
+
+        for (int index = 0; index < 9; index++)
+        {
+            grid.at(box * 3 + index / 3, box * 3 + index % 3) = digits[index];
+        }
+    }
+    solver.solve(grid);
+}
+
+/* Fills a grid, then removes clues in random order while the puzzle stays unique */
+int SudokuGenerator::generate(SudokuGridView puzzle, int minClues)
+{
+    uint8_t order[81];
+    int clues = 81;
+
+    fillSolution(puzzle);
+    for (int cell = 0; cell < 81; cell++)
+    {
+        order[cell] = static_cast<uint8_t>(cell);
+    }
+    shuffle(order, 81, random);
+
+    for (int index = 0; index < 81 && clues > minClues; index++)
+    {
+        int cell = order[index];
+        uint8_t value = puzzle[cell];
+
+        puzzle[cell] = 0;
+        if (solver.hasUniqueSolution(puzzle))
+        {
+            clues--;
+        }
+        else
+        {
+            puzzle[cell] = value;
+        }
+    }
+    return clues;
+}
+
+/*==============================================================================
+ *  FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Parallel generation: blocks of puzzle indices on the pool, written in order */
+double runGenerateBatch(uint64_t count, uint64_t seed, unsigned int threadCount,
+                        int minClues, SudokuSolutionWriter& writer)
+{
+    SudokuThreadPool pool(threadCount);
+    std::unique_ptr<WorkerGenerator[]> generators(new WorkerGenerator[pool.size()]);
+    std::deque<std::unique_ptr<GeneratedBlock>> inFlight;
+    std::vector<std::unique_ptr<GeneratedBlock>> spare;
+    std::mutex doneLock;
+    std::condition_variable blockDone;
+    const size_t maxInFlight = pool.size() * BLOCKS_PER_WORKER;
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Writes the oldest block once it is done, keeping output in index order
+    auto writeOldest = [&]()
+    {
+        GeneratedBlock* block = inFlight.front().get();
+        {
+            std::unique_lock<std::mutex> guard(doneLock);
+            blockDone.wait(guard, [block] { return block->done; });
+        }
+
+        for (uint64_t index = 0; index < block->count; index++)
+        {
+            writer.writeGrid(SudokuConstGridView(block->grids + index * 81));
+        }
+        spare.push_back(std::move(inFlight.front()));
+        inFlight.pop_front();
+    };
+
+    for (uint64_t first = 0; first < count; first += BLOCK_PUZZLES)
+    {
+        std::unique_ptr<GeneratedBlock> block;
+        if (spare.empty())
+        {
+            block.reset(new GeneratedBlock());
+        }
+        else
+        {
+            block = std::move(spare.back());
+            spare.pop_back();
+        }
+
+        block->first = first;
+        block->count = (count - first < BLOCK_PUZZLES) ? count - first : BLOCK_PUZZLES;
+        block->done = false;
+
+        GeneratedBlock* task = block.get();
+        inFlight.push_back(std::move(block));
+        pool.submit([task, seed, minClues, &generators, &doneLock, &blockDone](unsigned int worker)
+        {
+            SudokuGenerator& generator = generators[worker].generator;
+            for (uint64_t index = 0; index < task->count; index++)
+            {
+                generator.reseed(SudokuRandom::mix(seed, task->first + index));
+                generator.generate(SudokuGridView(task->grids + index * 81), minClues);
+            }
+
+            std::lock_guard<std::mutex> guard(doneLock);
+            task->done = true;
+            blockDone.notify_all();
+        });
+
+        while (inFlight.size() >= maxInFlight)
+        {
+            writeOldest();
+        }
+    }
+
+    while (!inFlight.empty())
+    {
+        writeOldest();
+    }
+    writer.flush();
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,97 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuGenerator
+ *  FILE         : SudokuGenerator.hpp
+ *  DESCRIPTION  : Header file for the SudokuGenerator class, which builds
+ *                 uniquely solvable puzzles by filling a random grid and then
+ *                 removing clues while the solution stays unique.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include "SudokuBoard.hpp"
+ #include "SudokuSolver.hpp"
+ #include <cstdint>
+
+ class SudokuSolutionWriter;
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuRandom
+  *  DESCRIPTION: xoshiro256** generator seeded through splitmix64. Used instead
+  *               of <random> so a seed yields the same puzzles on every
+  *               platform and standard library.
+  *----------------------------------------------------------------------------*/
+ class SudokuRandom
+ {
+ private:
+     uint64_t state[4];   // Generator state, never all zero
+
+ public:
+     /* Seeds the generator */
+     explicit SudokuRandom(uint64_t seed = 0);
+
+     /* Re-seeds the generator */
+     void seed(uint64_t seed);
+
+     /* Returns the next 64 random bits */
+     uint64_t next(void);
+
+     /* Returns a uniformly distributed value in [0, bound) */
+     uint32_t nextBelow(uint32_t bound);
+
+     /* Mixes a base seed and an index into an independent seed (splitmix64) */
+     static uint64_t mix(uint64_t seed, uint64_t index);
+ };
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuGenerator
+  *  DESCRIPTION: Generates uniquely solvable puzzles. One instance owns its
+  *               random state and solver, so use one generator per thread.
+  *----------------------------------------------------------------------------*/
+ class SudokuGenerator
+ {
+ private:
+     SudokuRandom random;   // Source of all random choices
+     SudokuSolver solver;   // Fills grids and checks uniqueness
+
+     /* Fills the grid with a random complete solution */
+     void fillSolution(SudokuGridView grid);
+
+ public:
+     /* Constructor: seeds the generator for reproducible output */
+     explicit SudokuGenerator(uint64_t seed = 0);
+
+     /* Re-seeds the generator */
+     void reseed(uint64_t seed);
+
+     /* Writes a random complete, valid grid */
+     void generateSolution(SudokuGridView grid);
+
+     /* Writes a puzzle with a unique solution and returns its clue count.
+      * Clues are removed in random order, each removal followed by a
+      * uniqueness check, until no clue can go or 'minClues' is reached. */
+     int generate(SudokuGridView puzzle, int minClues = 0);
+ };
+
+ /*==============================================================================
+  *  FUNCTION DECLARATIONS
+  *============================================================================*/
+
+ /* Generates 'count' puzzles on a work-stealing pool and writes them in order,
+  * one per line. Puzzle i is generated from SudokuRandom::mix(seed, i), so the
+  * output depends only on the seed, never on the thread count. Returns the
+  * elapsed seconds. */
+ double runGenerateBatch(uint64_t count, uint64_t seed, unsigned int threadCount,
+                         int minClues, SudokuSolutionWriter& writer);
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
@@ -0,0 +1,143 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuHintEngine
+ *  FILE         : SudokuHintEngine.cpp
+ *  DESCRIPTION  : Implements incremental hints on top of the human-technique
+ *                 solver.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuHintEngine.hpp"
+#include <cstring>
+
+/*==============================================================================
+ *  CONSTRUCTOR
+ *============================================================================*/
+
+/* Starts on an empty grid with no hint pending */
+SudokuHintEngine::SudokuHintEngine() : hasPending(false), contradiction(false), solutions(-1)
+{
+    std::memset(grid, 0, sizeof(grid));
+    std::memset(solution, 0, sizeof(solution));
+}
+
+/*==============================================================================
+ *  PUBLIC FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Full rebuild: the only path that costs more than the change itself. The
+ * solutions are counted by the next move, so a hint that needs no move
+ * does not pay for a search. */
+bool SudokuHintEngine::reset(SudokuConstGridView source)
+{
+    std::memcpy(grid, source.data(), sizeof(grid));
+    hasPending = false;
+    solutions = -1;
+    contradiction = !state.load(source);
+    return !contradiction;
+}
+
+/* Places the digit in the candidate state. A digit logic had removed from
+ * the cell cannot be part of any solution; with a unique solution, neither
+ * can any other digit than its own. Moves that passed the check leave the
+ * solution unchanged, so it is counted once per rebuild. */
+bool SudokuHintEngine::applyMove(int cell, int digit)
+{
+    if (solutions < 0)
+    {
+        solutions = solver.countSolutions(SudokuConstGridView(grid), 2);
+        if (solutions == 1)
+        {
+            solver.copySolution(SudokuGridView(solution));
+        }
+        else if (solutions == 0)
+        {
+            contradiction = true;
+        }
+    }
+
+    bool allowed = ((state.getCandidates(cell) >> (digit - 1)) & 1u) &&
+                   (solutions != 1 || solution[cell] == digit);
+
+    grid[cell] = static_cast<uint8_t>(digit);
+    hasPending = false;
+    if (!allowed)
+    {
+        contradiction = true;
+        return false;
+    }
+    state.place(cell, digit);
+    return true;
+}
+
+/* Diffs the grid against the last one seen */
+void SudokuHintEngine::sync(SudokuConstGridView source)
+{
+    for (int cell = 0; cell < 81; cell++)
+    {
+        if (grid[cell] != 0 && grid[cell] != source[cell])
+        {
+            reset(source);
+            return;
+        }
+    }
+    for (int cell = 0; cell < 81; cell++)
+    {
+        if (grid[cell] == 0 && source[cell] != 0)
+        {
+            applyMove(cell, source[cell]);
+        }
+    }
+}
+
+/* Pending placement first, otherwise the easiest technique that applies */
+SudokuHintStatus SudokuHintEngine::nextStep(SudokuLogicStep& step)
+{
+    if (contradiction || state.hasContradiction())
+    {
+        return SudokuHintStatus::Contradiction;
+    }
+    if (state.isSolved())
+    {
+        return SudokuHintStatus::Solved;
+    }
+    if (hasPending)
+    {
+        step = pending;
+        return SudokuHintStatus::Step;
+    }
+    if (!state.findStep(step))
+    {
+        return SudokuHintStatus::Stuck;
+    }
+
+    if (step.cell != SudokuLogicStep::NO_CELL)
+    {
+        pending = step;
+        hasPending = true;
+    }
+    else
+    {
+        state.applyStep(step);
+    }
+    return SudokuHintStatus::Step;
+}
+
+/* Eliminations on the way are kept, so the next call resumes after them */
+SudokuHintStatus SudokuHintEngine::nextPlacement(SudokuLogicStep& step)
+{
+    SudokuHintStatus status;
+
+    do
+    {
+        status = nextStep(step);
+    } while (status == SudokuHintStatus::Step && step.cell == SudokuLogicStep::NO_CELL);
+    return status;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
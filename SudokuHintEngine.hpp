@@ -0,0 +1,96 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuHintEngine
+ *  FILE         : SudokuHintEngine.hpp
+ *  DESCRIPTION  : Hints for a game in progress: the next logical deduction,
+ *                 with its technique and the cells behind it, computed from
+ *                 candidate state that follows the player's moves instead of
+ *                 being rebuilt for every hint. Built with BUILD_ADVANCED.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include "SudokuAdvancedChecks.hpp"
+ #include "SudokuBoard.hpp"
+ #include "SudokuSolver.hpp"
+ #include <cstdint>
+
+ /*==============================================================================
+  *  TYPE DEFINITIONS
+  *============================================================================*/
+
+ /* Outcome of a hint request */
+ enum class SudokuHintStatus : uint8_t
+ {
+     Step,            // A deduction was returned
+     Solved,          // Every cell is filled
+     Contradiction,   // A move or given rules out every solution
+     Stuck            // No technique applies (only search can go on)
+ };
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuHintEngine
+  *  DESCRIPTION: Keeps a SudokuAdvancedChecks candidate state in step with the
+  *               player's grid. A move clears its digit from 20 peers; an
+  *               elimination handed out as a hint is applied at once, so the
+  *               next hint starts where the last one stopped. A placement
+  *               hint is kept until the next move, so asking again is free.
+  *               Only clearing or changing a filled cell rebuilds the state.
+  *               The first move after a rebuild also counts the grid's
+  *               solutions; when there is exactly one, every move is checked
+  *               against it, so a wrong move is caught at once even if logic
+  *               has not ruled it out yet.
+  *----------------------------------------------------------------------------*/
+ class SudokuHintEngine
+ {
+ private:
+     SudokuAdvancedChecks state;           // Candidates after the moves and handed-out eliminations
+     uint8_t              grid[81];        // Player's grid as last seen
+     SudokuLogicStep      pending;         // Placement hint not yet acted on
+     bool                 hasPending;      // 'pending' is current
+     bool                 contradiction;   // Givens clash, no solution, or a move was wrong
+     SudokuSolver         solver;          // Counts the solutions of the rebuilt grid
+     uint8_t              solution[81];    // The only solution, when 'solutions' is 1
+     int                  solutions;       // Solutions of the rebuilt grid (up to 2), -1 until counted
+
+ public:
+     /* Constructor: starts with an empty grid */
+     SudokuHintEngine();
+
+     /* Rebuilds the candidate state from a grid, false if its digits clash */
+     bool reset(SudokuConstGridView grid);
+
+     /* Records a move into an empty cell (index row * 9 + col). Returns false
+      * if the move is a mistake: the digit differs from the unique solution,
+      * or logic had already ruled it out there. Hints then report
+      * Contradiction. On a grid with several solutions only moves logic has
+      * ruled out are caught; the others show up once they lead to a clash. */
+     bool applyMove(int cell, int digit);
+
+     /* Brings the state in line with the grid: new digits are applied as
+      * moves, a cleared or changed cell triggers a reset */
+     void sync(SudokuConstGridView grid);
+
+     /* Returns the single next deduction. Eliminations are applied before
+      * returning, so repeated calls walk through the deductions; a placement
+      * is returned again until a move is made. */
+     SudokuHintStatus nextStep(SudokuLogicStep& step);
+
+     /* Walks the deductions (applying eliminations) until one fills a cell */
+     SudokuHintStatus nextPlacement(SudokuLogicStep& step);
+
+     /* Candidate mask of a cell as the engine sees it (0 if filled) */
+     uint16_t getCandidates(int cell) const { return state.getCandidates(cell); }
+ };
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
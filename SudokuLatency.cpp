@@ -0,0 +1,151 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuLatency
+ *  FILE         : SudokuLatency.cpp
+ *  DESCRIPTION  : Implements the log-linear latency histogram.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuLatency.hpp"
+#include "SudokuBits.hpp"
+#include <cstdio>
+#include <cstring>
+
+/*==============================================================================
+ *  PRIVATE FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Values below SUB_BUCKETS get a bucket each; above, the top bit picks the
+ * power of two and the next SUB_BITS bits the bucket inside it */
+int SudokuLatencyHistogram::bucketOf(uint64_t nanoseconds)
+{
+    if (nanoseconds < static_cast<uint64_t>(SUB_BUCKETS))
+    {
+        return static_cast<int>(nanoseconds);
+    }
+
+    int top = sudokuMsb64(nanoseconds);
+    int sub = static_cast<int>((nanoseconds >> (top - SUB_BITS)) & (SUB_BUCKETS - 1));
+    return (top - SUB_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+/* Inverse of bucketOf: the last value mapped to the bucket */
+uint64_t SudokuLatencyHistogram::bucketLimit(int bucket)
+{
+    if (bucket < SUB_BUCKETS)
+    {
+        return static_cast<uint64_t>(bucket);
+    }
+
+    int top = bucket / SUB_BUCKETS + SUB_BITS - 1;
+    uint64_t sub = static_cast<uint64_t>(bucket % SUB_BUCKETS);
+    uint64_t first = (static_cast<uint64_t>(SUB_BUCKETS) + sub) << (top - SUB_BITS);
+    return first + ((uint64_t(1) << (top - SUB_BITS)) - 1);
+}
+
+/*==============================================================================
+ *  PUBLIC FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Zeroes the buckets and totals */
+SudokuLatencyHistogram::SudokuLatencyHistogram()
+{
+    clear();
+}
+
+/* Counts the sample in its bucket */
+void SudokuLatencyHistogram::record(uint64_t nanoseconds)
+{
+    counts[bucketOf(nanoseconds)]++;
+    total++;
+    sum += nanoseconds;
+    if (nanoseconds > maximum)
+    {
+        maximum = nanoseconds;
+    }
+}
+
+/* Adds the other histogram bucket by bucket */
+void SudokuLatencyHistogram::merge(const SudokuLatencyHistogram& other)
+{
+    for (int bucket = 0; bucket < BUCKETS; bucket++)
+    {
+        counts[bucket] += other.counts[bucket];
+    }
+    total += other.total;
+    sum += other.sum;
+    if (other.maximum > maximum)
+    {
+        maximum = other.maximum;
+    }
+}
+
+/* Drops all samples */
+void SudokuLatencyHistogram::clear(void)
+{
+    std::memset(counts, 0, sizeof(counts));
+    total = 0;
+    sum = 0;
+    maximum = 0;
+}
+
+/* Mean of the samples */
+double SudokuLatencyHistogram::mean(void) const
+{
+    return total ? static_cast<double>(sum) / static_cast<double>(total) : 0.0;
+}
+
+/* Walks the buckets until the requested share of samples is covered */
+uint64_t SudokuLatencyHistogram::percentile(double fraction) const
+{
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    double wanted = fraction * static_cast<double>(total);
+    uint64_t rank = (wanted <= 1.0) ? 1 : static_cast<uint64_t>(wanted + 0.999999);
+    uint64_t seen = 0;
+
+    for (int bucket = 0; bucket < BUCKETS; bucket++)
+    {
+        seen += counts[bucket];
+        if (seen >= rank)
+        {
+            uint64_t limit = bucketLimit(bucket);
+            return (limit < maximum) ? limit : maximum;
+        }
+    }
+    return maximum;
+}
+
+/*==============================================================================
+ *  FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Formats the summary as one JSON object */
+size_t formatSudokuLatency(const SudokuLatencyHistogram& histogram, char* text, size_t size)
+{
+    int written = std::snprintf(text, size,
+                                "{\"count\":%llu,\"mean_us\":%.3f,\"p50_us\":%.3f,\"p90_us\":%.3f,"
+                                "\"p99_us\":%.3f,\"max_us\":%.3f}",
+                                static_cast<unsigned long long>(histogram.count()),
+                                histogram.mean() / 1e3,
+                                histogram.percentile(0.50) / 1e3,
+                                histogram.percentile(0.90) / 1e3,
+                                histogram.percentile(0.99) / 1e3,
+                                histogram.max() / 1e3);
+
+    if (written < 0 || static_cast<size_t>(written) >= size)
+    {
+        return 0;
+    }
+    return static_cast<size_t>(written);
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
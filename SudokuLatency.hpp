@@ -0,0 +1,87 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuLatency
+ *  FILE         : SudokuLatency.hpp
+ *  DESCRIPTION  : Fixed-size log-linear latency histogram with percentile
+ *                 queries and a JSON summary, for reporting p50/p99 of
+ *                 service and replay operations.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include <cstddef>
+ #include <cstdint>
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuLatencyHistogram
+  *  DESCRIPTION: Counts samples in nanoseconds. Every power of two is split
+  *               into SUB_BUCKETS equal buckets, so a reported percentile is
+  *               within 1/SUB_BUCKETS of the true value at any scale.
+  *               Recording is a few instructions and never allocates; merge
+  *               per-thread histograms instead of sharing one.
+  *----------------------------------------------------------------------------*/
+ class SudokuLatencyHistogram
+ {
+ public:
+     static const int SUB_BITS    = 3;                            // log2 of SUB_BUCKETS
+     static const int SUB_BUCKETS = 1 << SUB_BITS;                // Buckets per power of two
+     static const int BUCKETS     = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+ private:
+     uint64_t counts[BUCKETS];   // Samples per bucket
+     uint64_t total;             // Samples recorded
+     uint64_t sum;               // Sum of the samples
+     uint64_t maximum;           // Largest sample
+
+     /* Bucket holding the value */
+     static int bucketOf(uint64_t nanoseconds);
+
+     /* Largest value that falls into the bucket */
+     static uint64_t bucketLimit(int bucket);
+
+ public:
+     /* Starts empty */
+     SudokuLatencyHistogram();
+
+     /* Adds one sample */
+     void record(uint64_t nanoseconds);
+
+     /* Adds every sample of another histogram */
+     void merge(const SudokuLatencyHistogram& other);
+
+     /* Drops all samples */
+     void clear(void);
+
+     /* Number of samples */
+     uint64_t count(void) const { return total; }
+
+     /* Largest sample, 0 if empty */
+     uint64_t max(void) const { return maximum; }
+
+     /* Mean of the samples, 0 if empty */
+     double mean(void) const;
+
+     /* Upper bound of the bucket holding the given fraction (0-1) of the
+      * samples, clamped to the largest sample; 0 if empty */
+     uint64_t percentile(double fraction) const;
+ };
+
+ /*==============================================================================
+  *  FUNCTION DECLARATIONS
+  *============================================================================*/
+
+ /* Formats count, mean, p50, p90, p99 and max (in microseconds) as one JSON
+  * object. Returns the length, or 0 if it does not fit. */
+ size_t formatSudokuLatency(const SudokuLatencyHistogram& histogram, char* text, size_t size);
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
@@ -0,0 +1,387 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuLockstep
+ *  FILE         : SudokuLockstep.cpp
+ *  DESCRIPTION  : Implements the lockstep solver: the lane-parallel
+ *                 propagation sweep and the per-lane search around it.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuLockstep.hpp"
+#include "SudokuBits.hpp"
+#include "SudokuSimd.hpp"
+#include "SudokuTables.hpp"
+#include <cstring>
+
+/* The sweep is written once as plain loops over the lanes; GCC and Clang
+ * vectorize a second copy of it for AVX2, which is picked at runtime like
+ * the SudokuSimd kernels */
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SUDOKU_LOCKSTEP_AVX2 1
+#define SUDOKU_TARGET_AVX2  __attribute__((target("avx2")))
+#define SUDOKU_SWEEP_INLINE inline __attribute__((always_inline))
+#else
+#define SUDOKU_SWEEP_INLINE inline
+#endif
+
+/*==============================================================================
+ *  SWEEP KERNELS
+ *============================================================================*/
+
+namespace
+{
+    const int LANES = SudokuLockstepSolver::LANES;
+    const int UNITS = SudokuTables::UNITS;
+    const int SIZE  = SudokuTables::SIZE;
+
+    /* All ones if the mask has more than one bit, else 0 */
+    SUDOKU_SWEEP_INLINE uint16_t multipleBits(uint16_t mask)
+    {
+        return (mask & static_cast<uint16_t>(mask - 1)) ? 0xFFFF : 0;
+    }
+
+    /* One round of naked and hidden singles on every lane. changed[lane] is
+     * nonzero if a mask of the lane shrank, failed[lane] if the lane hit a
+     * contradiction: an empty cell, a digit solved twice in a unit, a digit
+     * with no place in a unit or a cell that is the only place for two
+     * digits. Every step is the same for all lanes. */
+    SUDOKU_SWEEP_INLINE void sweepLanes(uint16_t (*masks)[LANES], uint16_t* changed, uint16_t* failed)
+    {
+        const SudokuTables& tables = SUDOKU_TABLES;
+        uint16_t solved[UNITS][LANES];
+        uint16_t grew[LANES] = {};    // Kept local so the compiler knows they
+        uint16_t broke[LANES] = {};   // do not alias the masks
+
+        // Digits already placed in each unit, and digits placed twice
+        for (int unit = 0; unit < UNITS; unit++)
+        {
+            uint16_t seen[LANES] = {};
+            for (int index = 0; index < SIZE; index++)
+            {
+                const uint16_t* cell = masks[tables.units[unit][index]];
+                for (int lane = 0; lane < LANES; lane++)
+                {
+                    uint16_t single = cell[lane] & static_cast<uint16_t>(~multipleBits(cell[lane]));
+                    broke[lane] |= seen[lane] & single;
+                    seen[lane] |= single;
+                }
+            }
+            std::memcpy(solved[unit], seen, sizeof(seen));
+        }
+
+        // Naked singles: unsolved cells lose the digits placed in their units
+        for (int cell = 0; cell < SudokuTables::CELLS; cell++)
+        {
+            const uint16_t* row = solved[tables.rowOf[cell]];
+            const uint16_t* col = solved[SIZE + tables.colOf[cell]];
+            const uint16_t* box = solved[2 * SIZE + tables.boxOf[cell]];
+            uint16_t* mask = masks[cell];
+            for (int lane = 0; lane < LANES; lane++)
+            {
+                uint16_t before = mask[lane];
+                uint16_t after = before & static_cast<uint16_t>(~((row[lane] | col[lane] | box[lane]) & multipleBits(before)));
+                grew[lane] |= before ^ after;
+                broke[lane] |= (after == 0) ? 0xFFFF : 0;
+                mask[lane] = after;
+            }
+        }
+
+        // Hidden singles: a digit with one place left in a unit goes there
+        for (int unit = 0; unit < UNITS; unit++)
+        {
+            uint16_t once[LANES] = {};
+            uint16_t twice[LANES] = {};
+            for (int index = 0; index < SIZE; index++)
+            {
+                const uint16_t* cell = masks[tables.units[unit][index]];
+                for (int lane = 0; lane < LANES; lane++)
+                {
+                    twice[lane] |= once[lane] & cell[lane];
+                    once[lane] |= cell[lane];
+                }
+            }
+            for (int lane = 0; lane < LANES; lane++)
+            {
+                broke[lane] |= (once[lane] != SUDOKU_ALL_DIGITS) ? 0xFFFF : 0;
+                once[lane] &= static_cast<uint16_t>(~twice[lane]);
+            }
+            for (int index = 0; index < SIZE; index++)
+            {
+                uint16_t* cell = masks[tables.units[unit][index]];
+                for (int lane = 0; lane < LANES; lane++)
+                {
+                    uint16_t before = cell[lane];
+                    uint16_t hidden = before & once[lane];
+                    uint16_t after = hidden | (before & ((hidden == 0) ? 0xFFFF : 0));
+                    broke[lane] |= hidden & static_cast<uint16_t>(hidden - 1);
+                    grew[lane] |= before ^ after;
+                    cell[lane] = after;
+                }
+            }
+        }
+        std::memcpy(changed, grew, sizeof(grew));
+        std::memcpy(failed, broke, sizeof(broke));
+    }
+
+    /* Sweep for the default target */
+    void sweepDefault(uint16_t (*masks)[LANES], uint16_t* changed, uint16_t* failed)
+    {
+        sweepLanes(masks, changed, failed);
+    }
+
+#ifdef SUDOKU_LOCKSTEP_AVX2
+    /* Sweep with 16 lanes per 256-bit register */
+    SUDOKU_TARGET_AVX2 void sweepAvx2(uint16_t (*masks)[LANES], uint16_t* changed, uint16_t* failed)
+    {
+        sweepLanes(masks, changed, failed);
+    }
+#endif
+}
+
+/*==============================================================================
+ *  CONSTRUCTOR
+ *============================================================================*/
+
+/* Every lane starts idle */
+SudokuLockstepSolver::SudokuLockstepSolver()
+    : guesses(new Guess[LANES * CELLS]), sweep(sweepDefault), nodesVisited(0)
+{
+#ifdef SUDOKU_LOCKSTEP_AVX2
+    if (sudokuSimdLevel() == SudokuSimdLevel::Avx2)
+    {
+        sweep = sweepAvx2;
+    }
+#endif
+    for (int lane = 0; lane < LANES; lane++)
+    {
+        idleLane(lane);
+    }
+    std::memset(solution, 0, sizeof(solution));
+}
+
+/*==============================================================================
+ *  PRIVATE FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Givens become single-digit masks, blanks allow every digit; the first
+ * sweep does the rest */
+void SudokuLockstepSolver::loadLane(int lane, uint8_t* grid, size_t index)
+{
+    lanes[lane].grid = grid;
+    lanes[lane].index = index;
+    lanes[lane].depth = 0;
+    lanes[lane].found = 0;
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        int value = grid[cell];
+        masks[cell][lane] = static_cast<uint16_t>((value >= 1 && value <= 9) ? 1u << (value - 1) : SUDOKU_ALL_DIGITS);
+    }
+    nodesVisited++;
+}
+
+/* Kept apart from loadLane: GCC 12 at -O3 turned a shared load-or-idle
+ * loop over the lanes into aligned vector stores starting at an odd lane */
+void SudokuLockstepSolver::idleLane(int lane)
+{
+    lanes[lane].grid = nullptr;
+    lanes[lane].depth = 0;
+    lanes[lane].found = 0;
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        masks[cell][lane] = SUDOKU_ALL_DIGITS;
+    }
+}
+
+/* Most constrained cell; a two-candidate cell ends the scan */
+bool SudokuLockstepSolver::guess(int lane)
+{
+    int bestCell = -1;
+    int bestCount = SIZE + 1;
+
+    for (int cell = 0; cell < CELLS && bestCount > 2; cell++)
+    {
+        int count = sudokuPopcount(masks[cell][lane]);
+        if (count > 1 && count < bestCount)
+        {
+            bestCount = count;
+            bestCell = cell;
+        }
+    }
+    if (bestCell < 0)
+    {
+        return false;
+    }
+
+    Guess& entry = guesses[lane * CELLS + lanes[lane].depth++];
+    unsigned int candidates = masks[bestCell][lane];
+    unsigned int digit = candidates & (0u - candidates);
+
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        entry.masks[cell] = masks[cell][lane];
+    }
+    entry.cell = static_cast<uint8_t>(bestCell);
+    entry.untried = static_cast<uint16_t>(candidates & ~digit);
+    masks[bestCell][lane] = static_cast<uint16_t>(digit);
+    nodesVisited++;
+    return true;
+}
+
+/* Exhausted guesses are dropped on the way down */
+bool SudokuLockstepSolver::backtrack(int lane)
+{
+    Lane& state = lanes[lane];
+
+    while (state.depth > 0)
+    {
+        Guess& entry = guesses[lane * CELLS + state.depth - 1];
+        if (entry.untried == 0)
+        {
+            state.depth--;
+            continue;
+        }
+
+        unsigned int digit = entry.untried & (0u - entry.untried);
+        entry.untried = static_cast<uint16_t>(entry.untried & ~digit);
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            masks[cell][lane] = entry.masks[cell];
+        }
+        masks[entry.cell][lane] = static_cast<uint16_t>(digit);
+        nodesVisited++;
+        return true;
+    }
+    return false;
+}
+
+/* Every mask of a solved lane has one bit */
+void SudokuLockstepSolver::writeSolution(int lane)
+{
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        lanes[lane].grid[cell] = static_cast<uint8_t>(sudokuCtz(masks[cell][lane]) + 1);
+    }
+}
+
+/*==============================================================================
+ *  PUBLIC FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Solves a copy so a grid without a solution stays as it was */
+bool SudokuLockstepSolver::solve(SudokuGridView grid)
+{
+    if (countSolutions(grid, 1) == 0)
+    {
+        return false;
+    }
+    std::memcpy(grid.data(), solution, CELLS);
+    return true;
+}
+
+/* One lane, searching into the solution buffer */
+int SudokuLockstepSolver::countSolutions(SudokuConstGridView grid, int limit)
+{
+    uint8_t* target = solution;
+    int found = 0;
+
+    std::memcpy(solution, grid.data(), CELLS);
+    solveMany(&target, 1, limit, &found);
+    return found;
+}
+
+/* Copies the stored solution */
+void SudokuLockstepSolver::copySolution(SudokuGridView grid) const
+{
+    std::memcpy(grid.data(), solution, CELLS);
+}
+
+/* Sweeps until every lane is idle. After a sweep a lane that still changed
+ * is left to the next sweep; the others either failed, are solved, or are
+ * stuck and need a guess. */
+void SudokuLockstepSolver::solveMany(uint8_t* const* grids, size_t count, int limit, int* found)
+{
+    alignas(32) uint16_t changed[LANES];
+    alignas(32) uint16_t failed[LANES];
+    size_t next = 0;
+    int busy = 0;
+
+    nodesVisited = 0;
+    for (int lane = 0; lane < LANES; lane++)
+    {
+        if (next < count)
+        {
+            loadLane(lane, grids[next], next);
+            next++;
+            busy++;
+        }
+        else
+        {
+            idleLane(lane);
+        }
+    }
+
+    while (busy > 0)
+    {
+        sweep(masks, changed, failed);
+
+        for (int lane = 0; lane < LANES; lane++)
+        {
+            Lane& state = lanes[lane];
+            if (state.grid == nullptr || (changed[lane] != 0 && failed[lane] == 0))
+            {
+                continue;
+            }
+            if (failed[lane] == 0)
+            {
+                if (guess(lane))
+                {
+                    continue;
+                }
+                if (state.found++ == 0)
+                {
+                    writeSolution(lane);
+                }
+                if (state.found < limit && backtrack(lane))
+                {
+                    continue;
+                }
+            }
+            else if (backtrack(lane))
+            {
+                continue;
+            }
+
+            // Puzzle done: report it and take the next one
+            found[state.index] = state.found;
+            if (next < count)
+            {
+                loadLane(lane, grids[next], next);
+                next++;
+            }
+            else
+            {
+                idleLane(lane);
+                busy--;
+            }
+        }
+    }
+}
+
+/* Nodes of the last solve or solveMany */
+uint64_t SudokuLockstepSolver::getNodesVisited(void) const
+{
+    return nodesVisited;
+}
+
+/* Backend name */
+const char* SudokuLockstepSolver::name(void) const
+{
+    return "lockstep";
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,123 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuLockstep
+ *  FILE         : SudokuLockstep.hpp
+ *  DESCRIPTION  : Header file for the SudokuLockstepSolver class, a 9x9
+ *                 solver backend that works on 16 puzzles at once, one per
+ *                 SIMD lane, for batch throughput.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include "SudokuSolverEngine.hpp"
+ #include <cstddef>
+ #include <cstdint>
+ #include <memory>
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuLockstepSolver
+  *  DESCRIPTION: Keeps the candidate masks of LANES puzzles as a structure of
+  *               arrays, masks[cell][lane], so one propagation sweep (naked
+  *               and hidden singles over all 27 units) runs on every lane
+  *               with the same vector instructions and no data-dependent
+  *               branches. After each sweep only the lanes that settled are
+  *               visited: a lane with a contradiction backtracks, a solved
+  *               lane hands in its solution and takes the next puzzle, any
+  *               other lane guesses on its most constrained cell. Each lane
+  *               keeps its own stack of guesses.
+  *
+  *               A sweep costs the same with one busy lane as with sixteen,
+  *               so this engine pays off in solveMany over many puzzles;
+  *               solve() and countSolutions() run a single lane.
+  *----------------------------------------------------------------------------*/
+ class SudokuLockstepSolver final : public SudokuSolverEngine
+ {
+ public:
+     static const int LANES = 16;   // Puzzles in flight, one 256-bit register of masks
+
+ private:
+     static const int CELLS = 81;
+
+     /* One guess of one lane: the lane's masks before it and the digits of
+      * the cell not tried yet */
+     struct Guess
+     {
+         uint16_t masks[CELLS];
+         uint16_t untried;
+         uint8_t  cell;
+     };
+
+     /* Puzzle a lane is working on */
+     struct Lane
+     {
+         uint8_t* grid;     // Puzzle in, first solution out; nullptr when idle
+         size_t   index;    // Position in the solveMany arguments
+         int      depth;    // Guesses on the stack
+         int      found;    // Solutions found so far
+     };
+
+     /* One propagation sweep over every lane */
+     typedef void (*SweepKernel)(uint16_t (*masks)[LANES], uint16_t* changed, uint16_t* failed);
+
+     alignas(64) uint16_t     masks[CELLS][LANES];   // Candidates of every cell in every lane
+     Lane                     lanes[LANES];
+     std::unique_ptr<Guess[]> guesses;               // CELLS guesses per lane
+     SweepKernel              sweep;                 // Widest kernel the CPU runs
+     uint8_t                  solution[CELLS];       // First solution found by the last search
+     uint64_t                 nodesVisited;          // Search nodes entered by the last search
+
+     /* Puts a puzzle into the lane */
+     void loadLane(int lane, uint8_t* grid, size_t index);
+
+     /* Marks the lane idle: every digit allowed everywhere, which a sweep
+      * leaves alone */
+     void idleLane(int lane);
+
+     /* Guesses the lowest digit of the cell with the fewest candidates;
+      * false if every cell is solved */
+     bool guess(int lane);
+
+     /* Restores the newest guess with untried digits and tries the next
+      * one; false when the lane has no guess left */
+     bool backtrack(int lane);
+
+     /* Writes the lane's solved masks into its grid */
+     void writeSolution(int lane);
+
+ public:
+     /* Constructor: allocates the guess stacks and picks the sweep kernel */
+     SudokuLockstepSolver();
+
+     /* Solves the grid in place on one lane, returns false if it has no solution */
+     bool solve(SudokuGridView grid) override;
+
+     /* Counts solutions of the grid (left unchanged), stopping at 'limit' */
+     int countSolutions(SudokuConstGridView grid, int limit) override;
+
+     /* Copies the first solution found by the last solve/count into 'grid' */
+     void copySolution(SudokuGridView grid) const override;
+
+     /* Solves the grids LANES at a time; a lane whose puzzle is done takes
+      * the next one straight away, so lanes stay busy until the last
+      * LANES puzzles */
+     void solveMany(uint8_t* const* grids, size_t count, int limit, int* found) override;
+
+     /* Number of search nodes entered by the last solve, summed over the
+      * puzzles of the last solveMany */
+     uint64_t getNodesVisited(void) const override;
+
+     /* Returns "lockstep" */
+     const char* name(void) const override;
+ };
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
@@ -0,0 +1,336 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuReplay
+ *  FILE         : SudokuReplay.cpp
+ *  DESCRIPTION  : Implements the session recorder, the recording reader and
+ *                 the parallel replay driver.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuReplay.hpp"
+#include "SudokuGame.hpp"
+#include "SudokuThreadPool.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+/*==============================================================================
+ *  CONSTANTS
+ *============================================================================*/
+
+namespace
+{
+    const char   SESSION_MARKER[] = "session";   // Line that starts a session
+    const size_t LINE_SIZE        = 256;         // Longest recording line read
+
+    typedef std::chrono::steady_clock Clock;
+
+    /* Game and scratch state of one replay worker */
+    struct ReplayWorker
+    {
+        std::istringstream     input;       // Input of the next handler call
+        std::ostream           discard;     // Sink for game output
+        SudokuGame             game;        // Reused from session to session
+        SudokuLatencyHistogram moves;
+        SudokuLatencyHistogram solves;
+        SudokuLatencyHistogram gameOvers;
+        uint64_t               events;
+
+        ReplayWorker() : discard(nullptr), game(input, discard, discard), events(0) {}
+    };
+}
+
+/*==============================================================================
+ *  EXCEPTION DEFINITIONS
+ *============================================================================*/
+
+/* Returns a generic replay error message */
+const char* SudokuReplayException::what() const noexcept
+{
+    return "Replay Error.";
+}
+
+/* Returns the open failure message */
+const char* SudokuReplayOpenException::what() const noexcept
+{
+    return "Replay Error (Cannot Open Recording).";
+}
+
+/* Returns the format failure message */
+const char* SudokuReplayFormatException::what() const noexcept
+{
+    return "Replay Error (Bad Recording Line).";
+}
+
+/*==============================================================================
+ *  HELPER FUNCTIONS
+ *============================================================================*/
+
+namespace
+{
+    /* Nanoseconds since 'start' */
+    uint64_t elapsedNanoseconds(Clock::time_point start)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+
+    /* Parses "<ms> <choice> [<row> <col> <value>]"; false if a field is
+     * missing, out of range or followed by anything else */
+    bool parseEvent(const char* line, SudokuReplayEvent& event)
+    {
+        long fields[5] = { 0, 0, 0, 0, 0 };
+        int count = 0;
+        char* end;
+
+        while (count < 5)
+        {
+            while (*line == ' ' || *line == '\t')
+            {
+                line++;
+            }
+            if (*line == '\0' || *line == '\r' || *line == '\n')
+            {
+                break;
+            }
+            fields[count] = std::strtol(line, &end, 10);
+            if (end == line || fields[count] < 0)
+            {
+                return false;
+            }
+            line = end;
+            count++;
+        }
+        while (*line == ' ' || *line == '\t' || *line == '\r' || *line == '\n')
+        {
+            line++;
+        }
+
+        bool isMove = (count == 5 && fields[1] == 1);
+        bool isChoice = (count == 2 && fields[1] != 1);
+        if (*line != '\0' || !(isMove || isChoice) || fields[0] > UINT32_MAX ||
+            fields[1] > 255 || fields[2] > 255 || fields[3] > 255 || fields[4] > 255)
+        {
+            return false;
+        }
+        event.atMilliseconds = static_cast<uint32_t>(fields[0]);
+        event.choice = static_cast<uint8_t>(fields[1]);
+        event.row = static_cast<uint8_t>(fields[2]);
+        event.col = static_cast<uint8_t>(fields[3]);
+        event.value = static_cast<uint8_t>(fields[4]);
+        return true;
+    }
+
+    /* Feeds one event to the worker's game, timing the handlers the report
+     * covers. Each handler reads a fresh input: a move followed by 'q', so
+     * a rejected move goes back to the menu as it did when recorded. */
+    void playEvent(ReplayWorker& worker, const SudokuReplayEvent& event)
+    {
+        char text[32];
+        Clock::time_point start;
+
+        worker.input.clear();
+        switch (event.choice)
+        {
+            case 1:
+                std::snprintf(text, sizeof(text), "%d %d %d\nq\n", event.row, event.col, event.value);
+                worker.input.str(text);
+                start = Clock::now();
+                worker.game.handleMove();
+                worker.moves.record(elapsedNanoseconds(start));
+                start = Clock::now();
+                worker.game.isGameOver();
+                worker.gameOvers.record(elapsedNanoseconds(start));
+                break;
+
+            case 2:
+                start = Clock::now();
+                worker.game.handleSolve();
+                worker.solves.record(elapsedNanoseconds(start));
+                start = Clock::now();
+                worker.game.isGameOver();
+                worker.gameOvers.record(elapsedNanoseconds(start));
+                break;
+
+            case 3:
+                worker.game.handleExit();
+                break;
+
+#ifdef SUDOKU_BUILD_ADVANCED
+            case 4:
+                worker.input.str("\n\n");
+                worker.game.handleHint();
+                break;
+#endif
+
+            case 5:
+                worker.game.handleUndo();
+                break;
+
+            case 6:
+                worker.game.handleRedo();
+                break;
+
+            default:
+                break;   // The menu ignores other choices
+        }
+        worker.events++;
+    }
+}
+
+/*==============================================================================
+ *  RECORDER
+ *============================================================================*/
+
+/* Every recorder appends its own session to the file */
+SudokuSessionRecorder::SudokuSessionRecorder(const char* path)
+    : file(std::fopen(path, "ab")), start(Clock::now())
+{
+    if (file == nullptr || std::fprintf(file, "%s\n", SESSION_MARKER) < 0 || std::fflush(file) != 0)
+    {
+        if (file != nullptr)
+        {
+            std::fclose(file);
+        }
+        throw SudokuReplayOpenException();
+    }
+}
+
+/* Lines are already flushed */
+SudokuSessionRecorder::~SudokuSessionRecorder()
+{
+    std::fclose(file);
+}
+
+/* Fields outside 0-255 are clamped, which keeps an out-of-range move out of
+ * range; a failed write loses the event but not the game */
+void SudokuSessionRecorder::record(int choice, int row, int col, int value)
+{
+    auto clamp = [](int field) { return (field < 0) ? 0 : (field > 255) ? 255 : field; };
+    unsigned long milliseconds = static_cast<unsigned long>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count());
+
+    if (choice == 1)
+    {
+        std::fprintf(file, "%lu 1 %d %d %d\n", milliseconds, clamp(row), clamp(col), clamp(value));
+    }
+    else
+    {
+        std::fprintf(file, "%lu %d\n", milliseconds, clamp(choice));
+    }
+    std::fflush(file);
+}
+
+/*==============================================================================
+ *  READER AND REPLAY
+ *============================================================================*/
+
+/* Line by line; blank lines and comments are skipped */
+std::vector<SudokuRecordedSession> readSudokuRecording(const char* path)
+{
+    bool fromStdin = (std::strcmp(path, "-") == 0);
+    std::FILE* file = fromStdin ? stdin : std::fopen(path, "rb");
+    std::vector<SudokuRecordedSession> sessions;
+    char line[LINE_SIZE];
+    bool badLine = false;
+
+    if (file == nullptr)
+    {
+        throw SudokuReplayOpenException();
+    }
+    while (!badLine && std::fgets(line, sizeof(line), file) != nullptr)
+    {
+        size_t skip = std::strspn(line, " \t\r\n");
+        SudokuReplayEvent event;
+
+        if (line[skip] == '\0' || line[skip] == '#')
+        {
+            continue;
+        }
+        if (std::strncmp(line + skip, SESSION_MARKER, sizeof(SESSION_MARKER) - 1) == 0)
+        {
+            sessions.emplace_back();
+            continue;
+        }
+        badLine = !parseEvent(line, event);
+        if (!badLine)
+        {
+            if (sessions.empty())
+            {
+                sessions.emplace_back();
+            }
+            sessions.back().events.push_back(event);
+        }
+    }
+    if (!fromStdin)
+    {
+        std::fclose(file);
+    }
+    if (badLine)
+    {
+        throw SudokuReplayFormatException();
+    }
+    return sessions;
+}
+
+/* One task per played session; a worker restarts its game for every task
+ * and empties its solution cache, so each session's solves cost what they
+ * would for a new player rather than hitting what earlier sessions cached.
+ * Histograms are per worker and merged once the pool is idle. */
+SudokuReplayReport replaySudokuSessions(const std::vector<SudokuRecordedSession>& sessions,
+                                        unsigned int threads, bool paced, unsigned int repeat)
+{
+    SudokuReplayReport report;
+    SudokuThreadPool pool(threads);
+    std::vector<std::unique_ptr<ReplayWorker>> workers;
+
+    for (unsigned int index = 0; index < pool.size(); index++)
+    {
+        workers.emplace_back(new ReplayWorker());
+    }
+
+    Clock::time_point start = Clock::now();
+    for (unsigned int round = 0; round < repeat; round++)
+    {
+        for (const SudokuRecordedSession& session : sessions)
+        {
+            pool.submit([&workers, &session, paced](unsigned int index)
+            {
+                ReplayWorker& worker = *workers[index];
+                Clock::time_point sessionStart = Clock::now();
+
+                worker.game.clearCache();
+                worker.game.newGame();
+                for (const SudokuReplayEvent& event : session.events)
+                {
+                    if (paced)
+                    {
+                        std::this_thread::sleep_until(sessionStart + std::chrono::milliseconds(event.atMilliseconds));
+                    }
+                    playEvent(worker, event);
+                }
+            });
+        }
+    }
+    pool.wait();
+
+    report.sessions = static_cast<uint64_t>(sessions.size()) * repeat;
+    report.events = 0;
+    report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    for (const std::unique_ptr<ReplayWorker>& worker : workers)
+    {
+        report.events += worker->events;
+        report.moves.merge(worker->moves);
+        report.solves.merge(worker->solves);
+        report.gameOvers.merge(worker->gameOvers);
+    }
+    return report;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,148 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuReplay
+ *  FILE         : SudokuReplay.hpp
+ *  DESCRIPTION  : Recorded game sessions and their replay. The interactive
+ *                 game can record each menu choice and move with its time;
+ *                 the replay driver feeds recordings back through SudokuGame
+ *                 on the work-stealing pool, at full speed or at the
+ *                 recorded pace, and times the game operations.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include "SudokuBoard.hpp"
+ #include "SudokuLatency.hpp"
+ #include <chrono>
+ #include <cstdint>
+ #include <cstdio>
+ #include <vector>
+
+ /*==============================================================================
+  *  EXCEPTION CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuReplayException
+  *  DESCRIPTION: Base class for recording and replay errors.
+  *----------------------------------------------------------------------------*/
+ class SudokuReplayException : public SudokuBoardException
+ {
+ public:
+     /* Returns a descriptive error message */
+     const char* what() const noexcept override;
+ };
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuReplayOpenException
+  *  DESCRIPTION: Thrown when a recording cannot be opened or written.
+  *----------------------------------------------------------------------------*/
+ class SudokuReplayOpenException : public SudokuReplayException
+ {
+ public:
+     /* Returns a descriptive error message */
+     const char* what() const noexcept override;
+ };
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuReplayFormatException
+  *  DESCRIPTION: Thrown when a recording line is not a valid event.
+  *----------------------------------------------------------------------------*/
+ class SudokuReplayFormatException : public SudokuReplayException
+ {
+ public:
+     /* Returns a descriptive error message */
+     const char* what() const noexcept override;
+ };
+
+ /*==============================================================================
+  *  TYPE DEFINITIONS
+  *============================================================================*/
+
+ /* One menu choice as the game's menu numbers it; row, col and value are
+  * only set for a move (choice 1) */
+ struct SudokuReplayEvent
+ {
+     uint32_t atMilliseconds;   // Time since the session started
+     uint8_t  choice;           // 1 move, 2 solve, 3 exit, 4 hint, 5 undo, 6 redo
+     uint8_t  row;
+     uint8_t  col;
+     uint8_t  value;
+ };
+
+ /* Events of one game, from the preset board */
+ struct SudokuRecordedSession
+ {
+     std::vector<SudokuReplayEvent> events;
+ };
+
+ /* Outcome of a replay */
+ struct SudokuReplayReport
+ {
+     uint64_t               sessions;    // Sessions played, repeats included
+     uint64_t               events;      // Events fed to the games
+     double                 seconds;     // Wall time of the whole replay
+     SudokuLatencyHistogram moves;       // SudokuGame::handleMove
+     SudokuLatencyHistogram solves;      // SudokuGame::handleSolve
+     SudokuLatencyHistogram gameOvers;   // SudokuGame::isGameOver, after each move and solve
+ };
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuSessionRecorder
+  *  DESCRIPTION: Appends one session to a recording file. The format is text:
+  *                 session
+  *                 <ms> <choice> [<row> <col> <value>]
+  *               one event per line, '#' starts a comment line. Every move
+  *               attempt is an event of its own, rejected ones included, so
+  *               a replay makes the same calls. Lines are flushed as they
+  *               are written.
+  *----------------------------------------------------------------------------*/
+ class SudokuSessionRecorder
+ {
+ private:
+     std::FILE*                            file;    // Recording, opened for appending
+     std::chrono::steady_clock::time_point start;   // Session start
+
+ public:
+     /* Opens the file for appending and starts a session. Throws
+      * SudokuReplayOpenException. */
+     explicit SudokuSessionRecorder(const char* path);
+
+     /* Closes the file */
+     ~SudokuSessionRecorder();
+
+     SudokuSessionRecorder(const SudokuSessionRecorder&) = delete;
+     SudokuSessionRecorder& operator=(const SudokuSessionRecorder&) = delete;
+
+     /* Writes one event stamped with the time since the session started */
+     void record(int choice, int row = 0, int col = 0, int value = 0);
+ };
+
+ /*==============================================================================
+  *  FUNCTION DECLARATIONS
+  *============================================================================*/
+
+ /* Reads every session of a recording ("-" for stdin). Events before the
+  * first "session" line form a session of their own. Throws
+  * SudokuReplayOpenException and SudokuReplayFormatException. */
+ std::vector<SudokuRecordedSession> readSudokuRecording(const char* path);
+
+ /* Plays every session 'repeat' times through SudokuGame, one game per
+  * worker (0 threads means one per hardware thread) reused from session to
+  * session. With 'paced' each event waits for its recorded time, so as many
+  * sessions run at once as there are workers; otherwise events follow each
+  * other at full speed. Game output is discarded. */
+ SudokuReplayReport replaySudokuSessions(const std::vector<SudokuRecordedSession>& sessions,
+                                         unsigned int threads, bool paced, unsigned int repeat);
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
@@ -0,0 +1,1112 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuServer
+ *  FILE         : SudokuServer.cpp
+ *  DESCRIPTION  : Implements the epoll HTTP/JSON solve service: connection
+ *                 handling, a minimal HTTP/1.1 parser, request batching,
+ *                 game sessions and the JSON responses.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuServer.hpp"
+#include "SudokuBatch.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/*==============================================================================
+ *  CONSTANTS
+ *============================================================================*/
+
+namespace
+{
+    const size_t   MAX_HEADER_BYTES = 8192;             // Request line and headers
+    const size_t   MAX_BODY_BYTES   = 65536;            // Request body
+    const size_t   READ_CHUNK       = 16384;            // Bytes requested per read
+    const int      MAX_EVENTS       = 256;              // Events taken per epoll_wait
+    const int      WAIT_MS          = 1000;             // Longest epoll_wait, so idle connections are noticed
+    const uint64_t IDLE_TIMEOUT_NS  = 30000000000ull;   // Connection closed after 30 s without traffic
+
+    /* Steady clock in nanoseconds */
+    uint64_t nowNanoseconds(void)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /* Case-insensitive comparison of 'length' bytes against a lower-case name */
+    bool equalsLower(const char* text, size_t length, const char* lower)
+    {
+        size_t index = 0;
+        for (; index < length && lower[index] != '\0'; index++)
+        {
+            char c = text[index];
+            if (c >= 'A' && c <= 'Z')
+            {
+                c = static_cast<char>(c - 'A' + 'a');
+            }
+            if (c != lower[index])
+            {
+                return false;
+            }
+        }
+        return index == length && lower[index] == '\0';
+    }
+
+    /* Finds the value of a quoted key in a flat JSON body and returns where
+     * it starts, nullptr if the key is missing */
+    const char* findJsonValue(const char* body, const char* end, const char* key)
+    {
+        size_t keyLength = std::strlen(key);
+        const char* found = std::search(body, end, key, key + keyLength);
+
+        if (found == end)
+        {
+            return nullptr;
+        }
+        const char* cursor = found + keyLength;
+        while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n'))
+        {
+            cursor++;
+        }
+        if (cursor == end || *cursor++ != ':')
+        {
+            return nullptr;
+        }
+        while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n'))
+        {
+            cursor++;
+        }
+        return cursor;
+    }
+
+    /* Reads a non-negative integer value of a key in a JSON body */
+    bool findNumberValue(const char* body, size_t length, const char* key, uint64_t& number)
+    {
+        const char* end = body + length;
+        const char* cursor = findJsonValue(body, end, key);
+
+        if (cursor == nullptr || cursor == end || *cursor < '0' || *cursor > '9')
+        {
+            return false;
+        }
+        number = 0;
+        while (cursor < end && *cursor >= '0' && *cursor <= '9')
+        {
+            number = number * 10 + static_cast<uint64_t>(*cursor++ - '0');
+        }
+        return true;
+    }
+
+    /* Finds the string value of "puzzle" in a JSON body; no escapes inside */
+    bool findPuzzleValue(const char* body, size_t length, const char*& value, size_t& valueLength)
+    {
+        const char* end = body + length;
+        const char* cursor = findJsonValue(body, end, "\"puzzle\"");
+
+        if (cursor == nullptr || cursor == end || *cursor++ != '"')
+        {
+            return false;
+        }
+        const char* close = static_cast<const char*>(std::memchr(cursor, '"', static_cast<size_t>(end - cursor)));
+        if (close == nullptr)
+        {
+            return false;
+        }
+        value = cursor;
+        valueLength = static_cast<size_t>(close - cursor);
+        return true;
+    }
+
+    /* True if no row, column or box holds a digit twice */
+    bool hasNoClash(const uint8_t grid[81])
+    {
+        unsigned int rows[9] = {};
+        unsigned int cols[9] = {};
+        unsigned int boxes[9] = {};
+
+        for (int cell = 0; cell < 81; cell++)
+        {
+            if (grid[cell] == 0)
+            {
+                continue;
+            }
+            unsigned int bit = 1u << grid[cell];
+            int row = cell / 9;
+            int col = cell % 9;
+            int box = (row / 3) * 3 + col / 3;
+            if ((rows[row] | cols[col] | boxes[box]) & bit)
+            {
+                return false;
+            }
+            rows[row] |= bit;
+            cols[col] |= bit;
+            boxes[box] |= bit;
+        }
+        return true;
+    }
+
+    /* Writes the 81 cells as digits plus a terminating zero */
+    void formatGrid(SudokuConstGridView grid, char text[82])
+    {
+        for (int cell = 0; cell < 81; cell++)
+        {
+            text[cell] = static_cast<char>('0' + grid[cell]);
+        }
+        text[81] = '\0';
+    }
+
+    /* Reason reported for a rejected move */
+    const char* placementReason(SudokuPlacementStatus status)
+    {
+        switch (status)
+        {
+            case SudokuPlacementStatus::OutOfBounds:       return "out of bounds";
+            case SudokuPlacementStatus::ValueOutOfBounds:  return "value out of bounds";
+            case SudokuPlacementStatus::CellNotEmpty:      return "cell not empty";
+            case SudokuPlacementStatus::GameRuleViolation: return "game rule";
+            case SudokuPlacementStatus::GivenCell:         return "given";
+            default:                                       return "ok";
+        }
+    }
+
+    /* Session command named by the part of the path after "/session/" */
+    bool sessionCommand(const char* name, size_t length, int& command)
+    {
+        static const char* const NAMES[] = { "new", "move", "undo", "redo", "solve", "board", "close" };
+
+        for (int index = 0; index < 7; index++)
+        {
+            if (std::strlen(NAMES[index]) == length && std::memcmp(NAMES[index], name, length) == 0)
+            {
+                command = index;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /* Status line text of an HTTP status code */
+    const char* statusText(int status)
+    {
+        switch (status)
+        {
+            case 200: return "OK";
+            case 400: return "Bad Request";
+            case 404: return "Not Found";
+            case 405: return "Method Not Allowed";
+            case 413: return "Payload Too Large";
+            case 503: return "Service Unavailable";
+            default:  return "Internal Server Error";
+        }
+    }
+}
+
+/*==============================================================================
+ *  EXCEPTION DEFINITIONS
+ *============================================================================*/
+
+/* Returns error message for a failed socket or event loop setup */
+const char* SudokuServerException::what() const noexcept
+{
+    return "Server Error (Cannot Listen On Address).";
+}
+
+/*==============================================================================
+ *  CONSTRUCTOR / DESTRUCTOR
+ *============================================================================*/
+
+/* Binds the listening socket, creates the event loop and one solver per
+ * worker plus one for solves run on the loop itself */
+SudokuServer::SudokuServer(const char* address, unsigned int threads, size_t maxSessions)
+    : listenFd(-1), epollFd(-1), wakeFd(-1), spareFd(-1), nextSweep(0), pool(threads), counters(), sessions(maxSessions),
+      running(false)
+{
+    bool isPort = address[0] != '\0' && std::strspn(address, "0123456789") == std::strlen(address);
+
+    if (isPort)
+    {
+        unsigned long port = std::strtoul(address, nullptr, 10);
+        sockaddr_in local = {};
+        local.sin_family = AF_INET;
+        local.sin_port = htons(static_cast<uint16_t>(port));
+        local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        int reuse = 1;
+
+        listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (port > 65535 || listenFd < 0 ||
+            ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+            ::bind(listenFd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0)
+        {
+            release();
+            throw SudokuServerException();
+        }
+    }
+    else
+    {
+        sockaddr_un local = {};
+        struct stat existing;
+        local.sun_family = AF_UNIX;
+
+        listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (std::strlen(address) >= sizeof(local.sun_path) || listenFd < 0)
+        {
+            release();
+            throw SudokuServerException();
+        }
+        std::strcpy(local.sun_path, address);
+        if (::lstat(address, &existing) == 0 && S_ISSOCK(existing.st_mode))
+        {
+            ::unlink(address);   // Left behind by an earlier run
+        }
+        if (::bind(listenFd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0)
+        {
+            release();
+            throw SudokuServerException();
+        }
+        unixPath = address;
+    }
+
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    spareFd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+    epoll_event listenEvent = {};
+    listenEvent.events = EPOLLIN;
+    listenEvent.data.fd = listenFd;
+    epoll_event wakeEvent = {};
+    wakeEvent.events = EPOLLIN;
+    wakeEvent.data.fd = wakeFd;
+    if (::listen(listenFd, SOMAXCONN) != 0 || epollFd < 0 || wakeFd < 0 || spareFd < 0 ||
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent) != 0 ||
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &wakeEvent) != 0)
+    {
+        release();
+        throw SudokuServerException();
+    }
+
+    for (unsigned int index = 0; index <= pool.size(); index++)
+    {
+        solvers.emplace_back(new SudokuCachedSolver(cache, false));
+    }
+}
+
+/* Closes the connections, the loop and the listening socket */
+SudokuServer::~SudokuServer()
+{
+    release();
+}
+
+/*==============================================================================
+ *  PUBLIC FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Each wake-up reads every ready connection into one batch, solves it and
+ * queues the responses, then sends them. At most once a second it also
+ * closes the connections that have gone quiet. */
+void SudokuServer::run(void)
+{
+    epoll_event events[MAX_EVENTS];
+
+    running = true;
+    while (running)
+    {
+        int ready = ::epoll_wait(epollFd, events, MAX_EVENTS, WAIT_MS);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw SudokuServerException();
+        }
+
+        uint64_t now = nowNanoseconds();
+        batch.clear();
+        touched.clear();
+
+        for (int index = 0; index < ready; index++)
+        {
+            int fd = events[index].data.fd;
+            if (fd == listenFd)
+            {
+                acceptConnections(now);
+                continue;
+            }
+            if (fd == wakeFd)
+            {
+                running = false;
+                continue;
+            }
+
+            Connection& connection = *connections[static_cast<size_t>(fd)];
+            touched.push_back(&connection);
+            if (events[index].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+            {
+                readConnection(connection, now);
+            }
+        }
+
+        if (!batch.empty())
+        {
+            counters.batches++;
+            if (batch.size() > counters.largestBatch)
+            {
+                counters.largestBatch = batch.size();
+            }
+            solveBatch();
+            for (Request& request : batch)
+            {
+                respond(request);
+            }
+        }
+
+        for (Connection* connection : touched)
+        {
+            flushConnection(*connection, now);
+        }
+
+        if (now >= nextSweep)
+        {
+            closeIdleConnections(now);
+            nextSweep = now + static_cast<uint64_t>(WAIT_MS) * 1000000;
+        }
+    }
+}
+
+/* Wakes the loop through the eventfd; write() is async-signal-safe */
+void SudokuServer::stop(void)
+{
+    uint64_t one = 1;
+    ssize_t written = ::write(wakeFd, &one, sizeof(one));
+    (void)written;
+}
+
+/*==============================================================================
+ *  PRIVATE FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Accepts until the backlog is empty; TCP sockets get TCP_NODELAY so small
+ * keep-alive responses are not held back. Out of descriptors, the spare one
+ * is given up to take the connection off the backlog and close it at once;
+ * left pending, it would wake the level-triggered loop forever. */
+void SudokuServer::acceptConnections(uint64_t now)
+{
+    while (true)
+    {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+            {
+                continue;
+            }
+            if ((errno == EMFILE || errno == ENFILE) && spareFd >= 0)
+            {
+                ::close(spareFd);
+                fd = ::accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+                if (fd >= 0)
+                {
+                    ::close(fd);
+                    counters.refused++;
+                }
+                spareFd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+                if (fd >= 0)
+                {
+                    continue;
+                }
+            }
+            return;   // EAGAIN, or an error the next wake-up will retry
+        }
+
+        int noDelay = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));   // Fails harmlessly on Unix sockets
+
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+        {
+            ::close(fd);
+            continue;
+        }
+
+        if (connections.size() <= static_cast<size_t>(fd))
+        {
+            connections.resize(static_cast<size_t>(fd) + 1);
+        }
+        connections[static_cast<size_t>(fd)].reset(new Connection{ fd, {}, 0, {}, 0, false, false, now + IDLE_TIMEOUT_NS });
+        counters.connections++;
+    }
+}
+
+/* Drains the socket, then parses as many whole requests as it holds */
+void SudokuServer::readConnection(Connection& connection, uint64_t now)
+{
+    while (!connection.closing)
+    {
+        size_t used = connection.input.size();
+        connection.input.resize(used + READ_CHUNK);
+        ssize_t received = ::read(connection.fd, connection.input.data() + used, READ_CHUNK);
+        connection.input.resize(used + (received > 0 ? static_cast<size_t>(received) : 0));
+
+        if (received > 0)
+        {
+            connection.deadline = now + IDLE_TIMEOUT_NS;
+            continue;
+        }
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+        if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        connection.closing = true;   // End of stream or error; answer what was sent
+    }
+
+    while (parseRequest(connection, now))
+    {
+    }
+
+    if (connection.inputStart == connection.input.size())
+    {
+        connection.input.clear();
+        connection.inputStart = 0;
+    }
+    else if (connection.inputStart > 0)
+    {
+        connection.input.erase(connection.input.begin(),
+                               connection.input.begin() + static_cast<std::ptrdiff_t>(connection.inputStart));
+        connection.inputStart = 0;
+    }
+}
+
+/* Parses the request line and the Content-Length and Connection headers,
+ * then routes the request. Anything it cannot resynchronize after gets an
+ * error response and closes the connection. */
+bool SudokuServer::parseRequest(Connection& connection, uint64_t now)
+{
+    static const char HEADER_END[] = "\r\n\r\n";
+    const char* begin = connection.input.data() + connection.inputStart;
+    const char* end = connection.input.data() + connection.input.size();
+
+    if (begin == end)
+    {
+        return false;
+    }
+
+    Request request;
+    request.connection = &connection;
+    request.keepAlive = false;
+    request.readAt = now;
+    request.parsed = false;
+    request.solvable = false;
+    request.hasPuzzle = false;
+    request.session = 0;
+    request.row = 0;
+    request.col = 0;
+    request.value = 0;
+
+    const char* headerEnd = std::search(begin, end, HEADER_END, HEADER_END + 4);
+    if (headerEnd == end)
+    {
+        if (static_cast<size_t>(end - begin) <= MAX_HEADER_BYTES)
+        {
+            return false;
+        }
+        request.kind = RequestKind::TooLarge;
+        connection.inputStart = connection.input.size();
+        batch.push_back(request);
+        return false;
+    }
+
+    // Request line: METHOD SP PATH SP HTTP/1.x
+    const char* lineEnd = std::search(begin, headerEnd + 2, HEADER_END, HEADER_END + 2);
+    const char* methodEnd = static_cast<const char*>(std::memchr(begin, ' ', static_cast<size_t>(lineEnd - begin)));
+    const char* pathEnd = (methodEnd == nullptr) ? nullptr :
+        static_cast<const char*>(std::memchr(methodEnd + 1, ' ', static_cast<size_t>(lineEnd - methodEnd - 1)));
+    if (pathEnd == nullptr || lineEnd - pathEnd != 9 || std::memcmp(pathEnd + 1, "HTTP/1.", 7) != 0)
+    {
+        request.kind = RequestKind::BadRequest;
+        connection.inputStart = connection.input.size();
+        batch.push_back(request);
+        return false;
+    }
+    request.keepAlive = pathEnd[8] == '1';
+
+    // Headers
+    size_t contentLength = 0;
+    bool chunked = false;
+    const char* header = lineEnd + 2;
+    while (header < headerEnd)
+    {
+        const char* next = std::search(header, headerEnd + 2, HEADER_END, HEADER_END + 2);
+        const char* colon = static_cast<const char*>(std::memchr(header, ':', static_cast<size_t>(next - header)));
+        if (colon != nullptr)
+        {
+            const char* value = colon + 1;
+            while (value < next && (*value == ' ' || *value == '\t'))
+            {
+                value++;
+            }
+            size_t nameLength = static_cast<size_t>(colon - header);
+            size_t valueLength = static_cast<size_t>(next - value);
+            while (valueLength > 0 && (value[valueLength - 1] == ' ' || value[valueLength - 1] == '\t'))
+            {
+                valueLength--;
+            }
+
+            if (equalsLower(header, nameLength, "content-length"))
+            {
+                contentLength = std::strtoul(value, nullptr, 10);
+            }
+            else if (equalsLower(header, nameLength, "transfer-encoding"))
+            {
+                chunked = true;
+            }
+            else if (equalsLower(header, nameLength, "connection"))
+            {
+                if (equalsLower(value, valueLength, "close"))
+                {
+                    request.keepAlive = false;
+                }
+                else if (equalsLower(value, valueLength, "keep-alive"))
+                {
+                    request.keepAlive = true;
+                }
+            }
+        }
+        header = next + 2;
+    }
+
+    if (chunked || contentLength > MAX_BODY_BYTES)
+    {
+        request.kind = chunked ? RequestKind::BadRequest : RequestKind::TooLarge;
+        request.keepAlive = false;
+        connection.inputStart = connection.input.size();
+        batch.push_back(request);
+        return false;
+    }
+
+    const char* body = headerEnd + 4;
+    if (static_cast<size_t>(end - body) < contentLength)
+    {
+        return false;   // Body still in flight
+    }
+    connection.inputStart = static_cast<size_t>(body + contentLength - connection.input.data());
+
+    // Routing
+    const char* path = methodEnd + 1;
+    size_t pathLength = static_cast<size_t>(pathEnd - path);
+    bool isPost = (methodEnd - begin == 4) && std::memcmp(begin, "POST", 4) == 0;
+    bool isGet = (methodEnd - begin == 3) && std::memcmp(begin, "GET", 3) == 0;
+    int command;
+
+    if (pathLength == 6 && std::memcmp(path, "/stats", 6) == 0)
+    {
+        request.kind = isGet ? RequestKind::Stats : RequestKind::NotAllowed;
+    }
+    else if (pathLength == 6 && std::memcmp(path, "/solve", 6) == 0)
+    {
+        request.kind = isPost ? RequestKind::Solve : RequestKind::NotAllowed;
+    }
+    else if (pathLength == 9 && std::memcmp(path, "/validate", 9) == 0)
+    {
+        request.kind = isPost ? RequestKind::Validate : RequestKind::NotAllowed;
+    }
+    else if (pathLength == 5 && std::memcmp(path, "/hint", 5) == 0)
+    {
+        request.kind = isPost ? RequestKind::Hint : RequestKind::NotAllowed;
+    }
+    else if (pathLength > 9 && std::memcmp(path, "/session/", 9) == 0 &&
+             sessionCommand(path + 9, pathLength - 9, command))
+    {
+        request.kind = isPost ? static_cast<RequestKind>(static_cast<int>(RequestKind::SessionNew) + command)
+                              : RequestKind::NotAllowed;
+    }
+    else
+    {
+        request.kind = RequestKind::NotFound;
+    }
+
+    if (request.kind == RequestKind::Solve || request.kind == RequestKind::Validate ||
+        request.kind == RequestKind::Hint)
+    {
+        const char* value;
+        size_t valueLength;
+        if (!findPuzzleValue(body, contentLength, value, valueLength))
+        {
+            request.kind = RequestKind::BadRequest;
+        }
+        else
+        {
+            request.parsed = valueLength == 81 && parsePuzzleLine<3>(value, valueLength, SudokuGridView(request.grid));
+            if (request.parsed)
+            {
+                std::memcpy(request.puzzle, request.grid, sizeof(request.puzzle));
+            }
+            if (request.parsed && request.kind != RequestKind::Validate)
+            {
+                solveJobs.push_back(batch.size());
+            }
+        }
+    }
+
+    else if (request.kind == RequestKind::SessionNew)
+    {
+        const char* value;
+        size_t valueLength;
+        request.hasPuzzle = findPuzzleValue(body, contentLength, value, valueLength);
+        request.parsed = !request.hasPuzzle ||
+                         (valueLength == 81 && parsePuzzleLine<3>(value, valueLength, SudokuGridView(request.grid)));
+    }
+    else if (request.kind >= RequestKind::SessionMove && request.kind <= RequestKind::SessionClose)
+    {
+        uint64_t row = 0;
+        uint64_t col = 0;
+        uint64_t value = 0;
+        bool complete = findNumberValue(body, contentLength, "\"session\"", request.session);
+        if (request.kind == RequestKind::SessionMove)
+        {
+            complete = complete && findNumberValue(body, contentLength, "\"row\"", row) &&
+                       findNumberValue(body, contentLength, "\"col\"", col) &&
+                       findNumberValue(body, contentLength, "\"value\"", value);
+            request.row = static_cast<int>(row < 100 ? row : 100);        // Out of range either way
+            request.col = static_cast<int>(col < 100 ? col : 100);
+            request.value = static_cast<int>(value < 100 ? value : 100);
+        }
+        if (!complete)
+        {
+            request.kind = RequestKind::BadRequest;
+        }
+    }
+
+    batch.push_back(request);
+    return request.keepAlive;
+}
+
+/* Small batches are solved on the loop thread; larger ones are cut into one
+ * contiguous slice per worker so each worker reuses its own solver */
+void SudokuServer::solveBatch(void)
+{
+    size_t jobs = solveJobs.size();
+    size_t workers = pool.size();
+
+    if (jobs < 2 || workers < 2)
+    {
+        SudokuCachedSolver& solver = *solvers.back();
+        for (size_t job : solveJobs)
+        {
+            batch[job].solvable = solver.solve(SudokuGridView(batch[job].grid));
+        }
+    }
+    else
+    {
+        size_t tasks = (jobs < workers) ? jobs : workers;
+        for (size_t task = 0; task < tasks; task++)
+        {
+            size_t first = jobs * task / tasks;
+            size_t last = jobs * (task + 1) / tasks;
+            pool.submit([this, first, last](unsigned int worker)
+            {
+                SudokuCachedSolver& solver = *solvers[worker];
+                for (size_t index = first; index < last; index++)
+                {
+                    Request& request = batch[solveJobs[index]];
+                    request.solvable = solver.solve(SudokuGridView(request.grid));
+                }
+            });
+        }
+        pool.wait();
+    }
+    solveJobs.clear();
+}
+
+/* Session commands touch one slot of the slab and never block, so they run
+ * on the loop thread in request order */
+int SudokuServer::playSession(const Request& request, char* body, size_t size, int& length)
+{
+    char grid[82];
+
+    if (request.kind == RequestKind::SessionNew)
+    {
+        if (!request.parsed)
+        {
+            length = std::snprintf(body, size, "{\"status\":\"invalid\"}");
+            return 200;
+        }
+        uint64_t id = sessions.create();
+        if (id == 0)
+        {
+            length = std::snprintf(body, size, "{\"error\":\"session limit reached\"}");
+            return 503;
+        }
+        SudokuSession& session = *sessions.find(id);
+        if (request.hasPuzzle && !session.load(SudokuConstGridView(request.grid)))
+        {
+            sessions.close(id);
+            length = std::snprintf(body, size, "{\"status\":\"invalid\"}");
+            return 200;
+        }
+        formatGrid(session.getBoard().view(), grid);
+        length = std::snprintf(body, size, "{\"session\":%llu,\"board\":\"%s\"}",
+                               static_cast<unsigned long long>(id), grid);
+        return 200;
+    }
+
+    SudokuSession* session = sessions.find(request.session);
+    if (session == nullptr)
+    {
+        length = std::snprintf(body, size, "{\"error\":\"no such session\"}");
+        return 404;
+    }
+
+    switch (request.kind)
+    {
+        case RequestKind::SessionMove:
+        {
+            SudokuPlacementStatus status = (request.value == 0) ? session->erase(request.row, request.col)
+                                                                : session->move(request.row, request.col, request.value);
+            if (status != SudokuPlacementStatus::Ok)
+            {
+                length = std::snprintf(body, size, "{\"status\":\"rejected\",\"reason\":\"%s\"}",
+                                       placementReason(status));
+            }
+            else
+            {
+                length = std::snprintf(body, size, "{\"status\":\"ok\",\"moves\":%u,\"solved\":%s}",
+                                       static_cast<unsigned int>(session->getMoveCount()),
+                                       session->isGameOver() ? "true" : "false");
+            }
+            break;
+        }
+
+        case RequestKind::SessionUndo:
+        case RequestKind::SessionRedo:
+        {
+            int cell = (request.kind == RequestKind::SessionUndo) ? session->undo() : session->redo();
+            if (cell < 0)
+            {
+                length = std::snprintf(body, size, "{\"status\":\"empty\"}");
+            }
+            else
+            {
+                length = std::snprintf(body, size, "{\"status\":\"ok\",\"row\":%d,\"col\":%d,\"value\":%d}",
+                                       cell / 9 + 1, cell % 9 + 1, session->getBoard().view()[cell]);
+            }
+            break;
+        }
+
+        case RequestKind::SessionSolve:
+            if (!session->solve(*solvers.back()))
+            {
+                length = std::snprintf(body, size, "{\"status\":\"unsolvable\"}");
+                break;
+            }
+            formatGrid(session->getBoard().view(), grid);
+            length = std::snprintf(body, size, "{\"status\":\"solved\",\"board\":\"%s\"}", grid);
+            break;
+
+        case RequestKind::SessionClose:
+            sessions.close(request.session);
+            length = std::snprintf(body, size, "{\"status\":\"closed\"}");
+            break;
+
+        default:
+            formatGrid(session->getBoard().view(), grid);
+            length = std::snprintf(body, size, "{\"board\":\"%s\",\"moves\":%u,\"solved\":%s}", grid,
+                                   static_cast<unsigned int>(session->getMoveCount()),
+                                   session->isGameOver() ? "true" : "false");
+            break;
+    }
+    return 200;
+}
+
+/* Builds the JSON body for the request and appends the full response */
+void SudokuServer::respond(Request& request)
+{
+    Connection& connection = *request.connection;
+    char body[512];
+    int status = 200;
+    int length = 0;
+
+    switch (request.kind)
+    {
+        case RequestKind::Solve:
+            if (!request.parsed)
+            {
+                length = std::snprintf(body, sizeof(body), "{\"status\":\"invalid\"}");
+            }
+            else if (!request.solvable)
+            {
+                length = std::snprintf(body, sizeof(body), "{\"status\":\"unsolvable\"}");
+            }
+            else
+            {
+                char solution[82];
+                for (int cell = 0; cell < 81; cell++)
+                {
+                    solution[cell] = static_cast<char>('0' + request.grid[cell]);
+                }
+                solution[81] = '\0';
+                length = std::snprintf(body, sizeof(body), "{\"status\":\"solved\",\"solution\":\"%s\"}", solution);
+            }
+            break;
+
+        case RequestKind::Validate:
+            if (!request.parsed)
+            {
+                length = std::snprintf(body, sizeof(body), "{\"status\":\"invalid\"}");
+            }
+            else
+            {
+                bool consistent = hasNoClash(request.grid);
+                bool complete = std::memchr(request.grid, 0, sizeof(request.grid)) == nullptr;
+                length = std::snprintf(body, sizeof(body), "{\"status\":\"%s\",\"complete\":%s,\"solved\":%s}",
+                                       consistent ? "valid" : "clash", complete ? "true" : "false",
+                                       (consistent && complete) ? "true" : "false");
+            }
+            break;
+
+        case RequestKind::Hint:
+        {
+            const void* empty = request.parsed ? std::memchr(request.puzzle, 0, sizeof(request.puzzle)) : nullptr;
+            if (!request.parsed)
+            {
+                length = std::snprintf(body, sizeof(body), "{\"status\":\"invalid\"}");
+            }
+            else if (!request.solvable)
+            {
+                length = std::snprintf(body, sizeof(body), "{\"status\":\"unsolvable\"}");
+            }
+            else if (empty == nullptr)
+            {
+                length = std::snprintf(body, sizeof(body), "{\"status\":\"complete\"}");
+            }
+            else
+            {
+                // The next logical placement if there is one, else a cell of the solution
+                int cell = static_cast<int>(static_cast<const uint8_t*>(empty) - request.puzzle);
+                const char* technique = "Solver";
+#ifdef SUDOKU_BUILD_ADVANCED
+                SudokuLogicStep step;
+                hints.reset(SudokuConstGridView(request.puzzle));
+                if (hints.nextPlacement(step) == SudokuHintStatus::Step)
+                {
+                    cell = step.cell;
+                    technique = sudokuTechniqueName(step.technique);
+                }
+#endif
+                length = std::snprintf(body, sizeof(body),
+                                       "{\"status\":\"hint\",\"technique\":\"%s\",\"row\":%d,\"col\":%d,\"value\":%d}",
+                                       technique, cell / 9 + 1, cell % 9 + 1, request.grid[cell]);
+            }
+            break;
+        }
+
+        case RequestKind::Stats:
+        {
+            char latency[192];
+            SudokuCacheStats cacheStats = cache.stats();
+            if (formatSudokuLatency(counters.latency, latency, sizeof(latency)) == 0)
+            {
+                latency[0] = '\0';
+            }
+            length = std::snprintf(body, sizeof(body),
+                                   "{\"connections\":%llu,\"refused\":%llu,\"timed_out\":%llu,\"requests\":%llu,"
+                                   "\"batches\":%llu,\"largest_batch\":%llu,\"sessions\":%llu,\"cache_hits\":%llu,\"cache_misses\":%llu,\"latency\":%s}",
+                                   static_cast<unsigned long long>(counters.connections),
+                                   static_cast<unsigned long long>(counters.refused),
+                                   static_cast<unsigned long long>(counters.timedOut),
+                                   static_cast<unsigned long long>(counters.requests),
+                                   static_cast<unsigned long long>(counters.batches),
+                                   static_cast<unsigned long long>(counters.largestBatch),
+                                   static_cast<unsigned long long>(sessions.size()),
+                                   static_cast<unsigned long long>(cacheStats.hits),
+                                   static_cast<unsigned long long>(cacheStats.misses),
+                                   latency[0] ? latency : "{}");
+            break;
+        }
+
+        case RequestKind::SessionNew:
+        case RequestKind::SessionMove:
+        case RequestKind::SessionUndo:
+        case RequestKind::SessionRedo:
+        case RequestKind::SessionSolve:
+        case RequestKind::SessionBoard:
+        case RequestKind::SessionClose:
+            status = playSession(request, body, sizeof(body), length);
+            break;
+
+        case RequestKind::BadRequest:
+            status = 400;
+            length = std::snprintf(body, sizeof(body), "{\"error\":\"bad request\"}");
+            break;
+
+        case RequestKind::NotFound:
+            status = 404;
+            length = std::snprintf(body, sizeof(body), "{\"error\":\"not found\"}");
+            break;
+
+        case RequestKind::NotAllowed:
+            status = 405;
+            length = std::snprintf(body, sizeof(body), "{\"error\":\"method not allowed\"}");
+            break;
+
+        case RequestKind::TooLarge:
+            status = 413;
+            length = std::snprintf(body, sizeof(body), "{\"error\":\"request too large\"}");
+            break;
+    }
+
+    char head[160];
+    int headLength = std::snprintf(head, sizeof(head),
+                                   "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\n"
+                                   "Content-Length: %d\r\nConnection: %s\r\n\r\n",
+                                   status, statusText(status), length, request.keepAlive ? "keep-alive" : "close");
+    connection.output.append(head, static_cast<size_t>(headLength));
+    connection.output.append(body, static_cast<size_t>(length));
+    if (!request.keepAlive)
+    {
+        connection.closing = true;   // Later pipelined requests are dropped
+        connection.input.clear();
+        connection.inputStart = 0;
+    }
+
+    counters.requests++;
+    counters.latency.record(nowNanoseconds() - request.readAt);
+}
+
+/* Sends until the socket is full; leftovers wait for EPOLLOUT */
+bool SudokuServer::flushConnection(Connection& connection, uint64_t now)
+{
+    while (connection.outputSent < connection.output.size())
+    {
+        ssize_t sent = ::send(connection.fd, connection.output.data() + connection.outputSent,
+                              connection.output.size() - connection.outputSent, MSG_NOSIGNAL);
+        if (sent > 0)
+        {
+            connection.outputSent += static_cast<size_t>(sent);
+            connection.deadline = now + IDLE_TIMEOUT_NS;
+            continue;
+        }
+        if (sent < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            if (!connection.writeArmed)
+            {
+                epoll_event event = {};
+                event.events = connection.closing ? EPOLLOUT : (EPOLLIN | EPOLLOUT);
+                event.data.fd = connection.fd;
+                ::epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+                connection.writeArmed = true;
+            }
+            return true;
+        }
+        closeConnection(connection);   // Peer is gone
+        return false;
+    }
+
+    connection.output.clear();
+    connection.outputSent = 0;
+    if (connection.closing)
+    {
+        closeConnection(connection);
+        return false;
+    }
+    if (connection.writeArmed)
+    {
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = connection.fd;
+        ::epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.writeArmed = false;
+    }
+    return true;
+}
+
+/* Closes every descriptor this server owns and removes the socket file;
+ * safe to call twice */
+void SudokuServer::release(void)
+{
+    for (std::unique_ptr<Connection>& connection : connections)
+    {
+        if (connection)
+        {
+            ::close(connection->fd);
+            connection.reset();
+        }
+    }
+    if (wakeFd >= 0)
+    {
+        ::close(wakeFd);
+        wakeFd = -1;
+    }
+    if (epollFd >= 0)
+    {
+        ::close(epollFd);
+        epollFd = -1;
+    }
+    if (listenFd >= 0)
+    {
+        ::close(listenFd);
+        listenFd = -1;
+    }
+    if (spareFd >= 0)
+    {
+        ::close(spareFd);
+        spareFd = -1;
+    }
+    if (!unixPath.empty())
+    {
+        ::unlink(unixPath.c_str());
+        unixPath.clear();
+    }
+}
+
+/* Drops the connections past their deadline: clients holding a slot with a
+ * half-sent request, idle keep-alives, and peers that stopped reading */
+void SudokuServer::closeIdleConnections(uint64_t now)
+{
+    for (std::unique_ptr<Connection>& connection : connections)
+    {
+        if (connection && connection->deadline <= now)
+        {
+            closeConnection(*connection);
+            counters.timedOut++;
+        }
+    }
+}
+
+/* Closing the descriptor also removes it from the epoll set */
+void SudokuServer::closeConnection(Connection& connection)
+{
+    int fd = connection.fd;
+
+    ::close(fd);
+    connections[static_cast<size_t>(fd)].reset();
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,231 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuServer
+ *  FILE         : SudokuServer.hpp
+ *  DESCRIPTION  : Embedded HTTP/JSON solve and game service for local
+ *                 clients. One epoll loop serves keep-alive connections on a
+ *                 localhost TCP port or a Unix socket; the requests read in
+ *                 one wake-up are solved as a batch on the work-stealing
+ *                 pool, and game sessions are played on the loop thread.
+ *                 Linux only (built with BUILD_SERVER).
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include "SudokuBoard.hpp"
+ #include "SudokuCache.hpp"
+ #include "SudokuLatency.hpp"
+ #include "SudokuSession.hpp"
+ #include "SudokuSolver.hpp"
+ #include "SudokuThreadPool.hpp"
+ #ifdef SUDOKU_BUILD_ADVANCED
+ #include "SudokuHintEngine.hpp"
+ #endif
+ #include <cstddef>
+ #include <cstdint>
+ #include <memory>
+ #include <string>
+ #include <vector>
+
+ /*==============================================================================
+  *  EXCEPTION CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuServerException
+  *  DESCRIPTION: Thrown when the listening socket or the event loop cannot be
+  *               set up.
+  *----------------------------------------------------------------------------*/
+ class SudokuServerException : public SudokuBoardException
+ {
+ public:
+     /* Returns a descriptive error message */
+     const char* what() const noexcept override;
+ };
+
+ /*==============================================================================
+  *  TYPE DEFINITIONS
+  *============================================================================*/
+
+ /* Counters since the server started */
+ struct SudokuServerStats
+ {
+     uint64_t               connections;   // Connections accepted
+     uint64_t               refused;       // Connections closed unread, out of descriptors
+     uint64_t               timedOut;      // Connections closed for 30 s without traffic
+     uint64_t               requests;      // Requests answered, errors included
+     uint64_t               batches;       // Event loop wake-ups that answered requests
+     uint64_t               largestBatch;  // Most requests answered in one wake-up
+     SudokuLatencyHistogram latency;       // Time from reading a request to queuing its response
+ };
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuServer
+  *  DESCRIPTION: Answers
+  *                 POST /solve     {"puzzle":"<81 chars>"}  -> solution
+  *                 POST /validate  {"puzzle":"<81 chars>"}  -> clashes, completeness
+  *                 POST /hint      {"puzzle":"<81 chars>"}  -> next placement and technique
+  *                 GET  /stats                              -> counters and latency
+  *               and hosts game sessions that outlive connections:
+  *                 POST /session/new    {["puzzle":"<81 chars>"]}        -> session ID and board
+  *                 POST /session/move   {"session":ID,"row":R,"col":C,"value":V}
+  *                                                          (V = 0 clears the cell)
+  *                 POST /session/undo   {"session":ID}    and /session/redo
+  *                 POST /session/solve  {"session":ID}    -> solved board
+  *                 POST /session/board  {"session":ID}    -> board, move count
+  *                 POST /session/close  {"session":ID}
+  *               Every request read in one wake-up of the loop joins one
+  *               batch; its solves go through one shared solution cache
+  *               (exact puzzles only) and are split over the pool, then the
+  *               responses are queued in request order on each connection,
+  *               with session commands applied as they are answered.
+  *               HTTP/1.1 connections stay open unless the client asks to
+  *               close them or 30 s pass without traffic. Not thread-safe
+  *               except for stop().
+  *----------------------------------------------------------------------------*/
+ class SudokuServer
+ {
+ private:
+     /* What a parsed request asks for */
+     enum class RequestKind : uint8_t
+     {
+         Solve,
+         Validate,
+         Hint,
+         Stats,
+         SessionNew,
+         SessionMove,
+         SessionUndo,
+         SessionRedo,
+         SessionSolve,
+         SessionBoard,
+         SessionClose,
+         BadRequest,
+         NotFound,
+         NotAllowed,
+         TooLarge
+     };
+
+     /* One client connection and its buffers */
+     struct Connection
+     {
+         int               fd;            // Socket
+         std::vector<char> input;         // Bytes read and not yet parsed
+         size_t            inputStart;    // Start of the unparsed bytes
+         std::string       output;        // Responses not yet sent
+         size_t            outputSent;    // Bytes of 'output' already sent
+         bool              closing;       // Close once 'output' is sent
+         bool              writeArmed;    // EPOLLOUT is registered
+         uint64_t          deadline;      // Steady clock (ns) at which it is closed unless traffic moves it on
+     };
+
+     /* One request of the current batch */
+     struct Request
+     {
+         Connection*  connection;   // Where the response goes
+         RequestKind  kind;         // Endpoint, or the error to report
+         bool         keepAlive;    // Connection stays open after the response
+         uint64_t     readAt;       // Steady clock (ns) when the request was read
+         bool         parsed;       // Body held a well-formed puzzle
+         bool         solvable;     // Solve result
+         bool         hasPuzzle;    // Body named a puzzle (optional for /session/new)
+         uint64_t     session;      // Session ID of a session command
+         int          row;          // Move coordinates and value
+         int          col;
+         int          value;
+         uint8_t      grid[81];     // Puzzle, replaced by the solution
+         uint8_t      puzzle[81];   // Puzzle as sent (for hints)
+     };
+
+     int                                              listenFd;     // Listening socket
+     int                                              epollFd;      // Event loop
+     int                                              wakeFd;       // eventfd written by stop()
+     int                                              spareFd;      // /dev/null, given up to shed a connection when descriptors run out
+     uint64_t                                         nextSweep;    // Steady clock (ns) of the next idle check
+     std::string                                      unixPath;     // Socket file to remove, if any
+     std::vector<std::unique_ptr<Connection>>         connections;  // Indexed by descriptor
+     std::vector<Request>                             batch;        // Requests of the current wake-up
+     std::vector<Connection*>                         touched;      // Connections with events this wake-up
+     std::vector<size_t>                              solveJobs;    // Batch indices that need a solve
+     SudokuThreadPool                                 pool;         // Solves large batches
+     SudokuSolutionCache                              cache;        // Solutions of /solve and /session/solve, shared
+     std::vector<std::unique_ptr<SudokuCachedSolver>> solvers;      // One per worker, plus one for the loop
+     SudokuServerStats                                counters;     // Reported by /stats and stats()
+     SudokuSessionManager                             sessions;     // Game sessions, on the loop thread
+ #ifdef SUDOKU_BUILD_ADVANCED
+     SudokuHintEngine                                 hints;        // Logical hints, on the loop thread
+ #endif
+     bool                                             running;      // Cleared by the wake descriptor
+
+     /* Accepts every pending connection */
+     void acceptConnections(uint64_t now);
+
+     /* Reads what the socket holds and parses the complete requests into the
+      * batch; marks the connection for closing if the peer has gone away */
+     void readConnection(Connection& connection, uint64_t now);
+
+     /* Parses one request at the front of the input into the batch, false
+      * if it is not complete yet */
+     bool parseRequest(Connection& connection, uint64_t now);
+
+     /* Runs the solves of the batch, on the pool when there are several */
+     void solveBatch(void);
+
+     /* Runs a session command and writes its JSON body; returns the HTTP status */
+     int playSession(const Request& request, char* body, size_t size, int& length);
+
+     /* Appends the HTTP response for the request to its connection */
+     void respond(Request& request);
+
+     /* Sends pending output; arms or disarms EPOLLOUT as needed. Returns
+      * false once the connection has been closed. */
+     bool flushConnection(Connection& connection, uint64_t now);
+
+     /* Closes every descriptor, for the destructor and failed construction */
+     void release(void);
+
+     /* Closes the connections whose deadline has passed */
+     void closeIdleConnections(uint64_t now);
+
+     /* Unregisters, closes and forgets the connection */
+     void closeConnection(Connection& connection);
+
+ public:
+     /* Sessions open at once unless the caller asks otherwise */
+     static constexpr size_t DEFAULT_MAX_SESSIONS = 1 << 20;
+
+     /* Listens on 127.0.0.1:<port> if 'address' is a number, otherwise on a
+      * Unix socket at that path. 0 threads means one per hardware thread.
+      * Throws SudokuServerException. */
+     SudokuServer(const char* address, unsigned int threads, size_t maxSessions = DEFAULT_MAX_SESSIONS);
+
+     /* Closes every connection and the listening socket */
+     ~SudokuServer();
+
+     SudokuServer(const SudokuServer&) = delete;
+     SudokuServer& operator=(const SudokuServer&) = delete;
+
+     /* Serves requests until stop() is called */
+     void run(void);
+
+     /* Makes run() return; safe to call from a signal handler */
+     void stop(void);
+
+     /* Counters and latency so far */
+     const SudokuServerStats& stats(void) const { return counters; }
+
+     /* Game sessions hosted by the server */
+     const SudokuSessionManager& sessionManager(void) const { return sessions; }
+ };
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
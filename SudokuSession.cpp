@@ -0,0 +1,193 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuSession
+ *  FILE         : SudokuSession.cpp
+ *  DESCRIPTION  : Implements game sessions and the session slab.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuSession.hpp"
+#include <cstring>
+
+/*==============================================================================
+ *  SESSION
+ *============================================================================*/
+
+/* The board constructor sets up the preset puzzle */
+SudokuSession::SudokuSession() : moveCount(0)
+{
+    markGivens();
+}
+
+/* One bit per filled cell */
+void SudokuSession::markGivens(void)
+{
+    SudokuConstGridView grid = board.view();
+
+    givens.reset();
+    for (int cell = 0; cell < SudokuBoard::CELLS; cell++)
+    {
+        givens[cell] = grid.data()[cell] != 0;
+    }
+}
+
+/* Fresh board, empty history */
+void SudokuSession::reset(void)
+{
+    board = SudokuBoard();
+    markGivens();
+    moveCount = 0;
+}
+
+/* Checks the puzzle on a scratch board first so a bad one changes nothing */
+bool SudokuSession::load(SudokuConstGridView puzzle)
+{
+    SudokuBoard loaded;
+
+    std::memcpy(loaded.view().data(), puzzle.data(), SudokuBoard::CELLS);
+    loaded.rebuildMasks();
+    if (!loaded.isConsistent())
+    {
+        return false;
+    }
+    board = loaded;
+    markGivens();
+    moveCount = 0;
+    return true;
+}
+
+/* Counts the move only if the board took it */
+SudokuPlacementStatus SudokuSession::move(int row, int col, int value)
+{
+    SudokuPlacementStatus status = board.tryPlace(row, col, value);
+    if (status == SudokuPlacementStatus::Ok)
+    {
+        moveCount++;
+    }
+    return status;
+}
+
+/* Clearing an empty cell is accepted but not counted; givens stay */
+SudokuPlacementStatus SudokuSession::erase(int row, int col)
+{
+    if (row < 1 || row > SudokuBoard::SIZE || col < 1 || col > SudokuBoard::SIZE)
+    {
+        return SudokuPlacementStatus::OutOfBounds;
+    }
+
+    int cell = (row - 1) * SudokuBoard::SIZE + (col - 1);
+    if (givens[cell])
+    {
+        return SudokuPlacementStatus::GivenCell;
+    }
+
+    bool filled = board.getCell(row, col) > 0;
+    SudokuPlacementStatus status = board.tryClear(row, col);
+    if (status == SudokuPlacementStatus::Ok && filled)
+    {
+        moveCount++;
+    }
+    return status;
+}
+
+/* Board history does the work */
+int SudokuSession::undo(void)
+{
+    return board.undoMove();
+}
+
+/* Board history does the work */
+int SudokuSession::redo(void)
+{
+    return board.redoMove();
+}
+
+/* Solved means full and consistent */
+bool SudokuSession::isGameOver(void) const
+{
+    return board.isSolved();
+}
+
+/*==============================================================================
+ *  SESSION MANAGER
+ *============================================================================*/
+
+/* Storage comes chunk by chunk as sessions are opened */
+SudokuSessionManager::SudokuSessionManager(size_t limit) : limit(limit), live(0)
+{
+}
+
+/* Reuses the last closed slot, else takes the next one, adding a chunk when
+ * the current one is full */
+uint64_t SudokuSessionManager::create(void)
+{
+    uint32_t slot;
+
+    if (live >= limit)
+    {
+        return 0;
+    }
+    if (!freeSlots.empty())
+    {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        chunks[slot / SESSIONS_PER_CHUNK][slot % SESSIONS_PER_CHUNK].reset();
+    }
+    else
+    {
+        slot = static_cast<uint32_t>(generations.size());
+        if (slot % SESSIONS_PER_CHUNK == 0)
+        {
+            chunks.emplace_back(new SudokuSession[SESSIONS_PER_CHUNK]);
+        }
+        generations.push_back(0);
+    }
+
+    uint32_t generation = ++generations[slot];   // Now odd: live
+    live++;
+    return (static_cast<uint64_t>(generation) << 32) | slot;
+}
+
+/* A live slot whose generation matches the ID */
+SudokuSession* SudokuSessionManager::find(uint64_t id)
+{
+    uint32_t slot = static_cast<uint32_t>(id);
+    uint32_t generation = static_cast<uint32_t>(id >> 32);
+
+    if (slot >= generations.size() || generations[slot] != generation || (generation & 1u) == 0)
+    {
+        return nullptr;
+    }
+    return &chunks[slot / SESSIONS_PER_CHUNK][slot % SESSIONS_PER_CHUNK];
+}
+
+/* Bumping the generation to even retires every copy of the ID */
+bool SudokuSessionManager::close(uint64_t id)
+{
+    if (find(id) == nullptr)
+    {
+        return false;
+    }
+
+    uint32_t slot = static_cast<uint32_t>(id);
+    generations[slot]++;
+    freeSlots.push_back(slot);
+    live--;
+    return true;
+}
+
+/* Whole chunks plus the vectors' allocations */
+size_t SudokuSessionManager::bytesReserved(void) const
+{
+    return chunks.size() * SESSIONS_PER_CHUNK * sizeof(SudokuSession) +
+           chunks.capacity() * sizeof(chunks[0]) +
+           generations.capacity() * sizeof(uint32_t) +
+           freeSlots.capacity() * sizeof(uint32_t);
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
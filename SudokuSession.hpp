@@ -0,0 +1,136 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuSession
+ *  FILE         : SudokuSession.hpp
+ *  DESCRIPTION  : Game state and rules of one player, driven by commands and
+ *                 free of terminal I/O, and the slab that hosts many of them
+ *                 in one process.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include "SudokuBoard.hpp"
+ #include <bitset>
+ #include <cstddef>
+ #include <cstdint>
+ #include <memory>
+ #include <vector>
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuSession
+  *  DESCRIPTION: One game: the board with its move history and a move
+  *               counter. Every command returns its outcome instead of
+  *               printing or throwing, so the same session serves the
+  *               terminal game and the network service. Rows, columns and
+  *               values are 1-based as on SudokuBoard. The cells filled when
+  *               the puzzle was set up are givens and cannot be cleared.
+  *----------------------------------------------------------------------------*/
+ class SudokuSession
+ {
+ private:
+     SudokuBoard                      board;       // Board and its undo history
+     std::bitset<SudokuBoard::CELLS>  givens;      // Cells filled by reset or load
+     uint32_t                         moveCount;   // Placements and clears accepted
+
+     /* Marks the filled cells of the board as givens */
+     void markGivens(void);
+
+ public:
+     /* Constructor: starts on the preset puzzle */
+     SudokuSession();
+
+     /* Starts over on the preset puzzle */
+     void reset(void);
+
+     /* Starts over on the given puzzle. Returns false, leaving the session
+      * as it was, if a value is above 9 or a digit repeats in a unit. */
+     bool load(SudokuConstGridView puzzle);
+
+     /* Places a digit in an empty cell; anything but Ok leaves the board unchanged */
+     SudokuPlacementStatus move(int row, int col, int value);
+
+     /* Empties a cell; GivenCell for a given of the puzzle, OutOfBounds for
+      * a cell off the board */
+     SudokuPlacementStatus erase(int row, int col);
+
+     /* Takes back the last move, returning its cell index or -1 */
+     int undo(void);
+
+     /* Makes the last undone move again, returning its cell index or -1 */
+     int redo(void);
+
+     /* Fills the board with the solution from any solver that solves a
+      * SudokuBoard (SudokuSolver, SudokuCachedSolver). Moves made before
+      * stay undoable and the givens stay as they were. Returns false,
+      * leaving board and history untouched, if the board has no solution. */
+     template <class Solver>
+     bool solve(Solver& solver) { return solver.solve(board); }
+
+     /* True once every cell is filled without a clash */
+     bool isGameOver(void) const;
+
+     /* Placements and clears accepted since the last reset or load */
+     uint32_t getMoveCount(void) const { return moveCount; }
+
+     /* Read-only access for display */
+     const SudokuBoard& getBoard(void) const { return board; }
+ };
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuSessionManager
+  *  DESCRIPTION: Hosts up to 'limit' sessions in fixed chunks of
+  *               SESSIONS_PER_CHUNK that are allocated as the count grows and
+  *               never moved, so a session costs sizeof(SudokuSession) plus a
+  *               4-byte generation whether it is idle or busy. Closed slots
+  *               are reused. An ID carries the slot in its low 32 bits and
+  *               the slot's generation in the high 32, so the ID of a closed
+  *               session never reaches the session that reuses its slot. Not
+  *               thread-safe.
+  *----------------------------------------------------------------------------*/
+ class SudokuSessionManager
+ {
+ public:
+     static constexpr size_t SESSIONS_PER_CHUNK = 1024;
+
+ private:
+     std::vector<std::unique_ptr<SudokuSession[]>> chunks;        // Session storage
+     std::vector<uint32_t>                         generations;   // Per slot; odd while the slot is live
+     std::vector<uint32_t>                         freeSlots;     // Closed slots, reused last closed first
+     size_t                                        limit;         // Most sessions open at once
+     size_t                                        live;          // Sessions open now
+
+ public:
+     /* Constructor: allows up to 'limit' open sessions; allocates nothing yet */
+     explicit SudokuSessionManager(size_t limit);
+
+     /* Opens a session on the preset puzzle and returns its ID (never 0),
+      * or 0 when 'limit' sessions are already open */
+     uint64_t create(void);
+
+     /* The session with this ID, nullptr if it is closed or never existed */
+     SudokuSession* find(uint64_t id);
+
+     /* Closes the session, false if the ID is not live */
+     bool close(uint64_t id);
+
+     /* Sessions open now */
+     size_t size(void) const { return live; }
+
+     /* Most sessions that can be open at once */
+     size_t capacity(void) const { return limit; }
+
+     /* Bytes held by the slab, its generations and its free list */
+     size_t bytesReserved(void) const;
+ };
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
@@ -0,0 +1,699 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuSimd
+ *  FILE         : SudokuSimd.cpp
+ *  DESCRIPTION  : Implements the scalar, SSE4.2 and AVX2 grid kernels and
+ *                 the runtime dispatch between them.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuSimd.hpp"
+#include "SudokuTables.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SUDOKU_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+/* GCC and Clang compile each vector kernel for its own instruction set, so
+ * the rest of the build keeps the default target; MSVC needs no flags */
+#if defined(SUDOKU_HAVE_X86_SIMD) && (defined(__GNUC__) || defined(__clang__))
+#define SUDOKU_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define SUDOKU_TARGET_AVX2  __attribute__((target("avx2")))
+#else
+#define SUDOKU_TARGET_SSE42
+#define SUDOKU_TARGET_AVX2
+#endif
+
+/*==============================================================================
+ *  CONSTANTS
+ *============================================================================*/
+
+namespace
+{
+    const size_t BATCH_GRIDS = 16;   // Grids per pass of the batch kernels
+
+    /* Kernel set of one level */
+    struct SimdKernels
+    {
+        void (*candidates)(const uint8_t* cells, uint16_t* candidates);
+        bool (*validate)(const uint8_t* cells);
+        void (*validateBatch)(const uint8_t* grids, size_t count, bool* valid);
+    };
+}
+
+/*==============================================================================
+ *  SCALAR KERNELS
+ *============================================================================*/
+
+namespace
+{
+    /* Bit d-1 for digit d, 0 for blanks and values above 9 */
+    inline unsigned int digitBit(uint8_t value)
+    {
+        return (value >= 1 && value <= 9) ? 1u << (value - 1) : 0u;
+    }
+
+    /* Row, column and box masks of the grid */
+    void scalarUnitMasks(const uint8_t* cells, unsigned int rowMask[9], unsigned int colMask[9],
+                         unsigned int boxMask[9])
+    {
+        for (int unit = 0; unit < 9; unit++)
+        {
+            rowMask[unit] = 0;
+            colMask[unit] = 0;
+            boxMask[unit] = 0;
+        }
+        for (int row = 0; row < 9; row++)
+        {
+            for (int col = 0; col < 9; col++)
+            {
+                unsigned int bit = digitBit(cells[9 * row + col]);
+                rowMask[row] |= bit;
+                colMask[col] |= bit;
+                boxMask[(row / 3) * 3 + col / 3] |= bit;
+            }
+        }
+    }
+
+    void scalarCandidates(const uint8_t* cells, uint16_t* candidates)
+    {
+        unsigned int rowMask[9], colMask[9], boxMask[9];
+
+        scalarUnitMasks(cells, rowMask, colMask, boxMask);
+        for (int row = 0; row < 9; row++)
+        {
+            for (int col = 0; col < 9; col++)
+            {
+                int cell = 9 * row + col;
+                unsigned int used = rowMask[row] | colMask[col] | boxMask[(row / 3) * 3 + col / 3];
+                candidates[cell] = cells[cell] ? 0 : static_cast<uint16_t>(~used & SUDOKU_ALL_DIGITS);
+            }
+        }
+    }
+
+    /* Nine cells whose bits OR to all nine digits hold each digit once */
+    bool scalarValidate(const uint8_t* cells)
+    {
+        unsigned int rowMask[9], colMask[9], boxMask[9];
+        unsigned int complete = SUDOKU_ALL_DIGITS;
+
+        scalarUnitMasks(cells, rowMask, colMask, boxMask);
+        for (int unit = 0; unit < 9; unit++)
+        {
+            complete &= rowMask[unit] & colMask[unit] & boxMask[unit];
+        }
+        return complete == SUDOKU_ALL_DIGITS;
+    }
+
+    void scalarValidateBatch(const uint8_t* grids, size_t count, bool* valid)
+    {
+        for (size_t index = 0; index < count; index++)
+        {
+            valid[index] = scalarValidate(grids + index * 81);
+        }
+    }
+}
+
+#ifdef SUDOKU_HAVE_X86_SIMD
+
+/*==============================================================================
+ *  SSE4.2 KERNELS
+ *============================================================================*/
+
+/*
+ * Single-grid layout: a row is spread over 16-bit lanes in three groups of
+ * four, one group per box (columns 0-2 in lanes 0-2, 3-5 in lanes 4-6, 6-8
+ * in lanes 8-10, every other lane zero). Column masks are then a vertical OR
+ * of the rows, box masks an OR inside each group of four and row masks an
+ * OR across the register. With SSE a row takes two registers (boxes 0-1 and
+ * box 2), with AVX2 one.
+ */
+
+namespace
+{
+    /* Runs a 16-grid kernel over the batch; the last partial group is padded
+     * with blank grids whose results are dropped */
+    void validateInGroups(const uint8_t* grids, size_t count, bool* valid,
+                          unsigned int (*validateGroup)(const uint8_t* grids))
+    {
+        size_t index = 0;
+        for (; index + BATCH_GRIDS <= count; index += BATCH_GRIDS)
+        {
+            unsigned int passed = validateGroup(grids + index * 81);
+            for (size_t lane = 0; lane < BATCH_GRIDS; lane++)
+            {
+                valid[index + lane] = (passed >> lane) & 1u;
+            }
+        }
+
+        if (index < count)
+        {
+            uint8_t tail[BATCH_GRIDS * 81] = {};
+            std::memcpy(tail, grids + index * 81, (count - index) * 81);
+
+            unsigned int passed = validateGroup(tail);
+            for (size_t lane = 0; index + lane < count; lane++)
+            {
+                valid[index + lane] = (passed >> lane) & 1u;
+            }
+        }
+    }
+
+    /* Loads row 'row' of an 81-cell grid padded to 96 bytes, one byte per
+     * lane of the box-group layout */
+    SUDOKU_TARGET_SSE42 inline __m128i sseLoadRow(const uint8_t* padded, int row)
+    {
+        const __m128i spread = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, -1, -1, -1, -1);
+        return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(padded + 9 * row)), spread);
+    }
+
+    /* Low and high byte of 1 << (value - 1) for 16 byte values (0 for blanks
+     * and values above 9) */
+    SUDOKU_TARGET_SSE42 inline void sseDigitBits(__m128i values, __m128i& low, __m128i& high)
+    {
+        const __m128i lowTable = _mm_setr_epi8(0, 1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0);
+        const __m128i highTable = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+        __m128i index = _mm_min_epu8(values, _mm_set1_epi8(10));
+
+        low = _mm_shuffle_epi8(lowTable, index);
+        high = _mm_shuffle_epi8(highTable, index);
+    }
+
+    /* ORs each group of four 16-bit lanes into all four lanes */
+    SUDOKU_TARGET_SSE42 inline __m128i sseGroupOr(__m128i masks)
+    {
+        masks = _mm_or_si128(masks, _mm_shuffle_epi32(masks, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_or_si128(masks, _mm_or_si128(_mm_slli_epi32(masks, 16), _mm_srli_epi32(masks, 16)));
+    }
+
+    /* ORs all eight 16-bit lanes into every lane */
+    SUDOKU_TARGET_SSE42 inline __m128i sseHorizontalOr(__m128i masks)
+    {
+        return sseGroupOr(_mm_or_si128(masks, _mm_shuffle_epi32(masks, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+
+    /* Stores the nine cells of a row from the box-group layout */
+    SUDOKU_TARGET_SSE42 inline void sseStoreRow(uint16_t* out, __m128i boxes01, __m128i box2)
+    {
+        const __m128i pack = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1);
+        __m128i packed = _mm_or_si128(_mm_shuffle_epi8(boxes01, pack), _mm_slli_si128(box2, 12));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+        out[8] = static_cast<uint16_t>(_mm_extract_epi16(box2, 2));
+    }
+
+    SUDOKU_TARGET_SSE42 void sseCandidates(const uint8_t* cells, uint16_t* candidates)
+    {
+        alignas(16) uint8_t padded[96] = {};
+        __m128i bits01[9], bits2[9], empty01[9], empty2[9];
+        __m128i col01 = _mm_setzero_si128();
+        __m128i col2 = _mm_setzero_si128();
+        const __m128i allDigits = _mm_set1_epi16(SUDOKU_ALL_DIGITS);
+
+        std::memcpy(padded, cells, 81);
+        for (int row = 0; row < 9; row++)
+        {
+            __m128i values = sseLoadRow(padded, row);
+            __m128i empty = _mm_cmpeq_epi8(values, _mm_setzero_si128());
+            __m128i low, high;
+
+            sseDigitBits(values, low, high);
+            bits01[row] = _mm_unpacklo_epi8(low, high);
+            bits2[row] = _mm_unpackhi_epi8(low, high);
+            empty01[row] = _mm_unpacklo_epi8(empty, empty);
+            empty2[row] = _mm_unpackhi_epi8(empty, empty);
+            col01 = _mm_or_si128(col01, bits01[row]);
+            col2 = _mm_or_si128(col2, bits2[row]);
+        }
+
+        for (int band = 0; band < 9; band += 3)
+        {
+            __m128i box01 = sseGroupOr(_mm_or_si128(_mm_or_si128(bits01[band], bits01[band + 1]), bits01[band + 2]));
+            __m128i box2 = sseGroupOr(_mm_or_si128(_mm_or_si128(bits2[band], bits2[band + 1]), bits2[band + 2]));
+
+            for (int row = band; row < band + 3; row++)
+            {
+                __m128i rowMask = sseHorizontalOr(_mm_or_si128(bits01[row], bits2[row]));
+                __m128i used01 = _mm_or_si128(rowMask, _mm_or_si128(col01, box01));
+                __m128i used2 = _mm_or_si128(rowMask, _mm_or_si128(col2, box2));
+
+                sseStoreRow(candidates + 9 * row,
+                            _mm_and_si128(_mm_andnot_si128(used01, allDigits), empty01[row]),
+                            _mm_and_si128(_mm_andnot_si128(used2, allDigits), empty2[row]));
+            }
+        }
+    }
+
+    SUDOKU_TARGET_SSE42 bool sseValidate(const uint8_t* cells)
+    {
+        alignas(16) uint8_t padded[96] = {};
+        const __m128i allDigits = _mm_set1_epi16(SUDOKU_ALL_DIGITS);
+        __m128i col01 = _mm_setzero_si128();
+        __m128i col2 = _mm_setzero_si128();
+        __m128i ok01 = _mm_set1_epi16(-1);
+        __m128i ok2 = _mm_set1_epi16(-1);
+
+        std::memcpy(padded, cells, 81);
+        for (int band = 0; band < 9; band += 3)
+        {
+            __m128i box01 = _mm_setzero_si128();
+            __m128i box2 = _mm_setzero_si128();
+
+            for (int row = band; row < band + 3; row++)
+            {
+                __m128i low, high;
+                sseDigitBits(sseLoadRow(padded, row), low, high);
+
+                __m128i bits01 = _mm_unpacklo_epi8(low, high);
+                __m128i bits2 = _mm_unpackhi_epi8(low, high);
+                __m128i rowMask = sseHorizontalOr(_mm_or_si128(bits01, bits2));
+
+                ok01 = _mm_and_si128(ok01, _mm_cmpeq_epi16(rowMask, allDigits));
+                col01 = _mm_or_si128(col01, bits01);
+                col2 = _mm_or_si128(col2, bits2);
+                box01 = _mm_or_si128(box01, bits01);
+                box2 = _mm_or_si128(box2, bits2);
+            }
+            ok01 = _mm_and_si128(ok01, _mm_cmpeq_epi16(sseGroupOr(box01), allDigits));
+            ok2 = _mm_and_si128(ok2, _mm_cmpeq_epi16(sseGroupOr(box2), allDigits));
+        }
+        ok01 = _mm_and_si128(ok01, _mm_cmpeq_epi16(col01, allDigits));
+        ok2 = _mm_and_si128(ok2, _mm_cmpeq_epi16(col2, allDigits));
+
+        // Only the lanes holding columns count: 0-2 and 4-6, then 0-2
+        return (_mm_movemask_epi8(ok01) & 0x3F3F) == 0x3F3F && (_mm_movemask_epi8(ok2) & 0x003F) == 0x003F;
+    }
+
+    /* In-register transpose of a 16x16 byte matrix: four rounds of pairing
+     * row i with row i+8 */
+    SUDOKU_TARGET_SSE42 inline void sseTranspose16(__m128i rows[16])
+    {
+        __m128i mixed[16];
+
+        for (int round = 0; round < 4; round++)
+        {
+            for (int index = 0; index < 8; index++)
+            {
+                mixed[2 * index] = _mm_unpacklo_epi8(rows[index], rows[index + 8]);
+                mixed[2 * index + 1] = _mm_unpackhi_epi8(rows[index], rows[index + 8]);
+            }
+            for (int index = 0; index < 16; index++)
+            {
+                rows[index] = mixed[index];
+            }
+        }
+    }
+
+    /* Lane layout for the batch kernels: byte g of cells[cell] is that cell
+     * of grid g, for 16 grids stored back to back */
+    SUDOKU_TARGET_SSE42 void sseTransposeGrids(const uint8_t* grids, __m128i cells[81])
+    {
+        alignas(16) uint8_t lastCell[BATCH_GRIDS];
+
+        for (int start = 0; start < 80; start += 16)
+        {
+            __m128i block[16];
+            for (size_t grid = 0; grid < BATCH_GRIDS; grid++)
+            {
+                block[grid] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(grids + grid * 81 + start));
+            }
+            sseTranspose16(block);
+            for (int index = 0; index < 16; index++)
+            {
+                cells[start + index] = block[index];
+            }
+        }
+
+        for (size_t grid = 0; grid < BATCH_GRIDS; grid++)
+        {
+            lastCell[grid] = grids[grid * 81 + 80];
+        }
+        cells[80] = _mm_load_si128(reinterpret_cast<const __m128i*>(lastCell));
+    }
+
+    /* Validates 16 grids, 8 per register half; bit g of the result is grid g */
+    SUDOKU_TARGET_SSE42 unsigned int sseValidateGroup(const uint8_t* grids)
+    {
+        __m128i cells[81];
+        __m128i colLow[9], colHigh[9];
+        __m128i boxLow[3] = {}, boxHigh[3] = {};   // Cleared again every third row
+        const __m128i allDigits = _mm_set1_epi16(SUDOKU_ALL_DIGITS);
+        __m128i okLow = _mm_set1_epi16(-1);
+        __m128i okHigh = _mm_set1_epi16(-1);
+
+        sseTransposeGrids(grids, cells);
+        for (int col = 0; col < 9; col++)
+        {
+            colLow[col] = _mm_setzero_si128();
+            colHigh[col] = _mm_setzero_si128();
+        }
+
+        for (int row = 0; row < 9; row++)
+        {
+            __m128i rowLow = _mm_setzero_si128();
+            __m128i rowHigh = _mm_setzero_si128();
+
+            if (row % 3 == 0)
+            {
+                for (int box = 0; box < 3; box++)
+                {
+                    boxLow[box] = _mm_setzero_si128();
+                    boxHigh[box] = _mm_setzero_si128();
+                }
+            }
+
+            for (int col = 0; col < 9; col++)
+            {
+                __m128i low, high;
+                sseDigitBits(cells[9 * row + col], low, high);
+
+                __m128i bitsLow = _mm_unpacklo_epi8(low, high);
+                __m128i bitsHigh = _mm_unpackhi_epi8(low, high);
+
+                rowLow = _mm_or_si128(rowLow, bitsLow);
+                rowHigh = _mm_or_si128(rowHigh, bitsHigh);
+                colLow[col] = _mm_or_si128(colLow[col], bitsLow);
+                colHigh[col] = _mm_or_si128(colHigh[col], bitsHigh);
+                boxLow[col / 3] = _mm_or_si128(boxLow[col / 3], bitsLow);
+                boxHigh[col / 3] = _mm_or_si128(boxHigh[col / 3], bitsHigh);
+            }
+            okLow = _mm_and_si128(okLow, _mm_cmpeq_epi16(rowLow, allDigits));
+            okHigh = _mm_and_si128(okHigh, _mm_cmpeq_epi16(rowHigh, allDigits));
+
+            if (row % 3 == 2)
+            {
+                for (int box = 0; box < 3; box++)
+                {
+                    okLow = _mm_and_si128(okLow, _mm_cmpeq_epi16(boxLow[box], allDigits));
+                    okHigh = _mm_and_si128(okHigh, _mm_cmpeq_epi16(boxHigh[box], allDigits));
+                }
+            }
+        }
+
+        for (int col = 0; col < 9; col++)
+        {
+            okLow = _mm_and_si128(okLow, _mm_cmpeq_epi16(colLow[col], allDigits));
+            okHigh = _mm_and_si128(okHigh, _mm_cmpeq_epi16(colHigh[col], allDigits));
+        }
+        return static_cast<unsigned int>(_mm_movemask_epi8(_mm_packs_epi16(okLow, okHigh)));
+    }
+
+    void sseValidateBatch(const uint8_t* grids, size_t count, bool* valid)
+    {
+        validateInGroups(grids, count, valid, sseValidateGroup);
+    }
+}
+
+/*==============================================================================
+ *  AVX2 KERNELS
+ *============================================================================*/
+
+namespace
+{
+    /* Widens 16 digit-bit byte pairs to 16-bit lanes */
+    SUDOKU_TARGET_AVX2 inline __m256i avxDigitBits(__m128i values)
+    {
+        __m128i low, high;
+
+        sseDigitBits(values, low, high);
+        return _mm256_or_si256(_mm256_cvtepu8_epi16(low), _mm256_slli_epi16(_mm256_cvtepu8_epi16(high), 8));
+    }
+
+    /* ORs each group of four 16-bit lanes into all four lanes */
+    SUDOKU_TARGET_AVX2 inline __m256i avxGroupOr(__m256i masks)
+    {
+        masks = _mm256_or_si256(masks, _mm256_shuffle_epi32(masks, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm256_or_si256(masks, _mm256_or_si256(_mm256_slli_epi32(masks, 16), _mm256_srli_epi32(masks, 16)));
+    }
+
+    /* ORs all sixteen 16-bit lanes into every lane */
+    SUDOKU_TARGET_AVX2 inline __m256i avxHorizontalOr(__m256i masks)
+    {
+        masks = _mm256_or_si256(masks, _mm256_permute2x128_si256(masks, masks, 1));
+        return avxGroupOr(_mm256_or_si256(masks, _mm256_shuffle_epi32(masks, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+
+    SUDOKU_TARGET_AVX2 void avxCandidates(const uint8_t* cells, uint16_t* candidates)
+    {
+        alignas(16) uint8_t padded[96] = {};
+        __m256i bits[9], empty[9];
+        __m256i col = _mm256_setzero_si256();
+        const __m256i allDigits = _mm256_set1_epi16(SUDOKU_ALL_DIGITS);
+
+        std::memcpy(padded, cells, 81);
+        for (int row = 0; row < 9; row++)
+        {
+            __m128i values = sseLoadRow(padded, row);
+
+            bits[row] = avxDigitBits(values);
+            empty[row] = _mm256_cvtepi8_epi16(_mm_cmpeq_epi8(values, _mm_setzero_si128()));
+            col = _mm256_or_si256(col, bits[row]);
+        }
+
+        for (int band = 0; band < 9; band += 3)
+        {
+            __m256i box = avxGroupOr(_mm256_or_si256(_mm256_or_si256(bits[band], bits[band + 1]), bits[band + 2]));
+
+            for (int row = band; row < band + 3; row++)
+            {
+                __m256i used = _mm256_or_si256(avxHorizontalOr(bits[row]), _mm256_or_si256(col, box));
+                __m256i result = _mm256_and_si256(_mm256_andnot_si256(used, allDigits), empty[row]);
+
+                sseStoreRow(candidates + 9 * row, _mm256_castsi256_si128(result), _mm256_extracti128_si256(result, 1));
+            }
+        }
+    }
+
+    SUDOKU_TARGET_AVX2 bool avxValidate(const uint8_t* cells)
+    {
+        alignas(16) uint8_t padded[96] = {};
+        const __m256i allDigits = _mm256_set1_epi16(SUDOKU_ALL_DIGITS);
+        __m256i col = _mm256_setzero_si256();
+        __m256i ok = _mm256_set1_epi16(-1);
+
+        std::memcpy(padded, cells, 81);
+        for (int band = 0; band < 9; band += 3)
+        {
+            __m256i box = _mm256_setzero_si256();
+
+            for (int row = band; row < band + 3; row++)
+            {
+                __m256i bits = avxDigitBits(sseLoadRow(padded, row));
+
+                ok = _mm256_and_si256(ok, _mm256_cmpeq_epi16(avxHorizontalOr(bits), allDigits));
+                col = _mm256_or_si256(col, bits);
+                box = _mm256_or_si256(box, bits);
+            }
+            ok = _mm256_and_si256(ok, _mm256_cmpeq_epi16(avxGroupOr(box), allDigits));
+        }
+        ok = _mm256_and_si256(ok, _mm256_cmpeq_epi16(col, allDigits));
+
+        // Only the lanes holding columns count: 0-2, 4-6 and 8-10
+        return (static_cast<unsigned int>(_mm256_movemask_epi8(ok)) & 0x3F3F3Fu) == 0x3F3F3Fu;
+    }
+
+    /* Validates 16 grids, one per 16-bit lane; bit g of the result is grid g */
+    SUDOKU_TARGET_AVX2 unsigned int avxValidateGroup(const uint8_t* grids)
+    {
+        __m128i cells[81];
+        __m256i colMask[9];
+        __m256i boxMask[3] = {};   // Cleared again every third row
+        const __m256i allDigits = _mm256_set1_epi16(SUDOKU_ALL_DIGITS);
+        __m256i ok = _mm256_set1_epi16(-1);
+
+        sseTransposeGrids(grids, cells);
+        for (int col = 0; col < 9; col++)
+        {
+            colMask[col] = _mm256_setzero_si256();
+        }
+
+        for (int row = 0; row < 9; row++)
+        {
+            __m256i rowMask = _mm256_setzero_si256();
+
+            if (row % 3 == 0)
+            {
+                for (int box = 0; box < 3; box++)
+                {
+                    boxMask[box] = _mm256_setzero_si256();
+                }
+            }
+
+            for (int col = 0; col < 9; col++)
+            {
+                __m256i bits = avxDigitBits(cells[9 * row + col]);
+
+                rowMask = _mm256_or_si256(rowMask, bits);
+                colMask[col] = _mm256_or_si256(colMask[col], bits);
+                boxMask[col / 3] = _mm256_or_si256(boxMask[col / 3], bits);
+            }
+            ok = _mm256_and_si256(ok, _mm256_cmpeq_epi16(rowMask, allDigits));
+
+            if (row % 3 == 2)
+            {
+                for (int box = 0; box < 3; box++)
+                {
+                    ok = _mm256_and_si256(ok, _mm256_cmpeq_epi16(boxMask[box], allDigits));
+                }
+            }
+        }
+
+        for (int col = 0; col < 9; col++)
+        {
+            ok = _mm256_and_si256(ok, _mm256_cmpeq_epi16(colMask[col], allDigits));
+        }
+        __m128i flags = _mm_packs_epi16(_mm256_castsi256_si128(ok), _mm256_extracti128_si256(ok, 1));
+        return static_cast<unsigned int>(_mm_movemask_epi8(flags));
+    }
+
+    void avxValidateBatch(const uint8_t* grids, size_t count, bool* valid)
+    {
+        validateInGroups(grids, count, valid, avxValidateGroup);
+    }
+}
+
+#endif
+
+/*==============================================================================
+ *  DISPATCH
+ *============================================================================*/
+
+namespace
+{
+    /* Kernels indexed by SudokuSimdLevel */
+    const SimdKernels KERNELS[] =
+    {
+        { scalarCandidates, scalarValidate, scalarValidateBatch },
+#ifdef SUDOKU_HAVE_X86_SIMD
+        { sseCandidates, sseValidate, sseValidateBatch },
+        { avxCandidates, avxValidate, avxValidateBatch }
+#else
+        { scalarCandidates, scalarValidate, scalarValidateBatch },
+        { scalarCandidates, scalarValidate, scalarValidateBatch }
+#endif
+    };
+
+    /* Queries the CPU (and, for AVX, the OS register support) */
+    SudokuSimdLevel detectSimdLevel(void)
+    {
+#if defined(SUDOKU_HAVE_X86_SIMD) && defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        bool sse42 = (info[2] & (1 << 20)) != 0;
+        bool avxUsable = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 &&
+                         (_xgetbv(0) & 0x6) == 0x6;
+        bool avx2 = false;
+        if (maxLeaf >= 7)
+        {
+            __cpuidex(info, 7, 0);
+            avx2 = avxUsable && (info[1] & (1 << 5)) != 0;
+        }
+
+        if (avx2)
+        {
+            return SudokuSimdLevel::Avx2;
+        }
+        if (sse42)
+        {
+            return SudokuSimdLevel::Sse42;
+        }
+#elif defined(SUDOKU_HAVE_X86_SIMD)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return SudokuSimdLevel::Avx2;
+        }
+        if (__builtin_cpu_supports("sse4.2"))
+        {
+            return SudokuSimdLevel::Sse42;
+        }
+#endif
+        return SudokuSimdLevel::Scalar;
+    }
+
+    /* Kernels for the requested level, capped at what the CPU supports */
+    const SimdKernels& kernelsFor(SudokuSimdLevel level)
+    {
+        SudokuSimdLevel best = sudokuSimdLevel();
+        return KERNELS[static_cast<int>(level < best ? level : best)];
+    }
+}
+
+/*==============================================================================
+ *  FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Detects the level once */
+SudokuSimdLevel sudokuSimdLevel(void)
+{
+    static const SudokuSimdLevel level = detectSimdLevel();
+    return level;
+}
+
+/* Level name for reports */
+const char* sudokuSimdLevelName(SudokuSimdLevel level)
+{
+    switch (level)
+    {
+        case SudokuSimdLevel::Avx2:
+        return "avx2";
+
+        case SudokuSimdLevel::Sse42:
+        return "sse4.2";
+
+        case SudokuSimdLevel::Scalar:
+        break;
+    }
+    return "scalar";
+}
+
+/* Candidate masks at the detected level */
+void computeSudokuCandidates(SudokuConstGridView grid, uint16_t candidates[81])
+{
+    kernelsFor(SudokuSimdLevel::Avx2).candidates(grid.data(), candidates);
+}
+
+/* Single-grid validation at the detected level */
+bool isValidSudokuSolution(SudokuConstGridView grid)
+{
+    return kernelsFor(SudokuSimdLevel::Avx2).validate(grid.data());
+}
+
+/* Batch validation at the detected level */
+void validateSudokuSolutions(const uint8_t* grids, size_t count, bool* valid)
+{
+    kernelsFor(SudokuSimdLevel::Avx2).validateBatch(grids, count, valid);
+}
+
+/* Candidate masks at a fixed level */
+void computeSudokuCandidates(SudokuConstGridView grid, uint16_t candidates[81], SudokuSimdLevel level)
+{
+    kernelsFor(level).candidates(grid.data(), candidates);
+}
+
+/* Single-grid validation at a fixed level */
+bool isValidSudokuSolution(SudokuConstGridView grid, SudokuSimdLevel level)
+{
+    return kernelsFor(level).validate(grid.data());
+}
+
+/* Batch validation at a fixed level */
+void validateSudokuSolutions(const uint8_t* grids, size_t count, bool* valid, SudokuSimdLevel level)
+{
+    kernelsFor(level).validateBatch(grids, count, valid);
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,64 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuSimd
+ *  FILE         : SudokuSimd.hpp
+ *  DESCRIPTION  : Whole-grid kernels for the 9x9 board: every candidate mask
+ *                 in one pass, validation of a complete grid and validation
+ *                 of many grids at once. Each kernel has AVX2, SSE4.2 and
+ *                 portable scalar versions; the best one the CPU supports is
+ *                 picked at runtime.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include "SudokuBoard.hpp"
+ #include <cstddef>
+ #include <cstdint>
+
+ /*==============================================================================
+  *  TYPE DEFINITIONS
+  *============================================================================*/
+
+ /* Instruction sets the kernels are written for, slowest first */
+ enum class SudokuSimdLevel : uint8_t
+ {
+     Scalar,   // Portable C++, one cell at a time
+     Sse42,    // 128-bit registers, 8 masks per register
+     Avx2      // 256-bit registers, 16 masks per register
+ };
+
+ /*==============================================================================
+  *  FUNCTION DECLARATIONS
+  *============================================================================*/
+
+ /* Best level supported by this CPU and build, detected on first use */
+ SudokuSimdLevel sudokuSimdLevel(void);
+
+ /* Short level name ("scalar", "sse4.2" or "avx2") */
+ const char* sudokuSimdLevelName(SudokuSimdLevel level);
+
+ /* Writes the candidate mask of every cell in row-major order: bit d-1 for
+  * each digit d not yet used in the cell's row, column or box, 0 for filled
+  * cells. Values above 9 count as filled but block no digit. */
+ void computeSudokuCandidates(SudokuConstGridView grid, uint16_t candidates[81]);
+
+ /* True if every row, column and box holds the digits 1-9 exactly once */
+ bool isValidSudokuSolution(SudokuConstGridView grid);
+
+ /* Validates 'count' grids stored back to back (81 bytes each) and writes
+  * one flag per grid. Grids are checked 16 at a time, one per SIMD lane. */
+ void validateSudokuSolutions(const uint8_t* grids, size_t count, bool* valid);
+
+ /* Same kernels at a fixed level, for benchmarks and cross-checks. A level
+  * above sudokuSimdLevel() runs at sudokuSimdLevel() instead. */
+ void computeSudokuCandidates(SudokuConstGridView grid, uint16_t candidates[81], SudokuSimdLevel level);
+ bool isValidSudokuSolution(SudokuConstGridView grid, SudokuSimdLevel level);
+ void validateSudokuSolutions(const uint8_t* grids, size_t count, bool* valid, SudokuSimdLevel level);
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
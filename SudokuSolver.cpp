@@ -1,8 +1,8 @@
 /******************************************************************************
  *  MODULE NAME  : SudokuSolver
  *  FILE         : SudokuSolver.cpp
- *  DESCRIPTION  : Implements the backtracking algorithm for solving Sudoku
- *                 puzzles using the SudokuSolver class.
+ *  DESCRIPTION  : Implements the bitmask constraint-propagation solver for
+ *                 Sudoku puzzles using the BasicSudokuSolver class template.
  *  AUTHOR       : Hassan Darwish
  *  DATE CREATED : April 2025
  ******************************************************************************/
@@ -11,90 +11,654 @@
  *  INCLUDES
  *============================================================================*/
 #include "SudokuSolver.hpp"
+#include "SudokuBits.hpp"
+#include "SudokuTables.hpp"
+#include <cstring>
+
+/*==============================================================================
+ *  CONSTANTS
+ *============================================================================*/
+
+namespace
+{
+    /* Row, column and box of each cell as a set of unit bits, so marking a
+     * cell's units takes one OR per 64-bit word */
+    template <int Box>
+    struct SolverUnitSets
+    {
+        static constexpr int CELLS = SudokuDimensions<Box>::CELLS;
+        static constexpr int SIZE  = SudokuDimensions<Box>::SIZE;
+        static constexpr int WORDS = (SudokuDimensions<Box>::UNITS + 63) / 64;
+
+        uint64_t of[CELLS][WORDS];
+
+        constexpr SolverUnitSets() : of()
+        {
+            for (int cell = 0; cell < CELLS; cell++)
+            {
+                int units[3] = { SUDOKU_BOX_TABLES<Box>.rowOf[cell],
+                                 SIZE + SUDOKU_BOX_TABLES<Box>.colOf[cell],
+                                 2 * SIZE + SUDOKU_BOX_TABLES<Box>.boxOf[cell] };
+                for (int unit : units)
+                {
+                    of[cell][unit >> 6] |= 1ull << (unit & 63);
+                }
+            }
+        }
+    };
+
+    template <int Box>
+    constexpr SolverUnitSets<Box> SOLVER_UNIT_SETS;
+}
 
 /*==============================================================================
  *  PUBLIC FUNCTION DEFINITIONS
  *============================================================================*/
 
-/* Attempts to solve the given Sudoku board using backtracking */
-bool SudokuSolver::solve(SudokuBoard& board) 
+/* Initializes the solver with a zeroed node counter */
+template <int Box, class Stats>
+BasicSudokuSolver<Box, Stats>::BasicSudokuSolver() : nodesVisited(0), solutionLimit(1), solutionsFound(0) {}
+
+/* One allocation for the lifetime of the solver: room for the deepest stack
+ * and the longest removal log */
+template <int Box, class Stats>
+BasicSudokuSolver<Box, Stats>::SolverContext::SolverContext()
+    : arena(MAX_FRAMES * sizeof(Frame) + alignof(Frame) + MAX_REMOVALS * sizeof(Removal) + alignof(Removal)),
+      frames(arena.allocateArray<Frame>(MAX_FRAMES)), removals(arena.allocateArray<Removal>(MAX_REMOVALS)),
+      removalCount(0), singleCount(0), hiddenUnits(), lockedUnits(), lockedDigits()
+{
+}
+
+/* Solves a copy of the board and fills the board in only on success, so a
+ * failed solve leaves the board and its move history as they were */
+template <int Box, class Stats>
+bool BasicSudokuSolver<Box, Stats>::solve(BasicSudokuBoard<Box>& board)
 {
-    std::vector<std::vector<int>> mat = board.getMatrix(); // new method below
-    bool solved = solveSudokuRec(mat, 0, 0);
+    uint8_t cells[CELLS];
+
+    std::memcpy(cells, board.view().data(), sizeof(cells));
+    if (!solve(GridView(cells)))
+    {
+        return false;
+    }
+    board.fillEmptyCells(ConstGridView(cells));
+    return true;
+}
 
-    if (solved) 
+/* Attempts to solve the grid, writing the solution back through the view */
+template <int Box, class Stats>
+bool BasicSudokuSolver<Box, Stats>::solve(GridView grid)
+{
+    if (runSearch(grid, 1) == 0)
     {
-        board.setMatrix(mat); // new method below
+        return false;
     }
 
-    return solved;
+    copySolution(grid);
+    return true;
+}
+
+/* Counts the board's solutions up to 'limit' without modifying it */
+template <int Box, class Stats>
+int BasicSudokuSolver<Box, Stats>::countSolutions(const BasicSudokuBoard<Box>& board, int limit)
+{
+    return countSolutions(board.view(), limit);
+}
+
+/* Counts the grid's solutions up to 'limit' in a single search */
+template <int Box, class Stats>
+int BasicSudokuSolver<Box, Stats>::countSolutions(ConstGridView grid, int limit)
+{
+    return runSearch(grid, limit);
+}
+
+/* Uniqueness check: the search stops at the second solution */
+template <int Box, class Stats>
+bool BasicSudokuSolver<Box, Stats>::hasUniqueSolution(ConstGridView grid)
+{
+    return runSearch(grid, 2) == 1;
+}
+
+/* Copies the stored first solution */
+template <int Box, class Stats>
+void BasicSudokuSolver<Box, Stats>::copySolution(GridView grid) const
+{
+    std::memcpy(grid.data(), solution.cells, sizeof(solution.cells));
+}
+
+/* Number of search nodes entered by the last solve */
+template <int Box, class Stats>
+uint64_t BasicSudokuSolver<Box, Stats>::getNodesVisited(void) const
+{
+    return nodesVisited;
+}
+
+/* Statistics of the last solve when the policy collects them */
+template <int Box, class Stats>
+bool BasicSudokuSolver<Box, Stats>::getSolveStats(SudokuSolveStats& out) const
+{
+    return stats.read(out);
+}
+
+/* Backend name */
+template <int Box, class Stats>
+const char* BasicSudokuSolver<Box, Stats>::name(void) const
+{
+    return "bitmask";
 }
 
 /*==============================================================================
  *  PRIVATE FUNCTION DEFINITIONS
  *============================================================================*/
 
-/* Recursively solves the board using backtracking starting from (row, col) */
-bool SudokuSolver::solveSudokuRec(std::vector<std::vector<int>>& mat, int row, int col) 
+/* Resets the counters and searches until 'limit' solutions are found */
+template <int Box, class Stats>
+int BasicSudokuSolver<Box, Stats>::runSearch(ConstGridView grid, int limit)
+{
+    nodesVisited = 0;
+    solutionsFound = 0;
+    solutionLimit = (limit < 1) ? 1 : limit;
+
+    stats.beginSolve();
+    context.trail.clear();
+    context.removalCount = 0;
+    if (loadState(grid, context.state))
+    {
+        search();
+    }
+    stats.endSolve();
+    return solutionsFound;
+}
+
+/* Builds the search state from the grid: the givens set the unit masks,
+ * which then give every empty cell its candidates */
+template <int Box, class Stats>
+bool BasicSudokuSolver<Box, Stats>::loadState(ConstGridView grid, SearchState& state) const
+{
+    for (int unit = 0; unit < SIZE; unit++)
+    {
+        state.rowMask[unit] = 0;
+        state.colMask[unit] = 0;
+        state.boxMask[unit] = 0;
+    }
+    state.emptyCount = CELLS;
+
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        int value = grid[cell];
+
+        state.cells[cell] = 0;
+        if (value == 0)
+        {
+            continue;
+        }
+        if (value < 1 || value > SIZE || !isSafe(state, cell, value))
+        {
+            return false;
+        }
+        place(state, cell, value);
+    }
+
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        state.cand[cell] = static_cast<Mask>(state.cells[cell] == 0 ? candidates(state, cell) : 0);
+    }
+    return true;
+}
+
+/* Writes the digit into the cell and marks it as used in its row, column and box */
+template <int Box, class Stats>
+void BasicSudokuSolver<Box, Stats>::place(SearchState& state, int cell, int num) const
 {
-    int n = mat.size();
+    Mask bit = static_cast<Mask>(1u << (num - 1));
+
+    state.cells[cell] = static_cast<uint8_t>(num);
+    state.rowMask[SUDOKU_BOX_TABLES<Box>.rowOf[cell]] |= bit;
+    state.colMask[SUDOKU_BOX_TABLES<Box>.colOf[cell]] |= bit;
+    state.boxMask[SUDOKU_BOX_TABLES<Box>.boxOf[cell]] |= bit;
+    state.emptyCount--;
+}
 
-    if (row == n - 1 && col == n)
+/* The cell's own candidates go on the log like any other removal, so
+ * unwinding the log and the trail restores the cell completely */
+template <int Box, class Stats>
+bool BasicSudokuSolver<Box, Stats>::assign(SearchState& state, Trail& trail, int cell, int num)
+{
+    Mask bit = static_cast<Mask>(1u << (num - 1));
+
+    context.removals[context.removalCount++] = Removal{ static_cast<uint16_t>(cell), state.cand[cell] };
+    markUnits(cell, state.cand[cell]);
+    state.cand[cell] = 0;
+    place(state, cell, num);
+    trail.record(cell, 0, num);
+
+    for (int peer : SUDOKU_BOX_TABLES<Box>.peers[cell])
     {
-        return true;
+        if ((state.cand[peer] & bit) && !eliminate(state, peer, bit))
+        {
+            return false;
+        }
     }
-    if (col == n) 
+    return true;
+}
+
+/* A cell down to one candidate is queued as a naked single; its units are
+ * marked because a digit may now have one place left in them */
+template <int Box, class Stats>
+bool BasicSudokuSolver<Box, Stats>::eliminate(SearchState& state, int cell, Mask bits)
+{
+    Mask left = static_cast<Mask>(state.cand[cell] & ~bits);
+
+    context.removals[context.removalCount++] = Removal{ static_cast<uint16_t>(cell), bits };
+    state.cand[cell] = left;
+    markUnits(cell, bits);
+    if (left == 0)
     {
-        row++;
-        col = 0;
+        return false;
     }
+    if (sudokuIsSingleBit(left))
+    {
+        context.singles[context.singleCount++] = static_cast<uint16_t>(cell);
+    }
+    return true;
+}
+
+/* Only the hidden-single set is marked; a unit moves on to the locked-
+ * candidate set once its hidden singles have been checked */
+template <int Box, class Stats>
+void BasicSudokuSolver<Box, Stats>::markUnits(int cell, Mask bits)
+{
+    for (int word = 0; word < UNIT_WORDS; word++)
+    {
+        context.hiddenUnits[word] |= SOLVER_UNIT_SETS<Box>.of[cell][word];
+    }
+    context.lockedDigits[SUDOKU_BOX_TABLES<Box>.rowOf[cell]] |= bits;
+    context.lockedDigits[SIZE + SUDOKU_BOX_TABLES<Box>.colOf[cell]] |= bits;
+    context.lockedDigits[2 * SIZE + SUDOKU_BOX_TABLES<Box>.boxOf[cell]] |= bits;
+}
 
-    if (mat[row][col] != 0)
+/* A freshly loaded grid has not been looked at yet, so every unit is due */
+template <int Box, class Stats>
+bool BasicSudokuSolver<Box, Stats>::seedQueues(const SearchState& state)
+{
+    context.singleCount = 0;
+    for (int word = 0; word < UNIT_WORDS; word++)
     {
-        return solveSudokuRec(mat, row, col + 1);
+        int bits = (UNITS - word * 64 < 64) ? UNITS - word * 64 : 64;
+        uint64_t all = (bits == 64) ? ~0ull : (1ull << bits) - 1;
+        context.hiddenUnits[word] = all;
+        context.lockedUnits[word] = all;
     }
-    for (int num = 1; num <= n; num++) 
+    for (int unit = 0; unit < UNITS; unit++)
     {
-        if (isSafe(mat, row, col, num)) 
+        context.lockedDigits[unit] = Dimensions::ALL_DIGITS;
+    }
+
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        if (state.cells[cell] != 0)
         {
-            mat[row][col] = num;
+            continue;
+        }
+        if (state.cand[cell] == 0)
+        {
+            return false;
+        }
+        if (sudokuIsSingleBit(state.cand[cell]))
+        {
+            context.singles[context.singleCount++] = static_cast<uint16_t>(cell);
+        }
+    }
+    return true;
+}
 
-            if (solveSudokuRec(mat, row, col + 1))
+/* The queues of a propagation that failed part-way are stale once the
+ * board is unwound */
+template <int Box, class Stats>
+void BasicSudokuSolver<Box, Stats>::clearQueues(void)
+{
+    context.singleCount = 0;
+    for (int word = 0; word < UNIT_WORDS; word++)
+    {
+        context.hiddenUnits[word] = 0;
+        context.lockedUnits[word] = 0;
+    }
+    for (int unit = 0; unit < UNITS; unit++)
+    {
+        context.lockedDigits[unit] = 0;
+    }
+}
+
+/* Filled cells have no candidates, so the unit's empty cells are not
+ * singled out; a digit in neither the candidates nor the placed digits has
+ * no spot left */
+template <int Box, class Stats>
+bool BasicSudokuSolver<Box, Stats>::hiddenSingles(SearchState& state, Trail& trail, int unit)
+{
+    const auto& cells = SUDOKU_BOX_TABLES<Box>.units[unit];
+    unsigned int once = 0;
+    unsigned int twice = 0;
+    unsigned int used = (unit < SIZE)     ? state.rowMask[unit] :
+                        (unit < 2 * SIZE) ? state.colMask[unit - SIZE] :
+                                            state.boxMask[unit - 2 * SIZE];
+
+    for (int index = 0; index < SIZE; index++)
+    {
+        unsigned int cand = state.cand[cells[index]];
+        twice |= once & cand;
+        once |= cand;
+    }
+
+    if ((once | used) != Dimensions::ALL_DIGITS)
+    {
+        return false;   // Some digit has no place left in this unit
+    }
+
+    unsigned int hidden = once & ~twice;
+    while (hidden)
+    {
+        int num = sudokuCtz(hidden) + 1;
+        unsigned int bit = hidden & (0u - hidden);
+        hidden &= hidden - 1;
+
+        int index = 0;
+        while (index < SIZE && !(state.cand[cells[index]] & bit))
+        {
+            index++;
+        }
+        if (index == SIZE)
+        {
+            return false;   // The only spot was taken by an earlier single
+        }
+        if (!assign(state, trail, cells[index], num))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Splits the unit into Box segments, each its crossing with another unit:
+ * boxes for a line, rows and then columns for a box. A digit found in one
+ * segment only is cleared from the rest of the crossing unit. */
+template <int Box, class Stats>
+bool BasicSudokuSolver<Box, Stats>::lockedCandidates(SearchState& state, int unit)
+{
+    const auto& cells = SUDOKU_BOX_TABLES<Box>.units[unit];
+    bool isBox = unit >= 2 * SIZE;
+    unsigned int digits = context.lockedDigits[unit];
+
+    context.lockedDigits[unit] = 0;
+
+    for (int pass = 0; pass < (isBox ? 2 : 1); pass++)
+    {
+        // Segment k holds units[unit][k * Box + i] for lines and box rows,
+        // units[unit][i * Box + k] for box columns
+        int stride = (pass == 0) ? 1 : Box;
+        int step = (pass == 0) ? Box : 1;
+        unsigned int segment[Box];
+
+        for (int k = 0; k < Box; k++)
+        {
+            segment[k] = 0;
+            for (int i = 0; i < Box; i++)
             {
-                return true;
+                segment[k] |= state.cand[cells[k * step + i * stride]];
             }
-            mat[row][col] = 0;
         }
-    }
 
-    return false;
+        for (int k = 0; k < Box; k++)
+        {
+            unsigned int others = 0;
+            for (int j = 0; j < Box; j++)
+            {
+                others |= (j != k) ? segment[j] : 0u;
+            }
+
+            Mask only = static_cast<Mask>(segment[k] & ~others & digits);
+            if (only == 0)
+            {
+                continue;
+            }
+
+            int first = cells[k * step];
+            int target = !isBox   ? 2 * SIZE + SUDOKU_BOX_TABLES<Box>.boxOf[first] :
+                         pass == 0 ? SUDOKU_BOX_TABLES<Box>.rowOf[first] :
+                                     SIZE + SUDOKU_BOX_TABLES<Box>.colOf[first];
+            if (!clearOutside(state, target, unit, only))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
 }
 
-/* Checks if it's safe to place 'num' at position (row, col) in the board */
-bool SudokuSolver::isSafe(const std::vector<std::vector<int>>& mat, int row, int col, int num) 
+/* A cell lies in 'source' when it has the same row, column or box number */
+template <int Box, class Stats>
+bool BasicSudokuSolver<Box, Stats>::clearOutside(SearchState& state, int target, int source, Mask digits)
 {
-    for (int x = 0; x < 9; x++) 
+    const auto& tables = SUDOKU_BOX_TABLES<Box>;
+
+    for (int cell : tables.units[target])
     {
-        if (mat[row][x] == num || mat[x][col] == num)
+        Mask hit = static_cast<Mask>(state.cand[cell] & digits);
+        if (hit == 0)
+        {
+            continue;
+        }
+        bool inSource = (source < SIZE)     ? tables.rowOf[cell] == source :
+                        (source < 2 * SIZE) ? tables.colOf[cell] == source - SIZE :
+                                              tables.boxOf[cell] == source - 2 * SIZE;
+        if (!inSource && !eliminate(state, cell, hit))
+        {
             return false;
+        }
     }
+    return true;
+}
 
-    int startRow = row - row % 3;
-    int startCol = col - col % 3;
+/* Digits not yet used in the cell's row, column or box */
+template <int Box, class Stats>
+unsigned int BasicSudokuSolver<Box, Stats>::candidates(const SearchState& state, int cell) const
+{
+    return ~(state.rowMask[SUDOKU_BOX_TABLES<Box>.rowOf[cell]] |
+             state.colMask[SUDOKU_BOX_TABLES<Box>.colOf[cell]] |
+             state.boxMask[SUDOKU_BOX_TABLES<Box>.boxOf[cell]]) & Dimensions::ALL_DIGITS;
+}
 
-    for (int i = 0; i < 3; i++)
+/* Trail entries always fill an empty cell, so undoing one clears the digit
+ * from the cell's masks; removals only ever clear set bits, so putting the
+ * bits back restores the candidates */
+template <int Box, class Stats>
+void BasicSudokuSolver<Box, Stats>::unwind(SearchState& state, Trail& trail, int mark, int removed)
+{
+    for (int count = trail.size() - mark; count > 0; count--)
     {
-        for (int j = 0; j < 3; j++)
+        const SudokuTrailEntry& entry = trail.undo();
+        int cell = entry.cell;
+        Mask bit = static_cast<Mask>(~(1u << (entry.after - 1)));
+
+        state.cells[cell] = 0;
+        state.rowMask[SUDOKU_BOX_TABLES<Box>.rowOf[cell]] &= bit;
+        state.colMask[SUDOKU_BOX_TABLES<Box>.colOf[cell]] &= bit;
+        state.boxMask[SUDOKU_BOX_TABLES<Box>.boxOf[cell]] &= bit;
+        state.emptyCount++;
+    }
+
+    while (context.removalCount > removed)
+    {
+        const Removal& removal = context.removals[--context.removalCount];
+        state.cand[removal.cell] |= removal.bits;
+    }
+}
+
+/* Naked singles are cheapest and are placed as soon as they appear; a unit
+ * gets its hidden-single pass only once no single is waiting, and its
+ * locked-candidate pass only once no unit is waiting for hidden singles */
+template <int Box, class Stats>
+bool BasicSudokuSolver<Box, Stats>::propagate(SearchState& state, Trail& trail)
+{
+    while (state.emptyCount > 0)
+    {
+        if (context.singleCount > 0)
         {
-            if (mat[startRow + i][startCol + j] == num)
+            int cell = context.singles[--context.singleCount];
+            Mask cand = state.cand[cell];
+            if (state.cells[cell] == 0 && !assign(state, trail, cell, sudokuCtz(cand) + 1))
             {
                 return false;
             }
+            continue;
+        }
+
+        int word = 0;
+        while (word < UNIT_WORDS && context.hiddenUnits[word] == 0)
+        {
+            word++;
+        }
+        if (word < UNIT_WORDS)
+        {
+            int unit = word * 64 + sudokuCtz64(context.hiddenUnits[word]);
+            context.hiddenUnits[word] &= context.hiddenUnits[word] - 1;
+            context.lockedUnits[word] |= 1ull << (unit & 63);
+            if (!hiddenSingles(state, trail, unit))
+            {
+                return false;
+            }
+            continue;
+        }
+
+        word = 0;
+        while (word < UNIT_WORDS && context.lockedUnits[word] == 0)
+        {
+            word++;
+        }
+        if (word == UNIT_WORDS)
+        {
+            break;
+        }
+        int unit = word * 64 + sudokuCtz64(context.lockedUnits[word]);
+        context.lockedUnits[word] &= context.lockedUnits[word] - 1;
+        if (!lockedCandidates(state, unit))
+        {
+            return false;
         }
     }
     return true;
 }
 
+/* Walks the frame stack depth first. Entering a frame propagates the board
+ * and picks its branch cell; each pass then unwinds the board to where the
+ * frame branched and places the frame's next candidate for the frame above,
+ * or pops back once no candidates are left. A placement that empties a
+ * peer fails the frame it enters without propagating. Keeps going after a
+ * solution until solutionLimit of them have been found. */
+template <int Box, class Stats>
+bool BasicSudokuSolver<Box, Stats>::search(void)
+{
+    Frame* frames = context.frames;
+    SearchState& state = context.state;
+    Trail& trail = context.trail;
+    int depth = 0;
+    bool entering = true;
+    bool placed = seedQueues(state);
+
+    while (true)
+    {
+        Frame& frame = frames[depth];
+
+        if (entering)
+        {
+            nodesVisited++;
+            stats.enterNode();
+            frame.untried = 0;
+
+            stats.beginPropagate(state.emptyCount);
+            bool consistent = placed && propagate(state, trail);
+            stats.endPropagate(state.emptyCount);
+            if (!consistent)
+            {
+                stats.deadEnd();
+            }
+            else if (state.emptyCount == 0)
+            {
+                if (solutionsFound++ == 0)
+                {
+                    solution = state;
+                }
+                if (solutionsFound >= solutionLimit)
+                {
+                    return true;
+                }
+            }
+            else
+            {
+                int bestCell = -1;
+                int bestCount = SIZE + 1;
+                for (int cell = 0; cell < CELLS && bestCount > 2; cell++)
+                {
+                    if (state.cells[cell] == 0)
+                    {
+                        int count = sudokuPopcount(state.cand[cell]);
+                        if (count < bestCount)
+                        {
+                            bestCount = count;
+                            bestCell = cell;
+                        }
+                    }
+                }
+                frame.mark = trail.size();
+                frame.removed = context.removalCount;
+                frame.cell = bestCell;
+                frame.untried = state.cand[bestCell];
+            }
+        }
+
+        if (frame.untried == 0)
+        {
+            if (depth == 0)
+            {
+                return false;
+            }
+            depth--;
+            stats.leaveBranch();
+            entering = false;
+            continue;
+        }
+
+        int num = sudokuCtz(frame.untried) + 1;
+        frame.untried &= frame.untried - 1;
+
+        unwind(state, trail, frame.mark, frame.removed);
+        clearQueues();
+        placed = assign(state, trail, frame.cell, num);
+        stats.enterBranch();
+        depth++;
+        entering = true;
+    }
+}
+
+/* Checks if it's safe to place 'num' at the given cell index */
+template <int Box, class Stats>
+bool BasicSudokuSolver<Box, Stats>::isSafe(const SearchState& state, int cell, int num) const
+{
+    return (candidates(state, cell) >> (num - 1)) & 1u;
+}
+
+/*==============================================================================
+ *  EXPLICIT INSTANTIATIONS
+ *============================================================================*/
+
+template class BasicSudokuSolver<2>;
+template class BasicSudokuSolver<3>;
+template class BasicSudokuSolver<4>;
+template class BasicSudokuSolver<5>;
+template class BasicSudokuSolver<2, SudokuCountingStats>;
+template class BasicSudokuSolver<3, SudokuCountingStats>;
+template class BasicSudokuSolver<4, SudokuCountingStats>;
+template class BasicSudokuSolver<5, SudokuCountingStats>;
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
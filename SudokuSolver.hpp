@@ -2,7 +2,8 @@
  *  MODULE NAME  : SudokuSolver
  *  FILE         : SudokuSolver.hpp
  *  DESCRIPTION  : Header file for the SudokuSolver class that provides a
- *                 backtracking algorithm to solve a Sudoku board.
+ *                 constraint-propagation and backtracking algorithm to solve
+ *                 a Sudoku board.
  *  AUTHOR       : Hassan Darwish
  *  DATE CREATED : April 2025
  ******************************************************************************/
@@ -12,31 +13,232 @@
  /*==============================================================================
   *  INCLUDES
   *============================================================================*/
+ #include "SudokuArena.hpp"
  #include "SudokuBoard.hpp"
- #include <vector>
- 
+ #include "SudokuSolverEngine.hpp"
+ #include "SudokuSolverStats.hpp"
+ #include "SudokuTrail.hpp"
+ #include <cstdint>
+
  /*==============================================================================
   *  CLASS DEFINITIONS
   *============================================================================*/
- 
+
  /*------------------------------------------------------------------------------
-  *  CLASS NAME: SudokuSolver
-  *  DESCRIPTION: Implements a backtracking solver for Sudoku puzzles.
+  *  CLASS NAME: BasicSudokuSolver
+  *  DESCRIPTION: Implements a bitmask solver for Sudoku puzzles. Every cell
+  *               keeps its candidate mask, and a placement only clears its
+  *               digit from the cell's peers. Cells left with one candidate
+  *               are queued, and every unit whose candidates changed is
+  *               marked for a hidden-single pass and then for locked
+  *               candidates (pointing and claiming), so each step only
+  *               looks at what the last one touched. Once the queues are
+  *               empty the search branches on the cell with the fewest
+  *               candidates. The search is iterative over a frame stack in
+  *               a reusable context and works on one board: placements go
+  *               on a trail and removed candidates on a log, and
+  *               backtracking takes both back instead of restoring a copy.
+  *               Solving does not allocate once the solver exists. The box
+  *               size is a template parameter, so loop bounds and mask
+  *               widths are compile-time constants for each size. The Stats
+  *               policy (SudokuSolverStats.hpp) decides whether search
+  *               statistics are collected. Defined in SudokuSolver.cpp and
+  *               instantiated there for box sizes 2 to 5 with both
+  *               policies; SudokuSolver is the 9x9 solver.
   *----------------------------------------------------------------------------*/
- class SudokuSolver {
+ template <int Box, class Stats = SudokuNoStats>
+ class BasicSudokuSolver final : public BasicSudokuSolverEngine<Box> {
  public:
-     /* Solves the provided Sudoku board using backtracking */
-     bool solve(SudokuBoard& board);
- 
+     typedef SudokuDimensions<Box>                  Dimensions;
+     typedef typename Dimensions::Mask              Mask;
+     typedef BasicSudokuGridView<Box>               GridView;
+     typedef BasicSudokuConstGridView<Box>          ConstGridView;
+
+     static constexpr int SIZE  = Dimensions::SIZE;
+     static constexpr int CELLS = Dimensions::CELLS;
+     static constexpr int UNITS = Dimensions::UNITS;
+
+     /* Constructor: starts with an empty node counter and allocates the
+      * search context */
+     BasicSudokuSolver();
+
+     /* Solves the provided Sudoku board, returns false if it has no solution.
+      * Only a successful solve changes the board; its undo history is kept. */
+     bool solve(BasicSudokuBoard<Box>& board);
+
+     /* Solves the grid in place (no allocation), returns false if it has no solution */
+     bool solve(GridView grid) override;
+
+     /* Counts solutions of the board, stopping as soon as 'limit' are found */
+     int countSolutions(const BasicSudokuBoard<Box>& board, int limit);
+
+     /* Counts solutions of the grid (left unchanged), stopping at 'limit' */
+     int countSolutions(ConstGridView grid, int limit) override;
+
+     /* True if the grid has exactly one solution (counts up to two) */
+     bool hasUniqueSolution(ConstGridView grid) override;
+
+     /* Copies the first solution found by the last solve/count into 'grid' */
+     void copySolution(GridView grid) const override;
+
+     /* Number of search nodes entered by the last solve */
+     uint64_t getNodesVisited(void) const override;
+
+     /* Statistics of the last solve, false unless Stats collects them */
+     bool getSolveStats(SudokuSolveStats& stats) const override;
+
+     /* Returns "bitmask" */
+     const char* name(void) const override;
+
  private:
-     /* Recursive helper function to solve the board from a given cell */
-     bool solveSudokuRec(std::vector<std::vector<int>>& mat, int row, int col);
- 
-     /* Checks if placing a number at (row, col) is valid */
-     bool isSafe(const std::vector<std::vector<int>>& mat, int row, int col, int num);
+     /* Board the search works on */
+     struct SearchState
+     {
+         uint8_t cells[CELLS];   // Cell values, 0 for empty
+         Mask    cand[CELLS];    // Candidates of each empty cell, 0 once filled
+         Mask    rowMask[SIZE];  // Digits already placed in each row
+         Mask    colMask[SIZE];  // Digits already placed in each column
+         Mask    boxMask[SIZE];  // Digits already placed in each box
+         int     emptyCount;     // Number of cells still empty
+     };
+
+     /* Each placement fills an empty cell, so the trail never holds more
+      * than CELLS entries and never wraps */
+     typedef SudokuTrail<sudokuTrailCapacity(CELLS)> Trail;
+
+     /* Candidates taken out of one cell, put back when backtracking */
+     struct Removal
+     {
+         uint16_t cell;   // Row-major cell index
+         Mask     bits;   // Candidates removed, all of them set before
+     };
+
+     /* Every removal clears at least one of the CELLS * SIZE candidates of
+      * the loaded grid, so the log of one search path never holds more */
+     static constexpr int MAX_REMOVALS = CELLS * SIZE;
+
+     /* 64-bit words of a set of units */
+     static constexpr int UNIT_WORDS = (UNITS + 63) / 64;
+
+     /* One level of the search: where its board starts on the trail and the
+      * candidates of its branch cell that are still to be tried */
+     struct Frame
+     {
+         int          mark;      // Trail size once the level has propagated
+         int          removed;   // Removal log size at the same point
+         unsigned int untried;   // Candidates of 'cell' not yet tried
+         int          cell;      // Branch cell
+     };
+
+     /* Every branch fills a cell, so the stack is never deeper than this */
+     static constexpr int MAX_FRAMES = CELLS + 1;
+
+     /* Search memory reused by every solve: the frame stack and the removal
+      * log live in a fixed arena sized for the deepest possible search and
+      * are reset, not freed */
+     struct SolverContext
+     {
+         SudokuArena arena;                    // Owns the frames and the removal log
+         Frame*      frames;                   // MAX_FRAMES frames
+         Removal*    removals;                 // MAX_REMOVALS entries
+         int         removalCount;             // Removals not yet taken back
+         SearchState state;                    // Loaded grid, then the board at the current depth
+         Trail       trail;                    // Placements made since the grid was loaded
+         uint16_t    singles[CELLS];           // Cells left with one candidate, not yet placed
+         int         singleCount;              // Entries in 'singles'
+         uint64_t    hiddenUnits[UNIT_WORDS];  // Units to check for hidden singles
+         uint64_t    lockedUnits[UNIT_WORDS];  // Units to check for locked candidates
+         Mask        lockedDigits[UNITS];      // Digits removed from each unit since its last locked pass
+
+         /* Allocates the arena and carves the frame stack and log from it */
+         SolverContext();
+     };
+
+     SearchState solution;       // First solution found by the last search
+     uint64_t    nodesVisited;   // Search nodes entered by the last search
+     int         solutionLimit;  // Search stops after this many solutions
+     int         solutionsFound; // Solutions found so far by the current search
+     Stats       stats;          // Search statistics policy
+     SolverContext context;      // Frame stack of the search
+
+     /* Benchmark suite reaches the search internals through this class */
+     friend class SudokuSolverBenchAccess;
+
+     /* Loads the grid into a search state, false if the givens clash */
+     bool loadState(ConstGridView grid, SearchState& state) const;
+
+     /* Places 'num' at the given cell index and updates the masks */
+     void place(SearchState& state, int cell, int num) const;
+
+     /* Places 'num', records it on the trail and clears it from the peers'
+      * candidates; false if a peer is left with none */
+     bool assign(SearchState& state, Trail& trail, int cell, int num);
+
+     /* Removes candidates (all currently set) from an empty cell and queues
+      * the work that follows; false if the cell is left with none */
+     bool eliminate(SearchState& state, int cell, Mask bits);
+
+     /* Marks the row, column and box of the cell after 'bits' were removed
+      * from it */
+     void markUnits(int cell, Mask bits);
+
+     /* Empties the queues and marks every unit and single, at the start of a
+      * search; false if an empty cell has no candidate */
+     bool seedQueues(const SearchState& state);
+
+     /* Empties the queues before the next branch is tried */
+     void clearQueues(void);
+
+     /* Places the digits with one spot left in the unit; false on contradiction */
+     bool hiddenSingles(SearchState& state, Trail& trail, int unit);
+
+     /* Pointing and claiming: a digit confined to where the unit crosses
+      * another unit is removed from the rest of that unit. False on
+      * contradiction. */
+     bool lockedCandidates(SearchState& state, int unit);
+
+     /* Removes 'digits' from the cells of unit 'target' outside unit 'source' */
+     bool clearOutside(SearchState& state, int target, int source, Mask digits);
+
+     /* Returns the candidate mask of an empty cell */
+     unsigned int candidates(const SearchState& state, int cell) const;
+
+     /* Empties cells from the trail, newest first, until it is back to
+      * 'mark', and puts back the candidates removed after 'removed' */
+     void unwind(SearchState& state, Trail& trail, int mark, int removed);
+
+     /* Works through the queues: naked singles first, then hidden singles of
+      * the marked units, then their locked candidates, until all are empty;
+      * false on contradiction */
+     bool propagate(SearchState& state, Trail& trail);
+
+     /* Runs a fresh search over the grid, returns the number of solutions found */
+     int runSearch(ConstGridView grid, int limit);
+
+     /* Depth-first search from the loaded state: propagates, then branches on the
+      * most constrained cell. Returns true once solutionLimit solutions have
+      * been found. */
+     bool search(void);
+
+     /* Checks if placing a number at the given cell index is valid */
+     bool isSafe(const SearchState& state, int cell, int num) const;
  };
- 
+
+ extern template class BasicSudokuSolver<2>;
+ extern template class BasicSudokuSolver<3>;
+ extern template class BasicSudokuSolver<4>;
+ extern template class BasicSudokuSolver<5>;
+ extern template class BasicSudokuSolver<2, SudokuCountingStats>;
+ extern template class BasicSudokuSolver<3, SudokuCountingStats>;
+ extern template class BasicSudokuSolver<4, SudokuCountingStats>;
+ extern template class BasicSudokuSolver<5, SudokuCountingStats>;
+
+ /* The classic 9x9 solver */
+ typedef BasicSudokuSolver<3> SudokuSolver;
+
+ /* 9x9 solver that records statistics for every solve */
+ typedef BasicSudokuSolver<3, SudokuCountingStats> SudokuInstrumentedSolver;
+
  /******************************************************************************
   *  END OF FILE
   ******************************************************************************/
- 
\ No newline at end of file
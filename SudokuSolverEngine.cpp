@@ -0,0 +1,66 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuSolverEngine
+ *  FILE         : SudokuSolverEngine.cpp
+ *  DESCRIPTION  : Implements the solver backend factory.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuSolverEngine.hpp"
+#include "SudokuSolver.hpp"
+#include "SudokuDlxSolver.hpp"
+#include "SudokuLockstep.hpp"
+#include <cstring>
+
+/*==============================================================================
+ *  FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Creates a solver of the requested kind */
+std::unique_ptr<SudokuSolverEngine> makeSudokuSolverEngine(SudokuEngineKind kind, bool collectStats)
+{
+    switch (kind)
+    {
+        case SudokuEngineKind::Dlx:
+        return std::unique_ptr<SudokuSolverEngine>(new SudokuDlxSolver());
+
+        case SudokuEngineKind::Lockstep:
+        return std::unique_ptr<SudokuSolverEngine>(new SudokuLockstepSolver());
+
+        case SudokuEngineKind::Bitmask:
+        break;
+    }
+    if (collectStats)
+    {
+        return std::unique_ptr<SudokuSolverEngine>(new SudokuInstrumentedSolver());
+    }
+    return std::unique_ptr<SudokuSolverEngine>(new SudokuSolver());
+}
+
+/* Maps a backend name to its kind */
+bool parseSudokuEngineKind(const char* text, SudokuEngineKind& kind)
+{
+    if (std::strcmp(text, "bitmask") == 0)
+    {
+        kind = SudokuEngineKind::Bitmask;
+        return true;
+    }
+    if (std::strcmp(text, "dlx") == 0)
+    {
+        kind = SudokuEngineKind::Dlx;
+        return true;
+    }
+    if (std::strcmp(text, "lockstep") == 0)
+    {
+        kind = SudokuEngineKind::Lockstep;
+        return true;
+    }
+    return false;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
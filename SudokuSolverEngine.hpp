@@ -0,0 +1,111 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuSolverEngine
+ *  FILE         : SudokuSolverEngine.hpp
+ *  DESCRIPTION  : Common interface of the solver backends and the factory
+ *                 that picks one at runtime.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include "SudokuBoard.hpp"
+ #include "SudokuSolverStats.hpp"
+ #include <cstddef>
+ #include <cstdint>
+ #include <memory>
+
+ /*==============================================================================
+  *  TYPE DEFINITIONS
+  *============================================================================*/
+
+ /* Available solver backends */
+ enum class SudokuEngineKind : uint8_t
+ {
+     Bitmask,   // SudokuSolver: bitmask propagation + most-constrained-cell search
+     Dlx,       // SudokuDlxSolver: Dancing Links exact cover (9x9 only)
+     Lockstep   // SudokuLockstepSolver: 16 puzzles at a time in SIMD lanes (9x9 only)
+ };
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: BasicSudokuSolverEngine
+  *  DESCRIPTION: Interface shared by the solver backends of one board size.
+  *               An engine owns all of its search memory, so one engine per
+  *               thread is enough and repeated solves do not allocate.
+  *               SudokuSolverEngine is the 9x9 interface.
+  *----------------------------------------------------------------------------*/
+ template <int Box>
+ class BasicSudokuSolverEngine
+ {
+ public:
+     virtual ~BasicSudokuSolverEngine() {}
+
+     /* Solves the grid in place, returns false if it has no solution */
+     virtual bool solve(BasicSudokuGridView<Box> grid) = 0;
+
+     /* Counts solutions of the grid (left unchanged), stopping at 'limit' */
+     virtual int countSolutions(BasicSudokuConstGridView<Box> grid, int limit) = 0;
+
+     /* True if the grid has exactly one solution (counts up to two) */
+     virtual bool hasUniqueSolution(BasicSudokuConstGridView<Box> grid) { return countSolutions(grid, 2) == 1; }
+
+     /* Copies the first solution found by the last solve/count into 'grid' */
+     virtual void copySolution(BasicSudokuGridView<Box> grid) const = 0;
+
+     /* Solves 'count' grids in place, each CELLS bytes. found[i] is the
+      * number of solutions of grid i, counted up to 'limit' (1 just solves);
+      * the grid holds the first one if there is any. Engines that can work
+      * on several puzzles at once override this; the default takes them one
+      * by one. */
+     virtual void solveMany(uint8_t* const* grids, size_t count, int limit, int* found)
+     {
+         for (size_t index = 0; index < count; index++)
+         {
+             BasicSudokuGridView<Box> grid(grids[index]);
+             if (limit == 1)
+             {
+                 found[index] = solve(grid) ? 1 : 0;
+                 continue;
+             }
+             found[index] = countSolutions(grid, limit);
+             if (found[index] > 0)
+             {
+                 copySolution(grid);
+             }
+         }
+     }
+
+     /* Number of search nodes entered by the last solve */
+     virtual uint64_t getNodesVisited(void) const = 0;
+
+     /* Statistics of the last solve, false if this engine does not collect them */
+     virtual bool getSolveStats(SudokuSolveStats&) const { return false; }
+
+     /* Short backend name ("bitmask", "dlx", "lockstep") */
+     virtual const char* name(void) const = 0;
+ };
+
+ /* The classic 9x9 engine interface */
+ typedef BasicSudokuSolverEngine<3> SudokuSolverEngine;
+
+ /*==============================================================================
+  *  FUNCTION DECLARATIONS
+  *============================================================================*/
+
+ /* Creates a 9x9 solver of the requested kind. With collectStats the bitmask
+  * solver records SudokuSolveStats for every solve (dlx does not). */
+ std::unique_ptr<SudokuSolverEngine> makeSudokuSolverEngine(SudokuEngineKind kind, bool collectStats = false);
+
+ /* Parses a backend name ("bitmask", "dlx" or "lockstep"), false if unknown */
+ bool parseSudokuEngineKind(const char* text, SudokuEngineKind& kind);
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
@@ -0,0 +1,57 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuSolverStats
+ *  FILE         : SudokuSolverStats.cpp
+ *  DESCRIPTION  : Accumulation and JSON formatting of solver statistics.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuSolverStats.hpp"
+#include <cstdio>
+
+/*==============================================================================
+ *  FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Sums the counters and times, keeps the deeper of the two searches */
+void accumulateSudokuSolveStats(SudokuSolveStats& total, const SudokuSolveStats& solve)
+{
+    total.nodes += solve.nodes;
+    total.backtracks += solve.backtracks;
+    total.guesses += solve.guesses;
+    total.propagations += solve.propagations;
+    if (solve.maxDepth > total.maxDepth)
+    {
+        total.maxDepth = solve.maxDepth;
+    }
+    total.propagateSeconds += solve.propagateSeconds;
+    total.searchSeconds += solve.searchSeconds;
+}
+
+/* Formats the stats as one JSON object */
+size_t formatSudokuSolveStats(const SudokuSolveStats& stats, char* text, size_t size)
+{
+    int written = std::snprintf(text, size,
+                                "{\"nodes\":%llu,\"backtracks\":%llu,\"guesses\":%llu,\"propagations\":%llu,"
+                                "\"max_depth\":%u,\"propagate_us\":%.3f,\"search_us\":%.3f}",
+                                static_cast<unsigned long long>(stats.nodes),
+                                static_cast<unsigned long long>(stats.backtracks),
+                                static_cast<unsigned long long>(stats.guesses),
+                                static_cast<unsigned long long>(stats.propagations),
+                                static_cast<unsigned int>(stats.maxDepth),
+                                stats.propagateSeconds * 1e6,
+                                stats.searchSeconds * 1e6);
+
+    if (written < 0 || static_cast<size_t>(written) >= size)
+    {
+        return 0;
+    }
+    return static_cast<size_t>(written);
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,153 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuSolverStats
+ *  FILE         : SudokuSolverStats.hpp
+ *  DESCRIPTION  : Search statistics for the bitmask solver. The solver takes
+ *                 a statistics policy as a template parameter: SudokuNoStats
+ *                 compiles every hook away, SudokuCountingStats counts nodes,
+ *                 dead ends, guesses and propagated cells and splits the
+ *                 wall-clock time between propagation and search.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include <chrono>
+ #include <cstddef>
+ #include <cstdint>
+
+ /*==============================================================================
+  *  TYPE DEFINITIONS
+  *============================================================================*/
+
+ /* Counters of one solve, or of many solves once accumulated */
+ struct SudokuSolveStats
+ {
+     uint64_t nodes;              // Search nodes entered
+     uint64_t backtracks;         // Nodes abandoned because propagation hit a contradiction
+     uint64_t guesses;            // Candidates tried at branching cells
+     uint64_t propagations;       // Cells filled by naked or hidden singles
+     uint32_t maxDepth;           // Most guesses on one path (0 if no guess was needed)
+     double   propagateSeconds;   // Time spent propagating singles
+     double   searchSeconds;      // Rest of the solve: loading, branch selection, trail undo
+ };
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuNoStats
+  *  DESCRIPTION: Statistics policy that records nothing. Every hook is an
+  *               empty inline function, so a solver built with it compiles to
+  *               the same code as one without hooks.
+  *----------------------------------------------------------------------------*/
+ class SudokuNoStats
+ {
+ public:
+     static constexpr bool ENABLED = false;
+
+     void beginSolve(void) {}
+     void endSolve(void) {}
+     void enterNode(void) {}
+     void deadEnd(void) {}
+     void enterBranch(void) {}
+     void leaveBranch(void) {}
+     void beginPropagate(int) {}
+     void endPropagate(int) {}
+
+     /* Nothing to report */
+     bool read(SudokuSolveStats&) const { return false; }
+ };
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuCountingStats
+  *  DESCRIPTION: Statistics policy that fills a SudokuSolveStats for each
+  *               solve. Costs two clock reads per search node.
+  *----------------------------------------------------------------------------*/
+ class SudokuCountingStats
+ {
+ private:
+     typedef std::chrono::steady_clock Clock;
+
+     SudokuSolveStats  current;          // Counters of the solve in progress or last finished
+     uint32_t          depth;            // Guesses on the current path
+     int               emptyBefore;      // Empty cells when the running propagation started
+     Clock::time_point solveStart;       // Start of the solve
+     Clock::time_point propagateStart;   // Start of the running propagation
+
+ public:
+     static constexpr bool ENABLED = true;
+
+     SudokuCountingStats() : current(), depth(0), emptyBefore(0) {}
+
+     /* Clears the counters and starts the solve timer */
+     void beginSolve(void)
+     {
+         current = SudokuSolveStats();
+         depth = 0;
+         solveStart = Clock::now();
+     }
+
+     /* Stops the solve timer; time outside propagation counts as search */
+     void endSolve(void)
+     {
+         double total = std::chrono::duration<double>(Clock::now() - solveStart).count();
+         current.searchSeconds = (total > current.propagateSeconds) ? total - current.propagateSeconds : 0.0;
+     }
+
+     void enterNode(void) { current.nodes++; }
+     void deadEnd(void) { current.backtracks++; }
+
+     /* One candidate of a branching cell is being tried */
+     void enterBranch(void)
+     {
+         current.guesses++;
+         if (++depth > current.maxDepth)
+         {
+             current.maxDepth = depth;
+         }
+     }
+
+     void leaveBranch(void) { depth--; }
+
+     /* Starts the propagation timer; 'emptyCells' is the board's empty count */
+     void beginPropagate(int emptyCells)
+     {
+         emptyBefore = emptyCells;
+         propagateStart = Clock::now();
+     }
+
+     /* Adds the propagation time and the number of cells it filled */
+     void endPropagate(int emptyCells)
+     {
+         current.propagateSeconds += std::chrono::duration<double>(Clock::now() - propagateStart).count();
+         current.propagations += static_cast<uint64_t>(emptyBefore - emptyCells);
+     }
+
+     /* Copies the counters of the last solve */
+     bool read(SudokuSolveStats& stats) const
+     {
+         stats = current;
+         return true;
+     }
+ };
+
+ /*==============================================================================
+  *  FUNCTION DECLARATIONS
+  *============================================================================*/
+
+ /* Adds one solve to a running total: counters and times are summed, the
+  * depth is the maximum of the two */
+ void accumulateSudokuSolveStats(SudokuSolveStats& total, const SudokuSolveStats& solve);
+
+ /* Writes the stats as a JSON object ({"nodes":...}) and returns its length,
+  * or 0 if it does not fit in 'size' bytes. Times are in microseconds. */
+ size_t formatSudokuSolveStats(const SudokuSolveStats& stats, char* text, size_t size);
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
@@ -0,0 +1,96 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuTables
+ *  FILE         : SudokuTables.hpp
+ *  DESCRIPTION  : Compile-time lookup tables for every board size: row,
+ *                 column and box of every cell, the cells of every unit and
+ *                 the peers of every cell (20 on the 9x9 board). Cells are
+ *                 indexed row-major from 0.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include "SudokuBoard.hpp"
+ #include <cstdint>
+ #include <type_traits>
+
+ /*==============================================================================
+  *  CONSTANTS
+  *============================================================================*/
+
+ const unsigned int SUDOKU_ALL_DIGITS = 0x1FF;   // Bits for digits 1-9
+
+ /*==============================================================================
+  *  TYPE DEFINITIONS
+  *============================================================================*/
+
+ /*
+  * Lookup tables for a board of Box x Box boxes. Units are numbered 0 to
+  * SIZE-1 for rows, SIZE to 2*SIZE-1 for columns and 2*SIZE to 3*SIZE-1 for
+  * boxes. Cell indices fit in a byte up to 16x16.
+  */
+ template <int Box>
+ struct BasicSudokuTables
+ {
+     static constexpr int SIZE  = SudokuDimensions<Box>::SIZE;
+     static constexpr int CELLS = SudokuDimensions<Box>::CELLS;
+     static constexpr int UNITS = SudokuDimensions<Box>::UNITS;
+     static constexpr int PEERS = 2 * (SIZE - 1) + (Box - 1) * (Box - 1);
+
+     typedef typename std::conditional<(CELLS > 256), uint16_t, uint8_t>::type Index;
+
+     Index rowOf[CELLS];
+     Index colOf[CELLS];
+     Index boxOf[CELLS];
+     Index units[UNITS][SIZE];     // Cells of each unit
+     Index peers[CELLS][PEERS];    // Cells sharing a unit with each cell
+
+     constexpr BasicSudokuTables() : rowOf(), colOf(), boxOf(), units(), peers()
+     {
+         for (int cell = 0; cell < CELLS; cell++)
+         {
+             int row = cell / SIZE;
+             int col = cell % SIZE;
+             int box = (row / Box) * Box + col / Box;
+
+             rowOf[cell] = static_cast<Index>(row);
+             colOf[cell] = static_cast<Index>(col);
+             boxOf[cell] = static_cast<Index>(box);
+
+             units[row][col] = static_cast<Index>(cell);
+             units[SIZE + col][row] = static_cast<Index>(cell);
+             units[2 * SIZE + box][(row % Box) * Box + col % Box] = static_cast<Index>(cell);
+         }
+
+         for (int cell = 0; cell < CELLS; cell++)
+         {
+             int count = 0;
+             for (int other = 0; other < CELLS; other++)
+             {
+                 if (other != cell &&
+                     (rowOf[other] == rowOf[cell] || colOf[other] == colOf[cell] ||
+                      boxOf[other] == boxOf[cell]))
+                 {
+                     peers[cell][count++] = static_cast<Index>(other);
+                 }
+             }
+         }
+     }
+ };
+
+ /* Tables for every box size, built at compile time on first use */
+ template <int Box>
+ inline constexpr BasicSudokuTables<Box> SUDOKU_BOX_TABLES;
+
+ /* The classic 9x9 tables */
+ typedef BasicSudokuTables<3> SudokuTables;
+
+ inline constexpr const SudokuTables& SUDOKU_TABLES = SUDOKU_BOX_TABLES<3>;
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
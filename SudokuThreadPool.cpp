@@ -0,0 +1,168 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuThreadPool
+ *  FILE         : SudokuThreadPool.cpp
+ *  DESCRIPTION  : Implements the work-stealing thread pool.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuThreadPool.hpp"
+
+/*==============================================================================
+ *  CONSTRUCTOR / DESTRUCTOR
+ *============================================================================*/
+
+/* Creates one deque per worker and starts the threads */
+SudokuThreadPool::SudokuThreadPool(unsigned int threadCount)
+    : queued(0), outstanding(0), stopping(false), nextQueue(0)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0)
+        {
+            threadCount = 1;
+        }
+    }
+
+    for (unsigned int index = 0; index < threadCount; index++)
+    {
+        queues.emplace_back(new WorkerQueue());
+    }
+    for (unsigned int index = 0; index < threadCount; index++)
+    {
+        workers.emplace_back(&SudokuThreadPool::workerLoop, this, index);
+    }
+}
+
+/* Lets the workers drain their deques, then joins them */
+SudokuThreadPool::~SudokuThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+/*==============================================================================
+ *  PUBLIC FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Number of worker threads */
+unsigned int SudokuThreadPool::size(void) const
+{
+    return static_cast<unsigned int>(workers.size());
+}
+
+/* Queues the task round-robin and wakes one idle worker */
+void SudokuThreadPool::submit(Task task)
+{
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        queued++;
+        outstanding++;
+    }
+
+    WorkerQueue& queue = *queues[nextQueue++ % queues.size()];
+    {
+        std::lock_guard<std::mutex> guard(queue.lock);
+        queue.tasks.push_back(std::move(task));
+    }
+    workAvailable.notify_one();
+}
+
+/* Waits until the outstanding task count drops to zero */
+void SudokuThreadPool::wait(void)
+{
+    std::unique_lock<std::mutex> guard(stateLock);
+    allDone.wait(guard, [this] { return outstanding == 0; });
+}
+
+/*==============================================================================
+ *  PRIVATE FUNCTION DEFINITIONS
+ *============================================================================*/
+
+/* Owner end of the deque: oldest task first. Every task comes from submit,
+ * so there is no nested work whose locality a LIFO end would help */
+bool SudokuThreadPool::popLocal(unsigned int index, Task& task)
+{
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> guard(queue.lock);
+
+    if (queue.tasks.empty())
+    {
+        return false;
+    }
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+}
+
+/* Thief end of the deque: oldest task first, victims visited in ring order */
+bool SudokuThreadPool::steal(unsigned int thief, Task& task)
+{
+    size_t count = queues.size();
+
+    for (size_t offset = 1; offset < count; offset++)
+    {
+        WorkerQueue& queue = *queues[(thief + offset) % count];
+        std::lock_guard<std::mutex> guard(queue.lock);
+
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Runs local work, then stolen work, then sleeps until more is submitted */
+void SudokuThreadPool::workerLoop(unsigned int index)
+{
+    Task task;
+
+    while (true)
+    {
+        if (popLocal(index, task) || steal(index, task))
+        {
+            queued--;
+            task(index);
+            task = nullptr;
+
+            std::lock_guard<std::mutex> guard(stateLock);
+            if (--outstanding == 0)
+            {
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(stateLock);
+        if (queued.load() > 0)
+        {
+            guard.unlock();
+            std::this_thread::yield();   // A submit is between its count and its push
+            continue;
+        }
+        if (stopping)
+        {
+            return;
+        }
+        workAvailable.wait(guard, [this] { return stopping || queued.load() > 0; });
+    }
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
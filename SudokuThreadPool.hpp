@@ -0,0 +1,95 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuThreadPool
+ *  FILE         : SudokuThreadPool.hpp
+ *  DESCRIPTION  : Fixed-size thread pool with one task deque per worker.
+ *                 Workers pop their own deque from the back and steal from
+ *                 the front of the other deques when they run dry, so uneven
+ *                 task costs do not leave cores idle.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include <atomic>
+ #include <condition_variable>
+ #include <cstddef>
+ #include <deque>
+ #include <functional>
+ #include <memory>
+ #include <mutex>
+ #include <thread>
+ #include <vector>
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuThreadPool
+  *  DESCRIPTION: Work-stealing pool. Tasks receive the index of the worker that
+  *               runs them so callers can keep per-worker scratch state.
+  *               Workers run their own tasks oldest first, so tasks start
+  *               roughly in submission order and a caller that consumes
+  *               results in that order (the batch writer) is not left
+  *               waiting on a task that was queued first but runs last.
+  *----------------------------------------------------------------------------*/
+ class SudokuThreadPool
+ {
+ public:
+     /* Task signature: the argument is the worker index in [0, size()) */
+     typedef std::function<void(unsigned int)> Task;
+
+ private:
+     /* Deque owned by one worker, shared with thieves */
+     struct WorkerQueue
+     {
+         std::mutex       lock;
+         std::deque<Task> tasks;
+     };
+
+     std::vector<std::unique_ptr<WorkerQueue>> queues;   // One deque per worker
+     std::vector<std::thread>  workers;                  // Worker threads
+     std::mutex                stateLock;                // Guards the counters below
+     std::condition_variable   workAvailable;            // Signalled on submit/stop
+     std::condition_variable   allDone;                  // Signalled when outstanding hits 0
+     std::atomic<long>         queued;                   // Tasks sitting in a deque
+     size_t                    outstanding;              // Tasks submitted but not finished
+     bool                      stopping;                 // Set by the destructor
+     std::atomic<unsigned int> nextQueue;                // Round-robin submit cursor
+
+     /* Takes the oldest task from the worker's own deque */
+     bool popLocal(unsigned int index, Task& task);
+
+     /* Takes a task from the front of another worker's deque */
+     bool steal(unsigned int thief, Task& task);
+
+     /* Worker thread body */
+     void workerLoop(unsigned int index);
+
+ public:
+     /* Starts the workers; 0 means one per hardware thread */
+     explicit SudokuThreadPool(unsigned int threadCount = 0);
+
+     /* Finishes queued work and joins the workers */
+     ~SudokuThreadPool();
+
+     SudokuThreadPool(const SudokuThreadPool&) = delete;
+     SudokuThreadPool& operator=(const SudokuThreadPool&) = delete;
+
+     /* Number of worker threads */
+     unsigned int size(void) const;
+
+     /* Queues a task on the next worker's deque */
+     void submit(Task task);
+
+     /* Blocks until every submitted task has finished */
+     void wait(void);
+ };
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
@@ -0,0 +1,117 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuTrail
+ *  FILE         : SudokuTrail.hpp
+ *  DESCRIPTION  : Fixed-size ring of cell changes that can be taken back and
+ *                 replayed in order. It is the board's move history and the
+ *                 solver's backtracking trail.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+ #pragma once
+
+ /*==============================================================================
+  *  INCLUDES
+  *============================================================================*/
+ #include <cstdint>
+
+ /*==============================================================================
+  *  TYPE DEFINITIONS
+  *============================================================================*/
+
+ /* One cell change; values are 0 for an empty cell. Four bytes, so a change
+  * is recorded with a single store. */
+ struct SudokuTrailEntry
+ {
+     uint16_t cell;     // Row-major cell index
+     uint8_t  before;   // Value the change replaced
+     uint8_t  after;    // Value the change wrote
+ };
+
+ /* Smallest power of two that holds 'changes' entries */
+ constexpr int sudokuTrailCapacity(int changes, int capacity = 1)
+ {
+     return (capacity >= changes) ? capacity : sudokuTrailCapacity(changes, capacity * 2);
+ }
+
+ /*==============================================================================
+  *  CLASS DEFINITIONS
+  *============================================================================*/
+
+ /*------------------------------------------------------------------------------
+  *  CLASS NAME: SudokuTrail
+  *  DESCRIPTION: Keeps the last Capacity changes in place, with no allocation.
+  *               undo() hands back the newest change still applied and redo()
+  *               the oldest one taken back; recording a new change forgets
+  *               whatever could have been redone, and once the ring is full
+  *               the oldest change is dropped. The caller owns the cells and
+  *               applies the returned entry. Capacity must be a power of two.
+  *----------------------------------------------------------------------------*/
+ template <int Capacity>
+ class SudokuTrail
+ {
+     static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0 && Capacity <= 32768,
+                   "SudokuTrail capacity must be a power of two up to 32768");
+
+ private:
+     static constexpr unsigned int WRAP = Capacity - 1;
+
+     SudokuTrailEntry entries[Capacity];   // Ring storage
+     uint16_t         first;               // Slot of the oldest change kept
+     uint16_t         applied;             // Changes that can be undone, from 'first'
+     uint16_t         undone;              // Changes after those that can be redone
+
+ public:
+     static constexpr int CAPACITY = Capacity;
+
+     /* Constructor: starts with no history */
+     SudokuTrail() : first(0), applied(0), undone(0) {}
+
+     /* Forgets every change */
+     void clear(void) { first = 0; applied = 0; undone = 0; }
+
+     /* Forgets the changes that could be redone, keeping those applied */
+     void dropRedo(void) { undone = 0; }
+
+     /* Number of changes that can be undone; also a mark to undo back to */
+     int size(void) const { return applied; }
+
+     bool canUndo(void) const { return applied != 0; }
+     bool canRedo(void) const { return undone != 0; }
+
+     /* Records a change that has just been made */
+     void record(int cell, int before, int after)
+     {
+         if (applied == Capacity)
+         {
+             first = static_cast<uint16_t>((first + 1) & WRAP);
+             applied--;
+         }
+         entries[(first + applied) & WRAP] = SudokuTrailEntry{static_cast<uint16_t>(cell),
+                                                              static_cast<uint8_t>(before),
+                                                              static_cast<uint8_t>(after)};
+         applied++;
+         undone = 0;
+     }
+
+     /* Takes back the newest applied change; the caller writes entry.before.
+      * Only valid if canUndo(). */
+     const SudokuTrailEntry& undo(void)
+     {
+         applied--;
+         undone++;
+         return entries[(first + applied) & WRAP];
+     }
+
+     /* Replays the oldest undone change; the caller writes entry.after.
+      * Only valid if canRedo(). */
+     const SudokuTrailEntry& redo(void)
+     {
+         undone--;
+         return entries[(first + applied++) & WRAP];
+     }
+ };
+
+ /******************************************************************************
+  *  END OF FILE
+  ******************************************************************************/
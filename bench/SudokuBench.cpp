@@ -0,0 +1,717 @@
+/******************************************************************************
+ *  MODULE NAME  : SudokuBench
+ *  FILE         : SudokuBench.cpp
+ *  DESCRIPTION  : Google Benchmark suite for the solver and board hot paths.
+ *                 Micro benchmarks cover SudokuSolver::search,
+ *                 SudokuSolver::isSafe, SudokuBoard::isGameRuleValid,
+ *                 SudokuBoard::checkPlacement and session moves;
+ *                 macro benchmarks solve the bundled easy, hard and 17-clue
+ *                 corpora with each solver engine (and with solver
+ *                 statistics enabled) and report ns/puzzle, nodes and
+ *                 allocations per solve, and time canonicalization; the grid kernels
+ *                 (candidates, validation) run at every SIMD level the CPU
+ *                 supports.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : April 2025
+ ******************************************************************************/
+
+/*==============================================================================
+ *  INCLUDES
+ *============================================================================*/
+#include "SudokuBatch.hpp"
+#include "SudokuBoard.hpp"
+#include "SudokuCache.hpp"
+#include "SudokuCanonical.hpp"
+#include "SudokuDlxSolver.hpp"
+#include "SudokuLockstep.hpp"
+#include "SudokuSession.hpp"
+#include "SudokuSimd.hpp"
+#include "SudokuSolver.hpp"
+#ifdef SUDOKU_BUILD_ADVANCED
+#include "SudokuAdvancedChecks.hpp"
+#include "SudokuHintEngine.hpp"
+#endif
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifndef SUDOKU_BENCH_DATA_DIR
+#define SUDOKU_BENCH_DATA_DIR "bench/data"
+#endif
+
+/*==============================================================================
+ *  ALLOCATION COUNTER
+ *============================================================================*/
+
+namespace
+{
+    std::atomic<uint64_t> allocationCount(0);   // Calls to any operator new
+
+    /* Counts the call and takes the memory from malloc (aligned_alloc for
+     * over-aligned types), so every overload below releases it with free */
+    void* countedAllocate(std::size_t size, std::size_t alignment) noexcept
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        size = size ? size : 1;
+        if (alignment <= alignof(std::max_align_t))
+        {
+            return std::malloc(size);
+        }
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    }
+
+    /* Throwing form of countedAllocate */
+    void* countedAllocateOrThrow(std::size_t size, std::size_t alignment)
+    {
+        if (void* pointer = countedAllocate(size, alignment))
+        {
+            return pointer;
+        }
+        throw std::bad_alloc();
+    }
+
+    /* Returns memory from countedAllocate */
+    void countedRelease(void* pointer) noexcept
+    {
+        std::free(pointer);
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    return countedAllocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size)
+{
+    return countedAllocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return countedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return countedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAllocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAllocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept
+{
+    countedRelease(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    countedRelease(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    countedRelease(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    countedRelease(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    countedRelease(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+    countedRelease(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept
+{
+    countedRelease(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept
+{
+    countedRelease(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    countedRelease(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+    countedRelease(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    countedRelease(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    countedRelease(pointer);
+}
+
+/*==============================================================================
+ *  SOLVER ACCESS
+ *============================================================================*/
+
+/*------------------------------------------------------------------------------
+ *  CLASS NAME: SudokuSolverBenchAccess
+ *  DESCRIPTION: Friend of SudokuSolver that exposes the private search steps
+ *               so they can be timed in isolation.
+ *----------------------------------------------------------------------------*/
+class SudokuSolverBenchAccess
+{
+public:
+    typedef SudokuSolver::SearchState State;
+
+    /* Builds a search state from the grid */
+    static bool load(const SudokuSolver& solver, const uint8_t* grid, State& state)
+    {
+        return solver.loadState(SudokuConstGridView(grid), state);
+    }
+
+    /* Runs the search from a copy of the loaded state */
+    static bool search(SudokuSolver& solver, const State& state)
+    {
+        solver.solutionLimit = 1;
+        solver.solutionsFound = 0;
+        solver.context.state = state;
+        solver.context.trail.clear();
+        solver.context.removalCount = 0;
+        return solver.search();
+    }
+
+    /* Single placement check */
+    static bool isSafe(const SudokuSolver& solver, const State& state, int cell, int num)
+    {
+        return solver.isSafe(state, cell, num);
+    }
+};
+
+/*==============================================================================
+ *  CORPORA
+ *============================================================================*/
+
+namespace
+{
+    /* Puzzles of one corpus stored back to back, 81 cells each */
+    struct Corpus
+    {
+        std::string          name;
+        std::vector<uint8_t> grids;
+        size_t               count;
+    };
+
+    /* Loads a bundled corpus file, returns false if it cannot be read */
+    bool loadCorpus(const std::string& directory, const char* name, Corpus& corpus)
+    {
+        std::string path = directory + "/" + name + ".txt";
+        uint8_t cells[81];
+        const char* line;
+        size_t length;
+
+        corpus.name = name;
+        corpus.count = 0;
+        try
+        {
+            SudokuPuzzleReader reader(path.c_str());
+            while (reader.nextLine(line, length))
+            {
+                if (parsePuzzleLine(line, length, SudokuGridView(cells)))
+                {
+                    corpus.grids.insert(corpus.grids.end(), cells, cells + 81);
+                    corpus.count++;
+                }
+            }
+        }
+        catch (const SudokuBoardException& error)
+        {
+            std::cerr << path << ": " << error.what() << std::endl;
+            return false;
+        }
+        return corpus.count > 0;
+    }
+
+    /* Row-major copy of the preset board in SudokuBoard's constructor */
+    void presetGrid(uint8_t grid[81])
+    {
+        SudokuBoard board;
+        std::memcpy(grid, board.view().data(), 81);
+    }
+}
+
+/*==============================================================================
+ *  MICRO BENCHMARKS
+ *============================================================================*/
+
+/* Full search on the preset board (state already loaded) */
+static void BM_SolverSearch(benchmark::State& state)
+{
+    SudokuSolver solver;
+    SudokuSolverBenchAccess::State loaded;
+    uint8_t grid[81];
+
+    presetGrid(grid);
+    SudokuSolverBenchAccess::load(solver, grid, loaded);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(SudokuSolverBenchAccess::search(solver, loaded));
+    }
+}
+BENCHMARK(BM_SolverSearch);
+
+/* One isSafe call per iteration, cycling through every (cell, digit) pair */
+static void BM_SolverIsSafe(benchmark::State& state)
+{
+    SudokuSolver solver;
+    SudokuSolverBenchAccess::State loaded;
+    uint8_t grid[81];
+    int cell = 0;
+    int num = 1;
+
+    presetGrid(grid);
+    SudokuSolverBenchAccess::load(solver, grid, loaded);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(SudokuSolverBenchAccess::isSafe(solver, loaded, cell, num));
+        if (++num > 9)
+        {
+            num = 1;
+            cell = (cell + 1) % 81;
+        }
+    }
+}
+BENCHMARK(BM_SolverIsSafe);
+
+/* Accepted placement: (1,3) <- 4 on the preset board */
+static void BM_BoardIsGameRuleValid(benchmark::State& state)
+{
+    SudokuBoard board;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(board.isGameRuleValid(1, 3, 4));
+    }
+}
+BENCHMARK(BM_BoardIsGameRuleValid);
+
+/* Rejected placement: (1,3) <- 5 clashes with the row, reported by throwing */
+static void BM_BoardIsGameRuleValidReject(benchmark::State& state)
+{
+    SudokuBoard board;
+
+    for (auto _ : state)
+    {
+        try
+        {
+            benchmark::DoNotOptimize(board.isGameRuleValid(1, 3, 5));
+        }
+        catch (const SudokuBoardException&)
+        {
+        }
+    }
+}
+BENCHMARK(BM_BoardIsGameRuleValidReject);
+
+/* Same rejected placement through the non-throwing check */
+static void BM_BoardCheckPlacementReject(benchmark::State& state)
+{
+    SudokuBoard board;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(board.checkPlacement(1, 3, 5));
+    }
+}
+BENCHMARK(BM_BoardCheckPlacementReject);
+
+/* Accepted placement through the non-throwing check */
+static void BM_BoardCheckPlacement(benchmark::State& state)
+{
+    SudokuBoard board;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(board.checkPlacement(1, 3, 4));
+    }
+}
+BENCHMARK(BM_BoardCheckPlacement);
+
+/* One move and its undo: (1,3) <- 4, then cleared; masks updated both ways */
+static void BM_BoardPlaceClear(benchmark::State& state)
+{
+    SudokuBoard board;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(board.tryPlace(1, 3, 4));
+        benchmark::DoNotOptimize(board.tryClear(1, 3));
+    }
+}
+BENCHMARK(BM_BoardPlaceClear);
+
+/* A move and its undo on one session after another out of Arg(0) open ones,
+ * so large counts pay the cache misses of a server full of games */
+static void BM_SessionMoveUndo(benchmark::State& state)
+{
+    size_t count = static_cast<size_t>(state.range(0));
+    SudokuSessionManager sessions(count);
+    std::vector<uint64_t> ids(count);
+    size_t next = 0;
+
+    for (size_t index = 0; index < count; index++)
+    {
+        ids[index] = sessions.create();
+    }
+    for (auto _ : state)
+    {
+        SudokuSession& session = *sessions.find(ids[next]);
+        benchmark::DoNotOptimize(session.move(1, 3, 4));
+        benchmark::DoNotOptimize(session.undo());
+        next = (next + 1 == count) ? 0 : next + 1;
+    }
+    state.counters["bytes_per_session"] = static_cast<double>(sessions.bytesReserved()) / static_cast<double>(count);
+}
+BENCHMARK(BM_SessionMoveUndo)->Arg(1)->Arg(100000);
+
+/*==============================================================================
+ *  MACRO BENCHMARKS
+ *============================================================================*/
+
+/* Solves the corpus round-robin, one puzzle per iteration. Instantiated for
+ * each engine so the backends can be compared head to head. */
+template <class Engine>
+static void BM_SolveCorpus(benchmark::State& state, const Corpus* corpus)
+{
+    Engine solver;
+    uint8_t grid[81];
+    size_t next = 0;
+    uint64_t nodes = 0;
+    uint64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+
+    for (auto _ : state)
+    {
+        std::memcpy(grid, corpus->grids.data() + next * 81, 81);
+        benchmark::DoNotOptimize(solver.solve(SudokuGridView(grid)));
+        nodes += solver.getNodesVisited();
+        next = (next + 1 == corpus->count) ? 0 : next + 1;
+    }
+
+    uint64_t allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+    state.SetItemsProcessed(state.iterations());
+    state.counters["nodes"] = benchmark::Counter(static_cast<double>(nodes), benchmark::Counter::kAvgIterations);
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+
+/* Solves the whole corpus per iteration through solveMany, as the batch
+ * mode does; items are puzzles, so the rate compares with BM_SolveCorpus */
+template <class Engine>
+static void BM_SolveManyCorpus(benchmark::State& state, const Corpus* corpus)
+{
+    std::unique_ptr<Engine> solver(new Engine());
+    std::vector<uint8_t> grids(corpus->grids.size());
+    std::vector<uint8_t*> pointers(corpus->count);
+    std::vector<int> found(corpus->count);
+    uint64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::memcpy(grids.data(), corpus->grids.data(), grids.size());
+        for (size_t index = 0; index < corpus->count; index++)
+        {
+            pointers[index] = grids.data() + index * 81;
+        }
+        state.ResumeTiming();
+
+        solver->solveMany(pointers.data(), corpus->count, 1, found.data());
+    }
+
+    // Per puzzle, like BM_SolveCorpus
+    uint64_t allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+    state.SetItemsProcessed(state.iterations() * corpus->count);
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocations) / static_cast<double>(corpus->count),
+                                                  benchmark::Counter::kAvgIterations);
+}
+
+/* Uniqueness check over the corpus: search continues to a second solution */
+template <class Engine>
+static void BM_UniqueCorpus(benchmark::State& state, const Corpus* corpus)
+{
+    Engine solver;
+    size_t next = 0;
+    uint64_t nodes = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(solver.hasUniqueSolution(SudokuConstGridView(corpus->grids.data() + next * 81)));
+        nodes += solver.getNodesVisited();
+        next = (next + 1 == corpus->count) ? 0 : next + 1;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["nodes"] = benchmark::Counter(static_cast<double>(nodes), benchmark::Counter::kAvgIterations);
+}
+
+/* Canonical form and hash of a corpus puzzle */
+static void BM_CanonicalCorpus(benchmark::State& state, const Corpus* corpus)
+{
+    SudokuCanonicalizer canonicalizer;
+    SudokuCanonicalForm form;
+    size_t next = 0;
+
+    for (auto _ : state)
+    {
+        canonicalizer.canonicalize(SudokuConstGridView(corpus->grids.data() + next * 81), form);
+        benchmark::DoNotOptimize(form.hash);
+        next = (next + 1 == corpus->count) ? 0 : next + 1;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+/* Cached solve of a corpus puzzle that is already in the cache */
+static void BM_CacheHitCorpus(benchmark::State& state, const Corpus* corpus)
+{
+    SudokuSolutionCache cache(4 * corpus->count);   // Raw and canonical entries, with slack for set conflicts
+    SudokuCachedSolver solver(cache);
+    uint8_t grid[81];
+    size_t next = 0;
+
+    for (size_t index = 0; index < corpus->count; index++)
+    {
+        std::memcpy(grid, corpus->grids.data() + index * 81, sizeof(grid));
+        solver.solve(SudokuGridView(grid));
+    }
+
+    for (auto _ : state)
+    {
+        std::memcpy(grid, corpus->grids.data() + next * 81, sizeof(grid));
+        benchmark::DoNotOptimize(solver.solve(SudokuGridView(grid)));
+        next = (next + 1 == corpus->count) ? 0 : next + 1;
+    }
+
+    SudokuCacheStats stats = cache.stats();
+    state.SetItemsProcessed(state.iterations());
+    state.counters["evictions"] = static_cast<double>(stats.evictions);
+}
+
+#ifdef SUDOKU_BUILD_ADVANCED
+/* Human-technique grading of a corpus puzzle */
+static void BM_GradeCorpus(benchmark::State& state, const Corpus* corpus)
+{
+    SudokuAdvancedChecks checks;
+    size_t next = 0;
+    uint64_t steps = 0;
+
+    for (auto _ : state)
+    {
+        SudokuGrade grade = checks.grade(SudokuConstGridView(corpus->grids.data() + next * 81));
+        benchmark::DoNotOptimize(grade);
+        steps += static_cast<uint64_t>(grade.stepCount);
+        next = (next + 1 == corpus->count) ? 0 : next + 1;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["steps"] = benchmark::Counter(static_cast<double>(steps), benchmark::Counter::kAvgIterations);
+}
+
+/* Plays the corpus puzzles hint by hint: each iteration asks for the next
+ * placement and makes it; a solved or stuck game moves on to the next puzzle */
+static void BM_HintSession(benchmark::State& state, const Corpus* corpus)
+{
+    SudokuHintEngine hints;
+    SudokuLogicStep step;
+    size_t next = 0;
+    uint64_t resets = 1;
+
+    hints.reset(SudokuConstGridView(corpus->grids.data()));
+    for (auto _ : state)
+    {
+        if (hints.nextPlacement(step) == SudokuHintStatus::Step)
+        {
+            hints.applyMove(step.cell, step.digit);
+        }
+        else
+        {
+            next = (next + 1 == corpus->count) ? 0 : next + 1;
+            hints.reset(SudokuConstGridView(corpus->grids.data() + next * 81));
+            resets++;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["games"] = static_cast<double>(resets);
+}
+#endif
+
+/*==============================================================================
+ *  GRID KERNEL BENCHMARKS
+ *============================================================================*/
+
+/* All 81 candidate masks of a corpus puzzle */
+static void BM_Candidates(benchmark::State& state, SudokuSimdLevel level, const Corpus* corpus)
+{
+    uint16_t candidates[81];
+    size_t next = 0;
+
+    for (auto _ : state)
+    {
+        computeSudokuCandidates(SudokuConstGridView(corpus->grids.data() + next * 81), candidates, level);
+        benchmark::DoNotOptimize(candidates);
+        next = (next + 1 == corpus->count) ? 0 : next + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/* One finished grid checked per iteration */
+static void BM_ValidateGrid(benchmark::State& state, SudokuSimdLevel level, const Corpus* solutions)
+{
+    size_t next = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(isValidSudokuSolution(SudokuConstGridView(solutions->grids.data() + next * 81), level));
+        next = (next + 1 == solutions->count) ? 0 : next + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/* The whole solution corpus checked in one call per iteration */
+static void BM_ValidateBatch(benchmark::State& state, SudokuSimdLevel level, const Corpus* solutions)
+{
+    std::unique_ptr<bool[]> valid(new bool[solutions->count]);
+
+    for (auto _ : state)
+    {
+        validateSudokuSolutions(solutions->grids.data(), solutions->count, valid.get(), level);
+        benchmark::DoNotOptimize(valid.get());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(solutions->count));
+}
+
+/*==============================================================================
+ *  MAIN FUNCTION
+ *============================================================================*/
+
+/* Loads the corpora, registers the macro benchmarks and runs everything */
+int main(int argc, char** argv)
+{
+    const char* overrideDir = std::getenv("SUDOKU_BENCH_DATA");
+    std::string dataDir = overrideDir ? overrideDir : SUDOKU_BENCH_DATA_DIR;
+    static const char* const CORPUS_NAMES[] = { "easy", "hard", "17clue" };
+    static Corpus corpora[3];
+
+    for (int index = 0; index < 3; index++)
+    {
+        if (loadCorpus(dataDir, CORPUS_NAMES[index], corpora[index]))
+        {
+            std::string name = "BM_SolveCorpus/" + corpora[index].name;
+            benchmark::RegisterBenchmark(name.c_str(), BM_SolveCorpus<SudokuSolver>, &corpora[index]);
+
+            name = "BM_UniqueCorpus/" + corpora[index].name;
+            benchmark::RegisterBenchmark(name.c_str(), BM_UniqueCorpus<SudokuSolver>, &corpora[index]);
+
+            name = "BM_StatsSolveCorpus/" + corpora[index].name;
+            benchmark::RegisterBenchmark(name.c_str(), BM_SolveCorpus<SudokuInstrumentedSolver>, &corpora[index]);
+
+            name = "BM_DlxSolveCorpus/" + corpora[index].name;
+            benchmark::RegisterBenchmark(name.c_str(), BM_SolveCorpus<SudokuDlxSolver>, &corpora[index]);
+
+            name = "BM_DlxUniqueCorpus/" + corpora[index].name;
+            benchmark::RegisterBenchmark(name.c_str(), BM_UniqueCorpus<SudokuDlxSolver>, &corpora[index]);
+
+            name = "BM_SolveManyCorpus/" + corpora[index].name;
+            benchmark::RegisterBenchmark(name.c_str(), BM_SolveManyCorpus<SudokuSolver>, &corpora[index]);
+
+            name = "BM_LockstepSolveManyCorpus/" + corpora[index].name;
+            benchmark::RegisterBenchmark(name.c_str(), BM_SolveManyCorpus<SudokuLockstepSolver>, &corpora[index]);
+
+            name = "BM_CanonicalCorpus/" + corpora[index].name;
+            benchmark::RegisterBenchmark(name.c_str(), BM_CanonicalCorpus, &corpora[index]);
+
+            name = "BM_CacheHitCorpus/" + corpora[index].name;
+            benchmark::RegisterBenchmark(name.c_str(), BM_CacheHitCorpus, &corpora[index]);
+#ifdef SUDOKU_BUILD_ADVANCED
+            name = "BM_GradeCorpus/" + corpora[index].name;
+            benchmark::RegisterBenchmark(name.c_str(), BM_GradeCorpus, &corpora[index]);
+
+            name = "BM_HintSession/" + corpora[index].name;
+            benchmark::RegisterBenchmark(name.c_str(), BM_HintSession, &corpora[index]);
+#endif
+        }
+    }
+
+    // Grid kernels: candidates on the hard puzzles, validation on their solutions
+    static Corpus solutions;
+    solutions.name = "solutions";
+    solutions.count = corpora[1].count;
+    solutions.grids = corpora[1].grids;
+    SudokuSolver solver;
+    for (size_t index = 0; index < solutions.count; index++)
+    {
+        solver.solve(SudokuGridView(solutions.grids.data() + index * 81));
+    }
+
+    static const SudokuSimdLevel LEVELS[] = { SudokuSimdLevel::Scalar, SudokuSimdLevel::Sse42, SudokuSimdLevel::Avx2 };
+    for (SudokuSimdLevel level : LEVELS)
+    {
+        if (level > sudokuSimdLevel() || solutions.count == 0)
+        {
+            break;
+        }
+        std::string suffix = std::string("/") + sudokuSimdLevelName(level);
+        benchmark::RegisterBenchmark(("BM_Candidates" + suffix).c_str(), BM_Candidates, level, &corpora[1]);
+        benchmark::RegisterBenchmark(("BM_ValidateGrid" + suffix).c_str(), BM_ValidateGrid, level, &solutions);
+        benchmark::RegisterBenchmark(("BM_ValidateBatch" + suffix).c_str(), BM_ValidateBatch, level, &solutions);
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
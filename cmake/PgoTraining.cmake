@@ -0,0 +1,74 @@
+# Training workload for profile-guided builds, run by the pgo-train target:
+#
+#    cmake -DSUDOKU_PROGRAM=<SudokuProject> -DSUDOKU_DATA_DIR=<bench/data>
+#          -DSUDOKU_WORK_DIR=<scratch dir> -DSUDOKU_PROFILE_DIR=<SUDOKU_PGO_DIR>
+#          [-DSUDOKU_GENERATOR=ON] [-DSUDOKU_ADVANCED=ON] [-DLLVM_PROFDATA=<path>]
+#          -P PgoTraining.cmake
+#
+# The instrumented program solves the bundled corpora with every engine, with
+# and without the uniqueness check, verifies the solutions, packs and reads an
+# archive, canonicalizes, and (when built) generates and grades puzzles. Each
+# step writes its output to SUDOKU_WORK_DIR so a failed step can be inspected.
+
+foreach(variable SUDOKU_PROGRAM SUDOKU_DATA_DIR SUDOKU_WORK_DIR SUDOKU_PROFILE_DIR)
+    if(NOT ${variable})
+        message(FATAL_ERROR "PgoTraining.cmake needs -D${variable}=...")
+    endif()
+endforeach()
+
+# Runs one step of the workload; extra arguments go to SudokuProject
+function(sudoku_train step)
+    execute_process(COMMAND "${SUDOKU_PROGRAM}" ${ARGN}
+                    OUTPUT_FILE "${SUDOKU_WORK_DIR}/${step}.out"
+                    ERROR_FILE "${SUDOKU_WORK_DIR}/${step}.err"
+                    RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Training step ${step} failed (${result}), see ${SUDOKU_WORK_DIR}/${step}.err")
+    endif()
+endfunction()
+
+# Counts from an earlier build or run would skew the profile
+file(REMOVE_RECURSE "${SUDOKU_PROFILE_DIR}" "${SUDOKU_WORK_DIR}")
+file(MAKE_DIRECTORY "${SUDOKU_PROFILE_DIR}" "${SUDOKU_WORK_DIR}")
+
+foreach(corpus easy hard 17clue)
+    set(puzzles "${SUDOKU_DATA_DIR}/${corpus}.txt")
+    message(STATUS "Training on ${corpus}.txt")
+
+    sudoku_train(${corpus}-bitmask --solve-batch "${puzzles}" --threads 1)
+    sudoku_train(${corpus}-threads --solve-batch "${puzzles}" --threads 2)
+    sudoku_train(${corpus}-unique --solve-batch "${puzzles}" --threads 1 --unique)
+    sudoku_train(${corpus}-lockstep --solve-batch "${puzzles}" --threads 1 --engine lockstep)
+    sudoku_train(${corpus}-lockstep-unique --solve-batch "${puzzles}" --threads 1 --engine lockstep --unique)
+    sudoku_train(${corpus}-dlx --solve-batch "${puzzles}" --threads 1 --engine dlx)
+    sudoku_train(${corpus}-verify --verify-batch "${SUDOKU_WORK_DIR}/${corpus}-bitmask.out")
+    sudoku_train(${corpus}-canonical --canonical "${puzzles}")
+    sudoku_train(${corpus}-pack --pack "${puzzles}" "${SUDOKU_WORK_DIR}/${corpus}.arc")
+    sudoku_train(${corpus}-unpack --unpack "${SUDOKU_WORK_DIR}/${corpus}.arc")
+
+    if(SUDOKU_ADVANCED)
+        sudoku_train(${corpus}-grade --grade "${puzzles}")
+    endif()
+endforeach()
+
+if(SUDOKU_GENERATOR)
+    message(STATUS "Training the generator")
+    sudoku_train(generate --generate 1000 --seed 1 --threads 1)
+    sudoku_train(generate-threads --generate 200 --seed 2 --threads 2)
+
+    if(SUDOKU_ADVANCED)
+        sudoku_train(generate-grade --grade "${SUDOKU_WORK_DIR}/generate.out")
+    endif()
+endif()
+
+# Clang leaves one raw profile per process; -fprofile-use reads the merge
+if(LLVM_PROFDATA)
+    file(GLOB raw_profiles "${SUDOKU_PROFILE_DIR}/*.profraw")
+    execute_process(COMMAND "${LLVM_PROFDATA}" merge -output=${SUDOKU_PROFILE_DIR}/default.profdata ${raw_profiles}
+                    RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "llvm-profdata merge failed (${result})")
+    endif()
+endif()
+
+message(STATUS "Profiles written to ${SUDOKU_PROFILE_DIR}")
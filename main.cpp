@@ -2,7 +2,8 @@
  *  MODULE NAME  : Main
  *  FILE         : main.cpp
  *  DESCRIPTION  : Entry point for the Sudoku game application. It initializes
- *                 the game and starts the main loop.
+ *                 the game and starts the main loop, or runs one of the
+ *                 non-interactive command line modes.
  *  AUTHOR       : Hassan Darwish
  *  DATE CREATED : April 2025
  ******************************************************************************/
@@ -11,17 +12,563 @@
  *  INCLUDES
  *============================================================================*/
 #include "SudokuGame.hpp"
+#include "SudokuArchive.hpp"
+#include "SudokuBatch.hpp"
+#include "SudokuCanonical.hpp"
+#include "SudokuReplay.hpp"
+#include "SudokuSimd.hpp"
+#ifdef SUDOKU_BUILD_GENERATOR
+#include "SudokuGenerator.hpp"
+#endif
+#ifdef SUDOKU_BUILD_ADVANCED
+#include "SudokuAdvancedChecks.hpp"
+#endif
+#ifdef SUDOKU_BUILD_SERVER
+#include "SudokuServer.hpp"
+#include <csignal>
+#endif
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <vector>
+
+/*==============================================================================
+ *  HELPER FUNCTIONS
+ *============================================================================*/
+
+/* Prints command line usage */
+static void printUsage(const char* program)
+{
+    std::cerr
+    << "Usage: " << program << "                       Start the interactive game\n"
+    << "       " << program << " --cache-file <path>     Start the game with solutions cached in the file\n"
+    << "       " << program << " --record <path>         Start the game and append its choices and moves to a recording\n"
+    << "       " << program << " --replay <file|->       Play recorded sessions and report handler latency\n"
+    << "           [--threads N]   Games played at once (default: all hardware threads)\n"
+    << "           [--paced]       Keep the recorded time between events\n"
+    << "           [--repeat K]    Play every session K times (default 1)\n"
+    << "       " << program << " --solve-batch <file|->  Solve one 81-char puzzle per line\n"
+    << "           [--threads N]   Worker threads (default: all hardware threads)\n"
+    << "           [--scaling]     Report puzzles/sec for 1..N threads instead of solving to stdout\n"
+    << "           [--unique]      Reject puzzles with more than one solution (\"multiple\")\n"
+    << "           [--engine E]    Solver backend: bitmask (default), dlx or lockstep (16 puzzles per core at once)\n"
+    << "           [--box B]       Box size 2-5 for 4x4 up to 25x25 boards (default 3, bitmask only)\n"
+    << "           [--stats F]     Write solver statistics as JSON lines to F (\"-\" for stderr, bitmask only)\n"
+    << "       " << program << " --verify-batch <file|-> Check one finished 81-char grid per line (valid/invalid)\n"
+    << "       " << program << " --pack <file|-> <archive> Store 81-char puzzles in the binary archive format\n"
+    << "       " << program << " --unpack <archive>      Write every archived puzzle as an 81-char line\n"
+    << "       " << program << " --get <archive> <id>    Write the puzzle with the given ID (from 0)\n"
+    << "       " << program << " --canonical <file|->    Write the canonical form and hash of each puzzle\n"
+#ifdef SUDOKU_BUILD_GENERATOR
+    << "       " << program << " --generate <count>      Write uniquely solvable puzzles, one per line\n"
+    << "           [--seed S]      Seed for reproducible output (default 0)\n"
+    << "           [--threads N]   Worker threads (default: all hardware threads)\n"
+    << "           [--min-clues K] Stop removing clues at K clues\n"
+#endif
+#ifdef SUDOKU_BUILD_ADVANCED
+    << "       " << program << " --grade <file|->        Grade each puzzle by the hardest human technique it needs\n"
+#endif
+#ifdef SUDOKU_BUILD_SERVER
+    << "       " << program << " --serve <port|path>     Serve solve/validate/hint JSON and game sessions over HTTP on 127.0.0.1:port or a Unix socket\n"
+    << "           [--threads N]   Worker threads for batched solves (default: all hardware threads)\n"
+    << "           [--max-sessions N] Game sessions open at once (default 1048576)\n"
+#endif
+    ;
+}
+
+/* Runs the batch solver and prints a summary to stderr */
+static int runBatchMode(const char* path, unsigned int threads, bool scaling, bool requireUnique,
+                        SudokuEngineKind engine, int box, const char* statsPath)
+{
+    if (scaling)
+    {
+        if (std::strcmp(path, "-") == 0)
+        {
+            std::cerr << "--scaling needs a file, stdin cannot be re-read." << std::endl;
+            return 2;
+        }
+        reportBatchScaling(path, threads, stderr, engine, box);
+        return 0;
+    }
+
+    FILE* statsFile = nullptr;
+    if (statsPath != nullptr)
+    {
+        statsFile = (std::strcmp(statsPath, "-") == 0) ? stderr : std::fopen(statsPath, "wb");
+        if (statsFile == nullptr)
+        {
+            std::cerr << "Cannot create " << statsPath << "." << std::endl;
+            return 1;
+        }
+    }
+
+    SudokuPuzzleReader reader(path);
+    SudokuSolutionWriter writer(stdout);
+    SudokuBatchStats stats;
+    {
+        std::unique_ptr<SudokuSolutionWriter> statsWriter;
+        if (statsFile != nullptr)
+        {
+            statsWriter.reset(new SudokuSolutionWriter(statsFile));
+        }
+        stats = (threads == 1) ? runSolveBatch(reader, writer, requireUnique, engine, box, statsWriter.get())
+                               : runParallelSolveBatch(reader, writer, threads, requireUnique,
+                                                       engine, box, statsWriter.get());
+    }
+    if (statsFile != nullptr && statsFile != stderr)
+    {
+        std::fclose(statsFile);
+    }
+
+    std::fprintf(stderr, "%llu puzzles: %llu solved, %llu unsolvable, %llu multiple, %llu invalid in %.3f s (%.0f puzzles/s)\n",
+                 static_cast<unsigned long long>(stats.puzzles),
+                 static_cast<unsigned long long>(stats.solved),
+                 static_cast<unsigned long long>(stats.unsolvable),
+                 static_cast<unsigned long long>(stats.multiple),
+                 static_cast<unsigned long long>(stats.invalid),
+                 stats.seconds,
+                 stats.seconds > 0 ? stats.puzzles / stats.seconds : 0.0);
+    return 0;
+}
+
+/* Runs the grid verifier and prints a summary to stderr */
+static int runVerifyMode(const char* path)
+{
+    SudokuPuzzleReader reader(path);
+    SudokuSolutionWriter writer(stdout);
+    SudokuBatchStats stats = runVerifyBatch(reader, writer);
+
+    std::fprintf(stderr, "%llu grids: %llu valid, %llu invalid in %.3f s (%.0f grids/s, %s)\n",
+                 static_cast<unsigned long long>(stats.puzzles),
+                 static_cast<unsigned long long>(stats.valid),
+                 static_cast<unsigned long long>(stats.invalid),
+                 stats.seconds,
+                 stats.seconds > 0 ? stats.puzzles / stats.seconds : 0.0,
+                 sudokuSimdLevelName(sudokuSimdLevel()));
+    return 0;
+}
+
+/* Converts a text corpus to an archive and prints a summary to stderr */
+static int runPackMode(const char* textPath, const char* archivePath)
+{
+    SudokuPuzzleReader reader(textPath);
+    SudokuArchiveWriter archive(archivePath);
+    uint64_t skipped = 0;
+    uint64_t packed = packPuzzleText(reader, archive, skipped);
+
+    std::fprintf(stderr, "%llu puzzles packed, %llu lines skipped\n",
+                 static_cast<unsigned long long>(packed),
+                 static_cast<unsigned long long>(skipped));
+    return 0;
+}
+
+/* Writes one archived puzzle, or all of them when 'id' is null */
+static int runUnpackMode(const char* archivePath, const char* id)
+{
+    SudokuArchiveReader archive(archivePath);
+    SudokuSolutionWriter writer(stdout);
+
+    if (id == nullptr)
+    {
+        unpackPuzzleArchive(archive, writer);
+        return 0;
+    }
+
+    uint8_t grid[81];
+    if (!archive.get(std::strtoull(id, nullptr, 10), SudokuGridView(grid)))
+    {
+        std::cerr << "No puzzle " << id << " (archive holds " << archive.size() << ")." << std::endl;
+        return 1;
+    }
+    writer.writeGrid(SudokuGridView(grid));
+    writer.flush();
+    return 0;
+}
+
+/* Canonicalizes every puzzle and prints the number of equivalence classes */
+static int runCanonicalMode(const char* path)
+{
+    SudokuPuzzleReader reader(path);
+    SudokuSolutionWriter writer(stdout);
+    uint64_t classes = 0;
+    uint64_t puzzles = runCanonicalBatch(reader, writer, classes);
+
+    std::fprintf(stderr, "%llu puzzles in %llu equivalence classes\n",
+                 static_cast<unsigned long long>(puzzles),
+                 static_cast<unsigned long long>(classes));
+    return 0;
+}
+
+/* Replays a recording and prints the latency of each game operation */
+static int runReplayMode(const char* path, unsigned int threads, bool paced, unsigned int repeat)
+{
+    std::vector<SudokuRecordedSession> sessions = readSudokuRecording(path);
+    SudokuReplayReport report = replaySudokuSessions(sessions, threads, paced, repeat);
+    const struct { const char* name; const SudokuLatencyHistogram* histogram; } operations[] = {
+        { "handleMove",  &report.moves },
+        { "handleSolve", &report.solves },
+        { "isGameOver",  &report.gameOvers },
+    };
+    char text[256];
+
+    std::fprintf(stderr, "%llu sessions, %llu events in %.3f s (%.0f events/s)\n",
+                 static_cast<unsigned long long>(report.sessions),
+                 static_cast<unsigned long long>(report.events), report.seconds,
+                 report.seconds > 0 ? report.events / report.seconds : 0.0);
+    for (const auto& operation : operations)
+    {
+        if (formatSudokuLatency(*operation.histogram, text, sizeof(text)) != 0)
+        {
+            std::fprintf(stderr, "%-11s %s\n", operation.name, text);
+        }
+    }
+    return 0;
+}
+
+#ifdef SUDOKU_BUILD_GENERATOR
+/* Runs the generator and prints a summary to stderr */
+static int runGenerateMode(uint64_t count, uint64_t seed, unsigned int threads, int minClues)
+{
+    SudokuSolutionWriter writer(stdout);
+    double seconds = runGenerateBatch(count, seed, threads, minClues, writer);
+
+    std::fprintf(stderr, "%llu puzzles generated in %.3f s (%.0f puzzles/s)\n",
+                 static_cast<unsigned long long>(count), seconds,
+                 seconds > 0 ? count / seconds : 0.0);
+    return 0;
+}
+#endif
+
+#ifdef SUDOKU_BUILD_ADVANCED
+/* Grades every puzzle: "<rating> <label> <hardest technique>" per line */
+static int runGradeMode(const char* path)
+{
+    SudokuPuzzleReader reader(path);
+    SudokuSolutionWriter writer(stdout);
+    SudokuAdvancedChecks checks;
+    uint8_t grid[81];
+    const char* line;
+    size_t length;
+    char text[64];
+    unsigned long long puzzles = 0;
+    unsigned long long beyondLogic = 0;
+
+    while (reader.nextLine(line, length))
+    {
+        if (length == 0)
+        {
+            continue;
+        }
+        puzzles++;
+
+        SudokuGrade grade = { false, 0.0, SudokuTechnique::HiddenSingle, 0, "Invalid" };
+        if (parsePuzzleLine(line, length, SudokuGridView(grid)))
+        {
+            grade = checks.grade(SudokuConstGridView(grid));
+        }
+
+        int written;
+        if (grade.solved)
+        {
+            written = std::snprintf(text, sizeof(text), "%.1f %s %s", grade.rating, grade.label,
+                                    sudokuTechniqueName(grade.hardest));
+        }
+        else
+        {
+            written = std::snprintf(text, sizeof(text), "%s", grade.label);
+            beyondLogic++;
+        }
+        writer.writeLine(text, static_cast<size_t>(written));
+    }
+    writer.flush();
+
+    std::fprintf(stderr, "%llu puzzles graded, %llu not solved by logic\n", puzzles, beyondLogic);
+    return 0;
+}
+#endif
+
+#ifdef SUDOKU_BUILD_SERVER
+/* Server stopped by SIGINT/SIGTERM */
+static SudokuServer* activeServer = nullptr;
+
+/* Signal handler: wakes the event loop so it can shut down */
+static void stopServer(int)
+{
+    if (activeServer != nullptr)
+    {
+        activeServer->stop();
+    }
+}
+
+/* Serves until interrupted, then prints the request, latency and session
+ * summary. 0 sessions means the server default. */
+static int runServeMode(const char* address, unsigned int threads, size_t maxSessions)
+{
+    SudokuServer server(address, threads, (maxSessions != 0) ? maxSessions : SudokuServer::DEFAULT_MAX_SESSIONS);
+
+    activeServer = &server;
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+    std::signal(SIGPIPE, SIG_IGN);
+    std::fprintf(stderr, "Serving on %s (Ctrl-C to stop)\n", address);
+
+    server.run();
+    activeServer = nullptr;
+
+    const SudokuServerStats& stats = server.stats();
+    std::fprintf(stderr, "%llu requests on %llu connections in %llu batches (largest %llu): "
+                 "p50 %.1f us, p99 %.1f us, max %.1f us\n",
+                 static_cast<unsigned long long>(stats.requests),
+                 static_cast<unsigned long long>(stats.connections),
+                 static_cast<unsigned long long>(stats.batches),
+                 static_cast<unsigned long long>(stats.largestBatch),
+                 stats.latency.percentile(0.50) / 1e3,
+                 stats.latency.percentile(0.99) / 1e3,
+                 stats.latency.max() / 1e3);
+    std::fprintf(stderr, "%zu game sessions open (%zu KB reserved)\n",
+                 server.sessionManager().size(), server.sessionManager().bytesReserved() / 1024);
+    return 0;
+}
+#endif
 
 /*==============================================================================
  *  MAIN FUNCTION
  *============================================================================*/
 
-/* Entry point: creates a SudokuGame instance and runs the game loop */
-int main(void)
+/* Entry point: dispatches command line modes, otherwise runs the game loop */
+int main(int argc, char* argv[])
 {
-    SudokuGame game;
+    const char* cachePath = nullptr;
+    const char* recordPath = nullptr;
+
+    if (argc > 1)
+    {
+        const char* batchPath = nullptr;
+        const char* generateCount = nullptr;
+        const char* gradePath = nullptr;
+        const char* verifyPath = nullptr;
+        const char* packPath = nullptr;
+        const char* archivePath = nullptr;
+        const char* archiveId = nullptr;
+        const char* statsPath = nullptr;
+        const char* canonicalPath = nullptr;
+        const char* serveAddress = nullptr;
+        const char* replayPath = nullptr;
+        uint64_t seed = 0;
+        int minClues = 0;
+        int box = 3;
+        unsigned int threads = 0;
+        size_t maxSessions = 0;
+        unsigned int repeat = 1;
+        bool paced = false;
+        bool scaling = false;
+        bool requireUnique = false;
+        bool usageError = false;
+        SudokuEngineKind engine = SudokuEngineKind::Bitmask;
+
+        for (int index = 1; index < argc; index++)
+        {
+            if (std::strcmp(argv[index], "--solve-batch") == 0 && index + 1 < argc)
+            {
+                batchPath = argv[++index];
+            }
+            else if (std::strcmp(argv[index], "--verify-batch") == 0 && index + 1 < argc)
+            {
+                verifyPath = argv[++index];
+            }
+            else if (std::strcmp(argv[index], "--pack") == 0 && index + 2 < argc)
+            {
+                packPath = argv[++index];
+                archivePath = argv[++index];
+            }
+            else if (std::strcmp(argv[index], "--unpack") == 0 && index + 1 < argc)
+            {
+                archivePath = argv[++index];
+            }
+            else if (std::strcmp(argv[index], "--get") == 0 && index + 2 < argc)
+            {
+                archivePath = argv[++index];
+                archiveId = argv[++index];
+            }
+            else if (std::strcmp(argv[index], "--canonical") == 0 && index + 1 < argc)
+            {
+                canonicalPath = argv[++index];
+            }
+            else if (std::strcmp(argv[index], "--threads") == 0 && index + 1 < argc)
+            {
+                threads = static_cast<unsigned int>(std::strtoul(argv[++index], nullptr, 10));
+            }
+            else if (std::strcmp(argv[index], "--scaling") == 0)
+            {
+                scaling = true;
+            }
+            else if (std::strcmp(argv[index], "--unique") == 0)
+            {
+                requireUnique = true;
+            }
+            else if (std::strcmp(argv[index], "--engine") == 0 && index + 1 < argc)
+            {
+                if (!parseSudokuEngineKind(argv[++index], engine))
+                {
+                    usageError = true;
+                }
+            }
+            else if (std::strcmp(argv[index], "--box") == 0 && index + 1 < argc)
+            {
+                box = std::atoi(argv[++index]);
+                if (box < 2 || box > 5)
+                {
+                    usageError = true;
+                }
+            }
+            else if (std::strcmp(argv[index], "--stats") == 0 && index + 1 < argc)
+            {
+                statsPath = argv[++index];
+            }
+            else if (std::strcmp(argv[index], "--generate") == 0 && index + 1 < argc)
+            {
+                generateCount = argv[++index];
+            }
+            else if (std::strcmp(argv[index], "--seed") == 0 && index + 1 < argc)
+            {
+                seed = std::strtoull(argv[++index], nullptr, 10);
+            }
+            else if (std::strcmp(argv[index], "--min-clues") == 0 && index + 1 < argc)
+            {
+                minClues = std::atoi(argv[++index]);
+            }
+            else if (std::strcmp(argv[index], "--grade") == 0 && index + 1 < argc)
+            {
+                gradePath = argv[++index];
+            }
+            else if (std::strcmp(argv[index], "--serve") == 0 && index + 1 < argc)
+            {
+                serveAddress = argv[++index];
+            }
+            else if (std::strcmp(argv[index], "--max-sessions") == 0 && index + 1 < argc)
+            {
+                maxSessions = static_cast<size_t>(std::strtoull(argv[++index], nullptr, 10));
+                if (maxSessions == 0)
+                {
+                    usageError = true;
+                }
+            }
+            else if (std::strcmp(argv[index], "--record") == 0 && index + 1 < argc)
+            {
+                recordPath = argv[++index];
+            }
+            else if (std::strcmp(argv[index], "--replay") == 0 && index + 1 < argc)
+            {
+                replayPath = argv[++index];
+            }
+            else if (std::strcmp(argv[index], "--paced") == 0)
+            {
+                paced = true;
+            }
+            else if (std::strcmp(argv[index], "--repeat") == 0 && index + 1 < argc)
+            {
+                repeat = static_cast<unsigned int>(std::strtoul(argv[++index], nullptr, 10));
+                if (repeat == 0)
+                {
+                    usageError = true;
+                }
+            }
+            else if (std::strcmp(argv[index], "--cache-file") == 0 && index + 1 < argc)
+            {
+                cachePath = argv[++index];
+            }
+            else
+            {
+                usageError = true;
+            }
+        }
+
+        if (box != 3 && engine != SudokuEngineKind::Bitmask)
+        {
+            usageError = true;   // Only the bitmask solver is templated on the box size
+        }
+        if (statsPath != nullptr && (engine != SudokuEngineKind::Bitmask || scaling))
+        {
+            usageError = true;   // Only the bitmask solver collects statistics
+        }
+
+        try
+        {
+            if (batchPath != nullptr && !usageError)
+            {
+                return runBatchMode(batchPath, threads, scaling, requireUnique, engine, box, statsPath);
+            }
+            if (verifyPath != nullptr && !usageError)
+            {
+                return runVerifyMode(verifyPath);
+            }
+            if (packPath != nullptr && !usageError)
+            {
+                return runPackMode(packPath, archivePath);
+            }
+            if (archivePath != nullptr && !usageError)
+            {
+                return runUnpackMode(archivePath, archiveId);
+            }
+            if (canonicalPath != nullptr && !usageError)
+            {
+                return runCanonicalMode(canonicalPath);
+            }
+            if (replayPath != nullptr && !usageError)
+            {
+                return runReplayMode(replayPath, threads, paced, repeat);
+            }
+#ifdef SUDOKU_BUILD_GENERATOR
+            if (generateCount != nullptr && !usageError)
+            {
+                return runGenerateMode(std::strtoull(generateCount, nullptr, 10), seed, threads, minClues);
+            }
+#endif
+#ifdef SUDOKU_BUILD_ADVANCED
+            if (gradePath != nullptr && !usageError)
+            {
+                return runGradeMode(gradePath);
+            }
+#endif
+#ifdef SUDOKU_BUILD_SERVER
+            if (serveAddress != nullptr && !usageError)
+            {
+                return runServeMode(serveAddress, threads, maxSessions);
+            }
+#endif
+        }
+        catch (const SudokuBoardException& error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+
+        if ((cachePath == nullptr && recordPath == nullptr) || usageError)
+        {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    SudokuGame game(cachePath);
+    std::unique_ptr<SudokuSessionRecorder> recorder;
 
+    if (recordPath != nullptr)
+    {
+        try
+        {
+            recorder.reset(new SudokuSessionRecorder(recordPath));
+        }
+        catch (const SudokuReplayException& error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+        game.setRecorder(recorder.get());
+    }
     game.run();
 
     std::cout << "\nThanks for playing." << std::endl;